@@ -38,7 +38,7 @@ vpath %$(EXT_C) $(DIR_SRC)
 .SUFFIXES:
 
 # Phony targets
-.PHONY: all clean
+.PHONY: all clean dfa ll lr
 
 # Precious targets
 .PRECIOUS: $(DIR_BUILD_OBJ)%$(EXT_O) $(DIR_BUILD_OBJ)%$(EXT_C)$(EXT_O)
@@ -56,6 +56,24 @@ clean:
 	@rm -rf $(DIR_BUILD_OBJ)*
 	@rm -rf $(DIR_BUILD_BIN)*
 
+# Regenerates the table-driven scanners from their specs
+dfa: tools
+	
+	$(call PRINT,,Generating table-driven scanners)
+	@for _F in $(wildcard $(DIR_PROJECTS)*/*/*.l); do $(DIR_BUILD_BIN)tools-lexgen $$_F || exit 1; done
+
+# Regenerates the table-driven parsers from their grammars
+ll: tools
+	
+	$(call PRINT,,Generating table-driven parsers)
+	@for _F in $(wildcard $(DIR_PROJECTS)*/*/*.g); do $(DIR_BUILD_BIN)tools-llgen $$_F || exit 1; done
+
+# Regenerates the LALR(1) parsers from their grammars
+lr: tools
+	
+	$(call PRINT,,Generating LALR parsers)
+	@for _F in $(wildcard $(DIR_PROJECTS)*/*/*.y); do $(DIR_BUILD_BIN)tools-lrgen $$_F || exit 1; done
+
 # Project
 %: _DIRS = $(foreach _F,$(wildcard $(DIR_PROJECTS)$*/*),$(subst /,_,$(_F)))
 %: $$(_DIRS)
@@ -0,0 +1,1048 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Bench.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Bench.h"
+#include "Scan.h"
+#include "CharClass.h"
+#include "Input.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "Grammar.h"
+#include "LALR.h"
+#include "TokenStream.h"
+#include "DFA.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_SIZE   ( 64 * 1024 * 1024 )
+#define BENCH_ROUNDS 5
+#define BENCH_EDITS  100
+#define BENCH_STACK  ( 64 * 1024 )
+#define BENCH_NESTED 100000
+
+typedef enum
+{
+    BenchLoopCType = 0,
+    BenchLoopTable = 1,
+    BenchLoopScan  = 2
+} BenchLoop;
+
+typedef enum
+{
+    BenchParserHand = 0,
+    BenchParserLL   = 1,
+    BenchParserLR   = 2
+} BenchParser;
+
+static volatile size_t Bench_Sink = 0;
+
+static volatile uintptr_t Bench_Area = 0;
+
+static double Bench_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( double )ts.tv_sec + ( double )ts.tv_nsec / 1e9;
+}
+
+/*
+ * Fills the buffer with runs of the given length, separated by a single
+ * byte that ends the run, and terminates it with a NUL sentinel, padded
+ * like an input for the scanning kernels.
+ */
+static char * Bench_CreateBuffer( size_t run, bool space )
+{
+    void * block;
+    char * buf;
+
+    if( posix_memalign( &block, SCAN_ALIGNMENT, BENCH_SIZE + SCAN_PADDING ) != 0 )
+    {
+        return NULL;
+    }
+
+    buf = block;
+
+    memset( buf + BENCH_SIZE, 0, SCAN_PADDING );
+
+    for( size_t i = 0; i < BENCH_SIZE; i++ )
+    {
+        if( i % ( run + 1 ) == run )
+        {
+            buf[ i ] = ( space ) ? 'x' : ';';
+        }
+        else if( space )
+        {
+            buf[ i ] = ( i % 61 == 60 ) ? '\n' : ' ';
+        }
+        else
+        {
+            buf[ i ] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"[ i % 62 ];
+        }
+    }
+
+    return buf;
+}
+
+/*
+ * Walks the whole buffer, skipping each run with the given loop, and
+ * returns the throughput in MB/s.
+ */
+static double Bench_Run( const char * buf, BenchLoop loop, bool space )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        const char * p;
+        double       start;
+        double       elapsed;
+
+        p     = buf;
+        start = Bench_Now();
+
+        while( *( p ) != 0 )
+        {
+            if( loop == BenchLoopCType && space )
+            {
+                while( isspace( ( unsigned char )*( p ) ) )
+                {
+                    p++;
+                }
+            }
+            else if( loop == BenchLoopCType )
+            {
+                while( isalnum( ( unsigned char )*( p ) ) )
+                {
+                    p++;
+                }
+            }
+            else if( loop == BenchLoopTable && space )
+            {
+                while( CharClass_Is( *( p ), CharClassSpace ) )
+                {
+                    p++;
+                }
+            }
+            else if( loop == BenchLoopTable )
+            {
+                while( CharClass_Is( *( p ), CharClassAlnum ) )
+                {
+                    p++;
+                }
+            }
+            else if( space )
+            {
+                p += Scan_Space( p );
+            }
+            else
+            {
+                p += Scan_Alnum( p );
+            }
+
+            p++;
+        }
+
+        elapsed    = Bench_Now() - start;
+        Bench_Sink = Bench_Sink + ( size_t )( p - buf );
+
+        if( elapsed > 0 && ( double )BENCH_SIZE / elapsed / 1e6 > best )
+        {
+            best = ( double )BENCH_SIZE / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Compares the run-skipping kernels used by Lexer_Next to byte-at-a-time
+ * loops, for alphanumeric and space runs of several lengths.
+ */
+int Bench_Scan( void )
+{
+    static const size_t runs[] = { 4, 16, 64, 256, 4096 };
+    ScanKernel          kernel;
+
+    kernel = Scan_GetKernel();
+
+    printf( "%-8s %-8s", "Runs", "Loop" );
+
+    for( size_t i = 0; i < sizeof( runs ) / sizeof( *( runs ) ); i++ )
+    {
+        printf( " %8zu", runs[ i ] );
+    }
+
+    printf( "    (MB/s)\n" );
+
+    for( int space = 0; space < 2; space++ )
+    {
+        char * bufs[ sizeof( runs ) / sizeof( *( runs ) ) ];
+
+        for( size_t i = 0; i < sizeof( runs ) / sizeof( *( runs ) ); i++ )
+        {
+            if( ( bufs[ i ] = Bench_CreateBuffer( runs[ i ], space != 0 ) ) == NULL )
+            {
+                fprintf( stderr, "Out of memory\n" );
+
+                return EXIT_FAILURE;
+            }
+        }
+
+        for( int k = -2; k <= ScanKernelAVX2; k++ )
+        {
+            BenchLoop loop;
+
+            loop = ( k == -2 ) ? BenchLoopCType : ( ( k == -1 ) ? BenchLoopTable : BenchLoopScan );
+
+            if( loop == BenchLoopScan && Scan_SetKernel( ( ScanKernel )k ) == false )
+            {
+                continue;
+            }
+
+            printf( "%-8s %-8s", ( space ) ? "Space" : "Alnum", ( k == -2 ) ? "ctype" : ( ( k == -1 ) ? "Table" : Scan_GetKernelName( ( ScanKernel )k ) ) );
+
+            for( size_t i = 0; i < sizeof( runs ) / sizeof( *( runs ) ); i++ )
+            {
+                printf( " %8.0f", Bench_Run( bufs[ i ], loop, space != 0 ) );
+                fflush( stdout );
+            }
+
+            printf( "\n" );
+        }
+
+        for( size_t i = 0; i < sizeof( runs ) / sizeof( *( runs ) ); i++ )
+        {
+            free( bufs[ i ] );
+        }
+    }
+
+    Scan_SetKernel( kernel );
+
+    return EXIT_SUCCESS;
+}
+
+static void Bench_WriteFactor( FILE * fh, int depth );
+
+static void Bench_WriteExpression( FILE * fh, int depth )
+{
+    int terms;
+
+    terms = 1 + rand() % 3;
+
+    for( int i = 0; i < terms; i++ )
+    {
+        int factors;
+
+        factors = 1 + rand() % 3;
+
+        for( int j = 0; j < factors; j++ )
+        {
+            Bench_WriteFactor( fh, depth );
+            fputs( ( j + 1 < factors ) ? " * " : "", fh );
+        }
+
+        fputs( ( i + 1 < terms ) ? " + " : "", fh );
+    }
+}
+
+/*
+ * Parentheses are nested at most twice, so expressions never need more
+ * temporary names than the parser has.
+ */
+static void Bench_WriteFactor( FILE * fh, int depth )
+{
+    int length;
+
+    if( depth < 2 && rand() % 4 == 0 )
+    {
+        fputs( "( ", fh );
+        Bench_WriteExpression( fh, depth + 1 );
+        fputs( " )", fh );
+
+        return;
+    }
+
+    length = 1 + rand() % 12;
+
+    for( int i = 0; i < length; i++ )
+    {
+        fputc( "abcdefghijklmnopqrstuvwxyz0123456789"[ rand() % ( ( i == 0 ) ? 26 : 36 ) ], fh );
+    }
+}
+
+/*
+ * Writes BENCH_SIZE bytes of valid statements to a temporary file, and
+ * maps it.
+ */
+static InputRef Bench_CreateInput( void )
+{
+    char     path[] = "/tmp/holub-bench-XXXXXX";
+    int      fd;
+    FILE *   fh;
+    InputRef input;
+
+    if( ( fd = mkstemp( path ) ) < 0 || ( fh = fdopen( fd, "w" ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    srand( 42 );
+
+    while( ftell( fh ) < BENCH_SIZE )
+    {
+        Bench_WriteExpression( fh, 0 );
+        fputs( ";\n", fh );
+    }
+
+    fclose( fh );
+
+    input = Input_CreateWithFile( path );
+
+    unlink( path );
+
+    return input;
+}
+
+/*
+ * Runs one of the parsers. It is never inlined, so that its stack usage
+ * starts where Bench_PaintStack painted.
+ */
+__attribute__( ( noinline ) )
+static void Bench_RunParser( LexerRef lexer, BenchParser parser )
+{
+    if( parser == BenchParserHand )
+    {
+        Parser_Statements( lexer );
+    }
+    else if( parser == BenchParserLL )
+    {
+        Grammar_Parse( lexer );
+    }
+    else if( parser == BenchParserLR )
+    {
+        LALR_Parse( lexer );
+    }
+}
+
+/*
+ * Parses the whole input, without debug output, with the given parser,
+ * and returns the throughput in MB/s.
+ */
+static double Bench_Parse( InputRef input, size_t size, bool pipeline, BenchParser parser )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        LexerRef lexer;
+        double   start;
+        double   elapsed;
+
+        if( ( lexer = Lexer_Create( input ) ) == NULL )
+        {
+            return 0;
+        }
+
+        Lexer_SetDebug( lexer, false );
+
+        start = Bench_Now();
+
+        if( pipeline && Lexer_StartPipeline( lexer ) == false )
+        {
+            Lexer_Release( lexer );
+
+            return 0;
+        }
+
+        Bench_RunParser( lexer, parser );
+        Lexer_Release( lexer );
+
+        elapsed = Bench_Now() - start;
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Compares lexing and parsing on one thread to the pipeline, where the
+ * lexer runs on a thread of its own.
+ */
+int Bench_Pipeline( void )
+{
+    InputRef input;
+    double   single;
+    double   pipeline;
+
+    if( ( input = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    printf( "%-12s %8s    (MB/s)\n", "Lexer", "Parse" );
+
+    single = Bench_Parse( input, BENCH_SIZE, false, BenchParserHand );
+
+    printf( "%-12s %8.0f\n", "One thread", single );
+    fflush( stdout );
+
+    pipeline = Bench_Parse( input, BENCH_SIZE, true, BenchParserHand );
+
+    printf( "%-12s %8.0f    x%.2f (%ld CPUs)\n", "Pipeline", pipeline, ( single > 0 ) ? pipeline / single : 0, sysconf( _SC_NPROCESSORS_ONLN ) );
+
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Lexes the whole input into a token stream, on the given number of
+ * threads, and returns the throughput in MB/s.
+ */
+static double Bench_Lex( InputRef input, size_t size, size_t threads )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        LexerRef lexer;
+        double   start;
+        double   elapsed;
+        bool     ok;
+
+        if( ( lexer = Lexer_Create( input ) ) == NULL )
+        {
+            return 0;
+        }
+
+        Lexer_SetDebug( lexer, false );
+
+        start   = Bench_Now();
+        ok      = ( threads == 1 ) ? Lexer_Tokenize( lexer ) : Lexer_TokenizeParallel( lexer, threads );
+        elapsed = Bench_Now() - start;
+
+        Lexer_Release( lexer );
+
+        if( ok == false )
+        {
+            return 0;
+        }
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Compares Lexer_Tokenize to Lexer_TokenizeParallel, with up to twice as
+ * many threads as there are CPUs.
+ */
+int Bench_Tokenize( void )
+{
+    InputRef input;
+    size_t   cpus;
+    double   single;
+
+    if( ( input = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    cpus = ( size_t )sysconf( _SC_NPROCESSORS_ONLN );
+
+    printf( "%-8s %8s    (MB/s, %zu CPUs)\n", "Threads", "Lex", cpus );
+
+    single = Bench_Lex( input, BENCH_SIZE, 1 );
+
+    printf( "%-8u %8.0f\n", 1, single );
+    fflush( stdout );
+
+    for( size_t threads = 2; threads <= cpus * 2; threads *= 2 )
+    {
+        double parallel;
+
+        parallel = Bench_Lex( input, BENCH_SIZE, threads );
+
+        printf( "%-8zu %8.0f    x%.2f\n", threads, parallel, ( single > 0 ) ? parallel / single : 0 );
+        fflush( stdout );
+    }
+
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Average time, in seconds, of inserting a character and removing it, at
+ * random offsets in the last given number of bytes of the input.
+ */
+static double Bench_EditAt( LexerRef lexer, size_t range )
+{
+    size_t size;
+    double start;
+
+    size  = Input_GetLength( Lexer_GetInput( lexer ) );
+    start = Bench_Now();
+
+    for( int i = 0; i < BENCH_EDITS; i++ )
+    {
+        size_t offset;
+
+        offset = size - range + ( size_t )rand() % range;
+
+        if( Lexer_Edit( lexer, offset, 0, "x", 1 ) == false || Lexer_Edit( lexer, offset, 1, "", 0 ) == false )
+        {
+            return 0;
+        }
+    }
+
+    return ( Bench_Now() - start ) / ( BENCH_EDITS * 2 );
+}
+
+/*
+ * Compares lexing the whole input to updating its token stream after a
+ * one-character edit. Edits near the end only show the cost of lexing the
+ * tokens around them, while edits anywhere also move the rest of the
+ * input and shift the offsets of the tokens after them.
+ */
+int Bench_Edit( void )
+{
+    InputRef file;
+    InputRef input;
+    LexerRef lexer;
+    double   start;
+    double   full;
+    double   end;
+    double   anywhere;
+
+    if( ( file = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    input = Input_CreateWithBytes( Input_GetStart( file ), Input_GetLength( file ) );
+    lexer = Lexer_Create( input );
+
+    Input_Release( file );
+    Input_Release( input );
+
+    if( lexer == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    Lexer_SetDebug( lexer, false );
+    srand( 42 );
+
+    start = Bench_Now();
+
+    if( Lexer_Tokenize( lexer ) == false )
+    {
+        Lexer_Release( lexer );
+
+        return EXIT_FAILURE;
+    }
+
+    full     = Bench_Now() - start;
+    end      = Bench_EditAt( lexer, 4096 );
+    anywhere = Bench_EditAt( lexer, BENCH_SIZE );
+
+    Lexer_Release( lexer );
+
+    printf( "%-16s %10s\n", "Lexing", "Time (ms)" );
+    printf( "%-16s %10.3f\n", "Whole input", full * 1e3 );
+    printf( "%-16s %10.3f    x%.0f\n", "Edit near end", end * 1e3, ( end > 0 ) ? full / end : 0 );
+    printf( "%-16s %10.3f    x%.0f\n", "Edit anywhere", anywhere * 1e3, ( anywhere > 0 ) ? full / anywhere : 0 );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Scans the whole input into a token stream with the table-driven scanner
+ * generated from DFA.l, and returns the throughput in MB/s. The stream of
+ * the last round is kept for comparison.
+ */
+static double Bench_Match( InputRef input, size_t size, TokenStreamRef * tokens )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        TokenStreamRef stream;
+        const char *   text;
+        const char *   p;
+        double         start;
+        double         elapsed;
+        bool           ok;
+
+        if( ( stream = TokenStream_Create() ) == NULL )
+        {
+            return 0;
+        }
+
+        text  = Input_GetStart( input );
+        p     = text;
+        ok    = true;
+        start = Bench_Now();
+
+        while( ok && *( p ) != 0 )
+        {
+            size_t length;
+            int    kind;
+
+            kind = DFA_Match( p, &length );
+
+            if( kind >= 0 )
+            {
+                ok = TokenStream_Append( stream, ( uint8_t )kind, ( uint64_t )( p - text ), ( uint32_t )length );
+            }
+
+            p += length;
+        }
+
+        ok      = ok && TokenStream_Append( stream, ( uint8_t )TokenEnd, ( uint64_t )( p - text ), 0 );
+        elapsed = Bench_Now() - start;
+
+        TokenStream_Release( *( tokens ) );
+
+        *( tokens ) = stream;
+
+        if( ok == false )
+        {
+            return 0;
+        }
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Checks that the lexer produces the same tokens as the stream.
+ */
+static bool Bench_Compare( InputRef input, TokenStreamRef tokens )
+{
+    LexerRef         lexer;
+    const uint8_t *  kinds;
+    const uint64_t * offsets;
+    const uint32_t * lengths;
+    bool             ok;
+
+    if( ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        return false;
+    }
+
+    Lexer_SetDebug( lexer, false );
+
+    kinds   = TokenStream_GetKinds( tokens );
+    offsets = TokenStream_GetOffsets( tokens );
+    lengths = TokenStream_GetLengths( tokens );
+    ok      = Lexer_Tokenize( lexer );
+
+    for( size_t i = 0; ok && i < TokenStream_GetCount( tokens ); i++ )
+    {
+        Token token;
+
+        token = Lexer_Next( lexer );
+        ok    = kinds[ i ] == token && offsets[ i ] == ( uint64_t )( Lexer_GetText( lexer ) - Input_GetStart( input ) ) && lengths[ i ] == Lexer_GetLength( lexer );
+    }
+
+    Lexer_Release( lexer );
+
+    return ok;
+}
+
+/*
+ * Compares Lexer_Tokenize to the table-driven scanner generated from
+ * DFA.l, both filling a token stream from the same input on one thread.
+ * The lexer also decodes numbers, which the scanner leaves to its caller.
+ */
+int Bench_DFA( void )
+{
+    InputRef       input;
+    TokenStreamRef tokens;
+    double         lexer;
+    double         dfa;
+
+    if( ( input = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    tokens = NULL;
+
+    printf( "%-14s %8s    (MB/s)\n", "Scanner", "Lex" );
+
+    lexer = Bench_Lex( input, BENCH_SIZE, 1 );
+
+    printf( "%-14s %8.0f\n", "Hand-written", lexer );
+    fflush( stdout );
+
+    dfa = Bench_Match( input, BENCH_SIZE, &tokens );
+
+    printf( "%-14s %8.0f    x%.2f\n", "Table-driven", dfa, ( lexer > 0 ) ? dfa / lexer : 0 );
+
+    if( tokens == NULL || Bench_Compare( input, tokens ) == false )
+    {
+        fprintf( stderr, "The scanners produce different tokens\n" );
+
+        TokenStream_Release( tokens );
+        Input_Release( input );
+
+        return EXIT_FAILURE;
+    }
+
+    TokenStream_Release( tokens );
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Compares the hand-written recursive descent parser to the table-driven
+ * one generated from Grammar.g, both lexing on the same thread.
+ */
+int Bench_LL( void )
+{
+    InputRef input;
+    double   parser;
+    double   table;
+
+    if( ( input = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    printf( "%-14s %8s    (MB/s)\n", "Parser", "Parse" );
+
+    parser = Bench_Parse( input, BENCH_SIZE, false, BenchParserHand );
+
+    printf( "%-14s %8.0f\n", "Hand-written", parser );
+    fflush( stdout );
+
+    table = Bench_Parse( input, BENCH_SIZE, false, BenchParserLL );
+
+    printf( "%-14s %8.0f    x%.2f\n", "Table-driven", table, ( parser > 0 ) ? table / parser : 0 );
+
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Fills the stack below the caller with a pattern, which calls made after
+ * it overwrite as deep as they go, and remembers where it is.
+ */
+__attribute__( ( noinline ) )
+static void Bench_PaintStack( void )
+{
+    volatile unsigned char area[ BENCH_STACK ];
+
+    for( size_t i = 0; i < BENCH_STACK; i++ )
+    {
+        area[ i ] = 0xA5;
+    }
+
+    Bench_Area = ( uintptr_t )area;
+}
+
+/*
+ * Returns how deep into the painted stack the calls made since
+ * Bench_PaintStack went, as the stack grows down.
+ */
+static size_t Bench_MeasureStack( void )
+{
+    const volatile unsigned char * area;
+    size_t                         i;
+
+    area = ( const volatile unsigned char * )Bench_Area;
+    i    = 0;
+
+    while( i < BENCH_STACK && area[ i ] == 0xA5 )
+    {
+        i++;
+    }
+
+    return BENCH_STACK - i;
+}
+
+/*
+ * Returns the size of the largest stack a parser moved to the heap since
+ * the last call, in bytes.
+ */
+static size_t Bench_HeapPeak( BenchParser parser )
+{
+    if( parser == BenchParserLL )
+    {
+        return Grammar_GetHeapPeak();
+    }
+    else if( parser == BenchParserLR )
+    {
+        return LALR_GetHeapPeak();
+    }
+
+    return Parser_GetHeapPeak();
+}
+
+/*
+ * Parses the input once, and returns the peak stack usage of the parser
+ * in bytes: on the C stack, and in heap, where the parsers move their
+ * stack once it is nested too deep.
+ */
+static size_t Bench_Stack( InputRef input, BenchParser parser, size_t * heap )
+{
+    LexerRef lexer;
+    size_t   stack;
+
+    *( heap ) = 0;
+
+    if( ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        return 0;
+    }
+
+    Lexer_SetDebug( lexer, false );
+    Bench_HeapPeak( parser );
+    Bench_PaintStack();
+    Bench_RunParser( lexer, parser );
+
+    stack     = Bench_MeasureStack();
+    *( heap ) = Bench_HeapPeak( parser );
+
+    Lexer_Release( lexer );
+
+    return stack;
+}
+
+/*
+ * Compares the LALR(1) parser generated from LALR.y to the hand-written
+ * and LL(1) parsers: throughput in tokens, and peak stack usage, on the C
+ * stack and in heap, on the benchmark input and on one statement nested
+ * BENCH_NESTED times.
+ */
+int Bench_LR( void )
+{
+    static const char * names[] = { "Hand-written", "LL(1)", "LALR(1)" };
+
+    InputRef input;
+    InputRef nested;
+    LexerRef lexer;
+    char *   buf;
+    size_t   tokens;
+    double   base;
+
+    if( ( input = Bench_CreateInput() ) == NULL || ( buf = malloc( BENCH_NESTED * 2 + 3 ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    memset( buf, '(', BENCH_NESTED );
+    memset( buf + BENCH_NESTED + 1, ')', BENCH_NESTED );
+
+    buf[ BENCH_NESTED ]         = 'a';
+    buf[ BENCH_NESTED * 2 + 1 ] = ';';
+    buf[ BENCH_NESTED * 2 + 2 ] = 0;
+    nested                      = Input_CreateWithBytes( buf, BENCH_NESTED * 2 + 2 );
+    tokens                      = 0;
+    base                        = 0;
+
+    free( buf );
+
+    if( nested == NULL || ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        Input_Release( input );
+        Input_Release( nested );
+
+        return EXIT_FAILURE;
+    }
+
+    Lexer_SetDebug( lexer, false );
+
+    while( Lexer_GetLookahead( lexer ) != TokenEnd )
+    {
+        Lexer_Advance( lexer );
+
+        tokens++;
+    }
+
+    Lexer_Release( lexer );
+
+    printf( "%-14s %8s %8s %10s %10s %10s %10s\n", "Parser", "MB/s", "Mtok/s", "Stack", "Heap", "Nested", "Heap" );
+
+    for( int i = BenchParserHand; i <= BenchParserLR; i++ )
+    {
+        double speed;
+        size_t stack;
+        size_t heap;
+        size_t nestedStack;
+        size_t nestedHeap;
+
+        speed       = Bench_Parse( input, BENCH_SIZE, false, ( BenchParser )i );
+        base        = ( i == BenchParserHand ) ? speed : base;
+        stack       = Bench_Stack( input, ( BenchParser )i, &heap );
+        nestedStack = Bench_Stack( nested, ( BenchParser )i, &nestedHeap );
+
+        printf( "%-14s %8.0f %8.1f %10zu %10zu %10zu %10zu    x%.2f\n", names[ i ], speed, speed * ( double )tokens / BENCH_SIZE, stack, heap, nestedStack, nestedHeap, ( base > 0 ) ? speed / base : 0 );
+        fflush( stdout );
+    }
+
+    Input_Release( nested );
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Compiles the whole input with Parser_StatementsParallel, without debug
+ * output, on the given number of threads, and returns the throughput in
+ * MB/s.
+ */
+static double Bench_Compile( InputRef input, size_t size, size_t threads )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        LexerRef lexer;
+        double   start;
+        double   elapsed;
+        bool     ok;
+
+        if( ( lexer = Lexer_Create( input ) ) == NULL )
+        {
+            return 0;
+        }
+
+        Lexer_SetDebug( lexer, false );
+
+        start   = Bench_Now();
+        ok      = Parser_StatementsParallel( lexer, threads );
+        elapsed = Bench_Now() - start;
+
+        Lexer_Release( lexer );
+
+        if( ok == false )
+        {
+            return 0;
+        }
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Compares compiling the statements on one thread to compiling runs of
+ * them on separate threads, with up to twice as many threads as there are
+ * CPUs.
+ */
+int Bench_Statements( void )
+{
+    InputRef input;
+    size_t   cpus;
+    double   single;
+
+    if( ( input = Bench_CreateInput() ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    cpus = ( size_t )sysconf( _SC_NPROCESSORS_ONLN );
+
+    printf( "%-8s %8s    (MB/s, %zu CPUs)\n", "Threads", "Compile", cpus );
+
+    single = Bench_Compile( input, BENCH_SIZE, 1 );
+
+    printf( "%-8u %8.0f\n", 1, single );
+    fflush( stdout );
+
+    for( size_t threads = 2; threads <= cpus * 2; threads *= 2 )
+    {
+        double parallel;
+
+        parallel = Bench_Compile( input, BENCH_SIZE, threads );
+
+        printf( "%-8zu %8.0f    x%.2f\n", threads, parallel, ( single > 0 ) ? parallel / single : 0 );
+        fflush( stdout );
+    }
+
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      CharClass.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef CHAR_CLASS_H
+#define CHAR_CLASS_H
+
+#include <stdbool.h>
+
+typedef enum
+{
+    CharClassNone  = 0,
+    CharClassSpace = 1 << 0, /* Space, tab, newline, carriage return, vertical tab, form feed */
+    CharClassDigit = 1 << 1, /* 0-9 */
+    CharClassAlpha = 1 << 2, /* A-Z, a-z */
+    CharClassHigh  = 1 << 3, /* 0x80-0xFF, the bytes of multi-byte UTF-8 sequences */
+    CharClassAlnum = CharClassDigit | CharClassAlpha,
+    CharClassWord  = CharClassAlnum | CharClassHigh
+} CharClass;
+
+extern const unsigned char CharClass_Table[ 256 ];
+
+/*
+ * Locale-independent replacements for the ctype functions.
+ * Bytes above 127 are indexed as unsigned, and only belong to
+ * CharClassHigh.
+ */
+static inline unsigned char CharClass_Get( char c )
+{
+    return CharClass_Table[ ( unsigned char )c ];
+}
+
+static inline bool CharClass_Is( char c, CharClass cls )
+{
+    return ( CharClass_Table[ ( unsigned char )c ] & cls ) != 0;
+}
+
+#endif /* CHAR_CLASS_H */
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Compiler.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Compiler.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "Print.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/*
+ * Size of a single read() in Compiler_Read.
+ */
+#define COMPILER_READ_SIZE 4096
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Only the bytes of the statement not complete yet are kept, along with
+ * the location of their first byte, so memory doesn't grow with the length
+ * of the stream. scanned is how far they were searched for a semicolon.
+ */
+struct Compiler
+{
+    uint64_t         rc;
+    CompilerCallback callback;
+    void *           context;
+    bool             debug;
+    bool             finished;
+    char *           buffer;
+    size_t           length;
+    size_t           capacity;
+    size_t           scanned;
+    size_t           offset;
+    size_t           line;
+    size_t           column;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static bool Compiler_Compile( CompilerRef compiler, size_t start, size_t length );
+static void Compiler_Print( CompilerRef compiler, Span statement, const char * messages, size_t size, void * context );
+
+/*
+ * Without a callback, the messages of each statement are printed and
+ * flushed as soon as it is compiled.
+ */
+CompilerRef Compiler_Create( CompilerCallback callback, void * context )
+{
+    CompilerRef compiler;
+
+    if( ( compiler = calloc( 1, sizeof( struct Compiler ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    compiler->rc       = 1;
+    compiler->callback = ( callback == NULL ) ? Compiler_Print : callback;
+    compiler->context  = context;
+    compiler->debug    = true;
+    compiler->line     = 1;
+    compiler->column   = 1;
+
+    return compiler;
+}
+
+CompilerRef Compiler_Retain( CompilerRef compiler )
+{
+    if( compiler == NULL )
+    {
+        return NULL;
+    }
+
+    compiler->rc++;
+
+    return compiler;
+}
+
+void Compiler_Release( CompilerRef compiler )
+{
+    if( compiler == NULL )
+    {
+        return;
+    }
+
+    if( --( compiler->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( compiler->buffer );
+    free( compiler );
+}
+
+void Compiler_SetDebug( CompilerRef compiler, bool value )
+{
+    compiler->debug = value;
+}
+
+/*
+ * Adds bytes to the stream, and compiles every statement they complete
+ * before returning. The parser never consumes a semicolon within an
+ * expression, so each one ends a statement, even within parentheses, and
+ * a statement compiles the same as within the whole stream. Nothing waits
+ * for more input: the work done is bounded by the length of the complete
+ * statements.
+ */
+bool Compiler_Feed( CompilerRef compiler, const char * bytes, size_t length )
+{
+    const char * semicolon;
+    size_t       start;
+    bool         ret;
+
+    if( compiler->finished )
+    {
+        return false;
+    }
+
+    if( length == 0 )
+    {
+        return true;
+    }
+
+    if( compiler->length + length > compiler->capacity )
+    {
+        size_t capacity;
+        char * buffer;
+
+        capacity = ( compiler->capacity == 0 ) ? COMPILER_READ_SIZE : compiler->capacity;
+
+        while( capacity < compiler->length + length )
+        {
+            capacity *= 2;
+        }
+
+        if( ( buffer = realloc( compiler->buffer, capacity ) ) == NULL )
+        {
+            return false;
+        }
+
+        compiler->buffer   = buffer;
+        compiler->capacity = capacity;
+    }
+
+    memcpy( compiler->buffer + compiler->length, bytes, length );
+
+    compiler->length += length;
+    start             = 0;
+    ret               = true;
+
+    while( ret && ( semicolon = memchr( compiler->buffer + compiler->scanned, ';', compiler->length - compiler->scanned ) ) != NULL )
+    {
+        compiler->scanned = ( size_t )( semicolon - compiler->buffer ) + 1;
+        ret               = Compiler_Compile( compiler, start, compiler->scanned - start );
+        start             = compiler->scanned;
+    }
+
+    /*
+     * The rest is moved once all the complete statements are compiled, so
+     * that feeding many statements at once doesn't move it for each one.
+     */
+    compiler->length -= start;
+    compiler->scanned = compiler->length;
+
+    memmove( compiler->buffer, compiler->buffer + start, compiler->length );
+
+    return ret;
+}
+
+/*
+ * Compiles what follows the last semicolon, at the end of the stream.
+ * Nothing can be fed afterwards.
+ */
+bool Compiler_Finish( CompilerRef compiler )
+{
+    if( compiler->finished )
+    {
+        return true;
+    }
+
+    compiler->finished = true;
+
+    if( compiler->length > 0 && Compiler_Compile( compiler, 0, compiler->length ) == false )
+    {
+        return false;
+    }
+
+    compiler->length = 0;
+
+    return true;
+}
+
+/*
+ * Feeds whatever is read from a file descriptor, such as a pipe, as soon as
+ * read() returns it, up to the end of input.
+ */
+bool Compiler_Read( CompilerRef compiler, int fd )
+{
+    char    bytes[ COMPILER_READ_SIZE ];
+    ssize_t n;
+
+    while( true )
+    {
+        do
+        {
+            n = read( fd, bytes, sizeof( bytes ) );
+        }
+        while( n < 0 && errno == EINTR );
+
+        if( n < 0 )
+        {
+            Error( NULL, "Cannot read input: %s", strerror( errno ) );
+
+            return false;
+        }
+
+        if( n == 0 )
+        {
+            return Compiler_Finish( compiler );
+        }
+
+        if( Compiler_Feed( compiler, bytes, ( size_t )n ) == false )
+        {
+            return false;
+        }
+    }
+}
+
+/*
+ * Compiles bytes held from start, which must follow the ones compiled
+ * last, with an input and a lexer of their own, whose locations start
+ * where those bytes are in the stream.
+ * The callback is called before Compiler_Feed returns, and must not feed
+ * more bytes.
+ */
+static bool Compiler_Compile( CompilerRef compiler, size_t start, size_t length )
+{
+    InputRef input;
+    LexerRef lexer;
+    FILE *   fh;
+    char *   messages;
+    size_t   size;
+    Span     statement;
+
+    messages = NULL;
+    size     = 0;
+
+    if( ( input = Input_CreateWithBytes( compiler->buffer + start, length ) ) == NULL )
+    {
+        return false;
+    }
+
+    Input_SetOrigin( input, compiler->line, compiler->column );
+
+    lexer = Lexer_Create( input );
+
+    Input_Release( input );
+
+    if( lexer == NULL || ( fh = open_memstream( &messages, &size ) ) == NULL )
+    {
+        Lexer_Release( lexer );
+
+        return false;
+    }
+
+    Lexer_SetDebug( lexer, compiler->debug );
+    Print_Capture( fh );
+    Parser_Statements( lexer );
+    Print_Capture( NULL );
+    Lexer_Release( lexer );
+
+    if( fclose( fh ) != 0 )
+    {
+        free( messages );
+
+        return false;
+    }
+
+    for( size_t i = start; i < start + length; i++ )
+    {
+        if( compiler->buffer[ i ] == '\n' )
+        {
+            compiler->line++;
+
+            compiler->column = 1;
+        }
+        else if( ( ( unsigned char )compiler->buffer[ i ] & 0xC0 ) != 0x80 )
+        {
+            compiler->column++;
+        }
+    }
+
+    statement.offset = compiler->offset;
+    statement.length = length;
+
+    compiler->offset += length;
+
+    compiler->callback( compiler, statement, messages, size, compiler->context );
+    free( messages );
+
+    return true;
+}
+
+static void Compiler_Print( CompilerRef compiler, Span statement, const char * messages, size_t size, void * context )
+{
+    ( void )compiler;
+    ( void )statement;
+    ( void )context;
+
+    Print_Replay( messages, size );
+    fflush( stdout );
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Compiler.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "Input.h"
+
+typedef struct Compiler * CompilerRef;
+
+/*
+ * Called once a statement is compiled, with its span in all the bytes fed
+ * so far, and the messages recorded while compiling it, including the
+ * generated code, which Print_Replay prints.
+ */
+typedef void ( * CompilerCallback )( CompilerRef compiler, Span statement, const char * messages, size_t size, void * context );
+
+CompilerRef Compiler_Create( CompilerCallback callback, void * context );
+CompilerRef Compiler_Retain( CompilerRef compiler );
+void        Compiler_Release( CompilerRef compiler );
+void        Compiler_SetDebug( CompilerRef compiler, bool value );
+bool        Compiler_Feed( CompilerRef compiler, const char * bytes, size_t length );
+bool        Compiler_Finish( CompilerRef compiler );
+bool        Compiler_Read( CompilerRef compiler, int fd );
+
+#endif /* COMPILER_H */
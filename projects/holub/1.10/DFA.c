@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        DFA.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-lexgen from DFA.l, do not edit.
+ *              9 states, 8 byte classes, 4 distinct rows.
+ */
+
+#include "DFA.h"
+#include "Lexer.h"
+#include <stdint.h>
+
+/*
+ * Class of each input byte.
+ */
+static const uint8_t DFA_Classes[ 256 ] =
+{
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,   0,   0,   0,   0,   0,   0,   0,   2,   3,   4,   5,   0,   0,   0,   0,
+      6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   0,   7,   0,   0,   0,   0,
+      0,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,
+      6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   0,   0,   0,   0,   0,
+      0,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,
+      6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   6,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0
+};
+
+/*
+ * Row of the transition table of each state. State 0 is the dead state,
+ * and state 1 the start state.
+ */
+static const uint8_t DFA_Rows[ 9 ] =
+{
+      0,   1,   2,   0,   0,   0,   0,   3,   0
+};
+
+static const uint8_t DFA_Transitions[ 4 ][ 8 ] =
+{
+    {
+          0,   0,   0,   0,   0,   0,   0,   0
+    },
+    {
+          0,   2,   3,   4,   5,   6,   7,   8
+    },
+    {
+          0,   2,   0,   0,   0,   0,   0,   0
+    },
+    {
+          0,   0,   0,   0,   0,   0,   7,   0
+    },
+};
+
+/*
+ * Rule accepted by each state.
+ */
+static const int DFA_Accept[ 9 ] =
+{
+    DFA_NONE,
+    DFA_NONE,
+    DFA_SKIP,
+    TokenLeftParenthesis,
+    TokenRightParenthesis,
+    TokenMultiply,
+    TokenAdd,
+    TokenNumericOrID,
+    TokenSemicolon,
+};
+
+int DFA_Match( const char * text, size_t * length )
+{
+    const unsigned char * p;
+    unsigned int          state;
+    int                   accept;
+    size_t                i;
+
+    p           = ( const unsigned char * )text;
+    state       = 1;
+    accept      = DFA_NONE;
+    i           = 0;
+    *( length ) = 1;
+
+    while( ( state = DFA_Transitions[ DFA_Rows[ state ] ][ DFA_Classes[ p[ i ] ] ] ) != 0 )
+    {
+        i++;
+
+        if( DFA_Accept[ state ] != DFA_NONE )
+        {
+            accept      = DFA_Accept[ state ];
+            *( length ) = i;
+        }
+    }
+
+    return accept;
+}
@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Grammar.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-llgen from Grammar.g, do not edit.
+ *              7 terminals, 6 nonterminals, 10 productions.
+ */
+
+#include "Grammar.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *   1  statements  -> {0} expression {1} TokenSemicolon statements
+ *   2  statements  -> epsilon
+ *   3  expression  -> term expression'
+ *   4  expression' -> TokenAdd {2} term {3} expression'
+ *   5  expression' -> epsilon
+ *   6  term        -> factor term'
+ *   7  term'       -> TokenMultiply {4} factor {5} term'
+ *   8  term'       -> epsilon
+ *   9  factor      -> {6} TokenNumericOrID
+ *  10  factor      -> TokenLeftParenthesis expression TokenRightParenthesis
+ *
+ * FIRST(  statements  ) = TokenLeftParenthesis TokenNumericOrID epsilon
+ * FIRST(  expression  ) = TokenLeftParenthesis TokenNumericOrID
+ * FIRST(  term        ) = TokenLeftParenthesis TokenNumericOrID
+ * FIRST(  expression' ) = TokenAdd epsilon
+ * FIRST(  factor      ) = TokenLeftParenthesis TokenNumericOrID
+ * FIRST(  term'       ) = TokenMultiply epsilon
+ * FOLLOW( statements  ) = TokenEnd
+ * FOLLOW( expression  ) = TokenSemicolon TokenRightParenthesis
+ * FOLLOW( term        ) = TokenSemicolon TokenAdd TokenRightParenthesis
+ * FOLLOW( expression' ) = TokenSemicolon TokenRightParenthesis
+ * FOLLOW( factor      ) = TokenSemicolon TokenAdd TokenMultiply TokenRightParenthesis
+ * FOLLOW( term'       ) = TokenSemicolon TokenAdd TokenRightParenthesis
+ */
+
+/*
+ * Stack entries below 0x100 are tokens.
+ */
+#define GRAMMAR_NONTERMINAL 0x100
+#define GRAMMAR_ACTION      0x200
+
+/*
+ * Stack entries kept on the C stack before spilling to the heap.
+ */
+#define GRAMMAR_STACK 64
+
+/*
+ * Largest stack moved to the heap, until Grammar_GetHeapPeak reads it.
+ */
+static size_t Grammar_HeapPeak = 0;
+
+/*
+ * Column of the table of each token.
+ */
+static const uint8_t Grammar_Columns[] =
+{
+    [ TokenEnd              ] = 1,
+    [ TokenSemicolon        ] = 2,
+    [ TokenAdd              ] = 3,
+    [ TokenMultiply         ] = 4,
+    [ TokenLeftParenthesis  ] = 5,
+    [ TokenRightParenthesis ] = 6,
+    [ TokenNumericOrID      ] = 7
+};
+
+_Static_assert( sizeof( Grammar_Columns ) <= GRAMMAR_NONTERMINAL, "Token values must be below GRAMMAR_NONTERMINAL" );
+
+/*
+ * Production plus one to expand each nonterminal with, by column.
+ */
+static const uint8_t Grammar_Table[ 6 ][ 8 ] =
+{
+    {
+          0,   2,   0,   0,   0,   1,   0,   1
+    },
+    {
+          0,   0,   0,   0,   0,   3,   0,   3
+    },
+    {
+          0,   0,   0,   0,   0,   6,   0,   6
+    },
+    {
+          0,   0,   5,   4,   0,   0,   5,   0
+    },
+    {
+          0,   0,   0,   0,   0,  10,   0,   9
+    },
+    {
+          0,   0,   8,   8,   7,   0,   8,   0
+    },
+};
+
+/*
+ * Start of the symbols of each production, which ends where the next
+ * one starts.
+ */
+static const uint16_t Grammar_Offsets[ 11 ] =
+{
+      0,   5,   5,   7,  12,  12,  14,  19,  19,  21,  24
+};
+
+/*
+ * Right-hand sides of the productions, reversed.
+ */
+static const uint16_t Grammar_Symbols[ 24 ] =
+{
+    GRAMMAR_NONTERMINAL + 0,
+    TokenSemicolon,
+    GRAMMAR_ACTION + 1,
+    GRAMMAR_NONTERMINAL + 1,
+    GRAMMAR_ACTION + 0,
+    GRAMMAR_NONTERMINAL + 3,
+    GRAMMAR_NONTERMINAL + 2,
+    GRAMMAR_NONTERMINAL + 3,
+    GRAMMAR_ACTION + 3,
+    GRAMMAR_NONTERMINAL + 2,
+    GRAMMAR_ACTION + 2,
+    TokenAdd,
+    GRAMMAR_NONTERMINAL + 5,
+    GRAMMAR_NONTERMINAL + 4,
+    GRAMMAR_NONTERMINAL + 5,
+    GRAMMAR_ACTION + 5,
+    GRAMMAR_NONTERMINAL + 4,
+    GRAMMAR_ACTION + 4,
+    TokenMultiply,
+    TokenNumericOrID,
+    GRAMMAR_ACTION + 6,
+    TokenRightParenthesis,
+    GRAMMAR_NONTERMINAL + 1,
+    TokenLeftParenthesis,
+};
+
+size_t Grammar_GetHeapPeak( void )
+{
+    size_t peak;
+
+    peak             = Grammar_HeapPeak;
+    Grammar_HeapPeak = 0;
+
+    return peak;
+}
+
+bool Grammar_Parse( LexerRef lexer )
+{
+    uint16_t   inlineStack[ GRAMMAR_STACK ];
+    uint16_t * stack;
+    size_t     count;
+    size_t     capacity;
+    bool       ok;
+
+    const char * names[ 8 ];
+    size_t       depth = 0;
+
+    stack      = inlineStack;
+    capacity   = GRAMMAR_STACK;
+    stack[ 0 ] = TokenEnd;
+    stack[ 1 ] = GRAMMAR_NONTERMINAL + 0;
+    count      = 2;
+    ok         = true;
+
+    while( ok && count > 0 )
+    {
+        unsigned int symbol;
+        unsigned int token;
+        unsigned int production;
+        size_t       length;
+
+        symbol = stack[ --count ];
+
+        if( symbol >= GRAMMAR_ACTION )
+        {
+            switch( symbol - GRAMMAR_ACTION )
+            {
+                case 0:
+
+                    names[ depth++ ] = Name_NewName();
+
+                    break;
+
+                case 1:
+
+                    Name_FreeName( names[ --depth ] );
+
+                    break;
+
+                case 2:
+
+                    names[ depth++ ] = Name_NewName();
+
+                    break;
+
+                case 3:
+
+                    Debug( lexer, "%s += %s", names[ depth - 2 ], names[ depth - 1 ] ); Name_FreeName( names[ --depth ] );
+
+                    break;
+
+                case 4:
+
+                    names[ depth++ ] = Name_NewName();
+
+                    break;
+
+                case 5:
+
+                    Debug( lexer, "%s *= %s", names[ depth - 2 ], names[ depth - 1 ] ); Name_FreeName( names[ --depth ] );
+
+                    break;
+
+                case 6:
+
+                    Debug( lexer, "%s = %1.*s", names[ depth - 1 ], ( int )Lexer_GetLength( lexer ), Lexer_GetText( lexer ) );
+
+                    break;
+
+                default:
+
+                    break;
+            }
+
+            continue;
+        }
+
+        token = ( unsigned int )( Lexer_GetLookahead( lexer ) );
+
+        if( symbol < GRAMMAR_NONTERMINAL )
+        {
+            if( symbol != token )
+            {
+                Error( lexer, "Syntax error" ); while( depth > 0 ) { Name_FreeName( names[ --depth ] ); }
+
+                ok = false;
+            }
+            else if( count > 0 )
+            {
+                Lexer_Advance( lexer );
+            }
+
+            continue;
+        }
+
+        production = ( token < sizeof( Grammar_Columns ) ) ? Grammar_Table[ symbol - GRAMMAR_NONTERMINAL ][ Grammar_Columns[ token ] ] : 0;
+
+        if( production == 0 )
+        {
+            Error( lexer, "Syntax error" ); while( depth > 0 ) { Name_FreeName( names[ --depth ] ); }
+
+            ok = false;
+
+            continue;
+        }
+
+        length = ( size_t )( Grammar_Offsets[ production ] - Grammar_Offsets[ production - 1 ] );
+
+        if( count + length > capacity )
+        {
+            uint16_t * grown;
+
+            if( ( grown = malloc( ( capacity * 2 + length ) * sizeof( uint16_t ) ) ) == NULL )
+            {
+                Error( lexer, "Syntax error" ); while( depth > 0 ) { Name_FreeName( names[ --depth ] ); }
+
+                ok = false;
+
+                continue;
+            }
+
+            memcpy( grown, stack, count * sizeof( uint16_t ) );
+
+            if( stack != inlineStack )
+            {
+                free( stack );
+            }
+
+            stack    = grown;
+            capacity = capacity * 2 + length;
+
+            if( capacity * sizeof( uint16_t ) > Grammar_HeapPeak )
+            {
+                Grammar_HeapPeak = capacity * sizeof( uint16_t );
+            }
+        }
+
+        memcpy( stack + count, Grammar_Symbols + Grammar_Offsets[ production - 1 ], length * sizeof( uint16_t ) );
+
+        count += length;
+    }
+
+    if( stack != inlineStack )
+    {
+        free( stack );
+    }
+
+    return ok;
+}
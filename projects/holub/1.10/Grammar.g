@@ -0,0 +1,42 @@
+#-------------------------------------------------------------------------------
+# Expression grammar, for tools-llgen.
+# Regenerate Grammar.c and Grammar.h with `make ll` after editing it.
+#
+# Actions produce the same code as Parser.c. names is the stack of
+# temporaries, the top one holding the value being computed, which are
+# released on a syntax error.
+#-------------------------------------------------------------------------------
+
+%include   "Lexer.h"
+%include   "Print.h"
+%include   "Name.h"
+%param     LexerRef lexer
+%lookahead Lexer_GetLookahead( lexer )
+%advance   Lexer_Advance( lexer );
+%error     Error( lexer, "Syntax error" ); while( depth > 0 ) { Name_FreeName( names[ --depth ] ); }
+%local     const char * names[ 8 ];
+%local     size_t       depth = 0;
+%token     TokenEnd TokenSemicolon TokenAdd TokenMultiply TokenLeftParenthesis TokenRightParenthesis TokenNumericOrID
+%end       TokenEnd
+
+statements  : { names[ depth++ ] = Name_NewName(); } expression { Name_FreeName( names[ --depth ] ); } TokenSemicolon statements
+            |
+            ;
+
+expression  : term expression'
+            ;
+
+expression' : TokenAdd { names[ depth++ ] = Name_NewName(); } term { Debug( lexer, "%s += %s", names[ depth - 2 ], names[ depth - 1 ] ); Name_FreeName( names[ --depth ] ); } expression'
+            |
+            ;
+
+term        : factor term'
+            ;
+
+term'       : TokenMultiply { names[ depth++ ] = Name_NewName(); } factor { Debug( lexer, "%s *= %s", names[ depth - 2 ], names[ depth - 1 ] ); Name_FreeName( names[ --depth ] ); } term'
+            |
+            ;
+
+factor      : { Debug( lexer, "%s = %1.*s", names[ depth - 1 ], ( int )Lexer_GetLength( lexer ), Lexer_GetText( lexer ) ); } TokenNumericOrID
+            | TokenLeftParenthesis expression TokenRightParenthesis
+            ;
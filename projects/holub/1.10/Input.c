@@ -0,0 +1,626 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Input.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Input.h"
+#include "Print.h"
+#include "Scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <pthread.h>
+
+/*
+ * Size of a single read() when streaming.
+ * The whole input is kept for the duration of the compilation, so spans
+ * remain valid. The buffer always has room for at least one more block
+ * after the data it holds, and doubles when it doesn't.
+ */
+#define INPUT_BLOCK_SIZE 65536
+
+/*
+ * Number of bytes added to the newline index at once.
+ */
+#define INPUT_INDEX_BLOCK 4096
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Tokens only carry offsets. Lines and columns are only needed when a
+ * message is printed, and are then found by a binary search in the offsets
+ * of the newlines. That index is only built up to the offsets asked for so
+ * far, and is locked, as lexers on several threads may print messages.
+ * The last column found is kept, so that messages moving along a long line
+ * don't count characters from its start each time.
+ */
+struct Input
+{
+    uint64_t        rc;
+    int             fd;
+    char *          buffer;
+    char *          end;
+    size_t          size;
+    size_t          mapSize;
+    bool            mapped;
+    bool            eof;
+    pthread_mutex_t lock;
+    size_t *        newlines;
+    size_t          newlineCount;
+    size_t          newlineCapacity;
+    size_t          indexed;
+    size_t          columnOffset;
+    size_t          column;
+    size_t          originLine;
+    size_t          originColumn;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Allocates a buffer for size bytes of data, aligned and padded with
+ * zeroes for the kernels of Scan.h, and moves the used bytes of the
+ * current one into it.
+ */
+static char * Input_Allocate( InputRef input, size_t size, size_t used )
+{
+    void * buffer;
+
+    if( posix_memalign( &buffer, SCAN_ALIGNMENT, size + SCAN_PADDING ) != 0 )
+    {
+        return NULL;
+    }
+
+    if( used > 0 )
+    {
+        memcpy( buffer, input->buffer, used );
+    }
+
+    memset( ( char * )buffer + used, 0, size + SCAN_PADDING - used );
+    free( input->buffer );
+
+    return buffer;
+}
+
+/*
+ * Creates an input streamed from a file descriptor, such as a pipe.
+ */
+InputRef Input_Create( int fd )
+{
+    InputRef input;
+
+    if( ( input = calloc( 1, sizeof( struct Input ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    if( pthread_mutex_init( &( input->lock ), NULL ) != 0 )
+    {
+        free( input );
+
+        return NULL;
+    }
+
+    if( ( input->buffer = Input_Allocate( input, 0, 0 ) ) == NULL )
+    {
+        pthread_mutex_destroy( &( input->lock ) );
+        free( input );
+
+        return NULL;
+    }
+
+    input->rc  = 1;
+    input->fd  = fd;
+    input->end = input->buffer;
+
+    return input;
+}
+
+/*
+ * Creates an input holding a copy of the given bytes, such as the buffer
+ * of an editor, which can then be changed with Input_Edit.
+ */
+InputRef Input_CreateWithBytes( const char * bytes, size_t length )
+{
+    InputRef input;
+    char *   buffer;
+
+    if( ( input = Input_Create( -1 ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    input->eof = true;
+
+    if( length == 0 )
+    {
+        return input;
+    }
+
+    if( ( buffer = Input_Allocate( input, length, 0 ) ) == NULL )
+    {
+        Input_Release( input );
+
+        return NULL;
+    }
+
+    memcpy( buffer, bytes, length );
+
+    input->buffer   = buffer;
+    input->size     = length;
+    input->end      = input->buffer + length;
+    *( input->end ) = 0;
+
+    return input;
+}
+
+/*
+ * Maps the whole file read-only, so the lexer can scan it in place.
+ * The mapping is placed over an anonymous region one byte larger than the
+ * file, which guarantees a NUL sentinel right after the last character,
+ * even when the file size is a multiple of the page size.
+ */
+InputRef Input_CreateWithFile( const char * path )
+{
+    InputRef    input;
+    int         fd;
+    struct stat st;
+    size_t      size;
+    size_t      page;
+    char *      map;
+
+    if( ( fd = open( path, O_RDONLY ) ) < 0 )
+    {
+        Error( NULL, "Cannot open %s: %s", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    if( fstat( fd, &st ) != 0 || S_ISREG( st.st_mode ) == false )
+    {
+        Error( NULL, "Cannot map %s: not a regular file", path );
+        close( fd );
+
+        return NULL;
+    }
+
+    if( ( input = Input_Create( -1 ) ) == NULL )
+    {
+        close( fd );
+
+        return NULL;
+    }
+
+    input->mapped = true;
+    size          = ( size_t )( st.st_size );
+
+    if( size == 0 )
+    {
+        close( fd );
+
+        return input;
+    }
+
+    page = ( size_t )sysconf( _SC_PAGESIZE );
+    size = ( ( size + 1 + page - 1 ) / page ) * page;
+    map  = mmap( NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0 );
+
+    if( map == MAP_FAILED )
+    {
+        Error( NULL, "Cannot map %s: %s", path, strerror( errno ) );
+        close( fd );
+        Input_Release( input );
+
+        return NULL;
+    }
+
+    if( mmap( map, ( size_t )( st.st_size ), PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0 ) == MAP_FAILED )
+    {
+        Error( NULL, "Cannot map %s: %s", path, strerror( errno ) );
+        munmap( map, size );
+        close( fd );
+        Input_Release( input );
+
+        return NULL;
+    }
+
+    close( fd );
+
+#ifdef MADV_SEQUENTIAL
+    madvise( map, size, MADV_SEQUENTIAL );
+#endif
+
+    free( input->buffer );
+
+    input->buffer  = map;
+    input->end     = map + st.st_size;
+    input->mapSize = size;
+
+    return input;
+}
+
+InputRef Input_Retain( InputRef input )
+{
+    if( input == NULL )
+    {
+        return NULL;
+    }
+
+    input->rc++;
+
+    return input;
+}
+
+void Input_Release( InputRef input )
+{
+    if( input == NULL )
+    {
+        return;
+    }
+
+    if( --( input->rc ) > 0 )
+    {
+        return;
+    }
+
+    if( input->mapped && input->mapSize > 0 )
+    {
+        munmap( input->buffer, input->mapSize );
+    }
+    else
+    {
+        free( input->buffer );
+    }
+
+    pthread_mutex_destroy( &( input->lock ) );
+    free( input->newlines );
+    free( input );
+}
+
+char * Input_GetStart( InputRef input )
+{
+    return input->buffer;
+}
+
+/*
+ * Number of bytes read so far, which is the whole input once mapped.
+ */
+size_t Input_GetLength( InputRef input )
+{
+    return ( size_t )( input->end - input->buffer );
+}
+
+/*
+ * Adds the newlines of the next block of data to the index.
+ */
+static bool Input_IndexBlock( InputRef input )
+{
+    size_t length;
+
+    length = ( size_t )( input->end - input->buffer ) - input->indexed;
+    length = ( length > INPUT_INDEX_BLOCK ) ? INPUT_INDEX_BLOCK : length;
+
+    if( input->newlineCount + length > input->newlineCapacity )
+    {
+        size_t   capacity;
+        size_t * newlines;
+
+        capacity = ( input->newlineCapacity == 0 ) ? INPUT_INDEX_BLOCK * 2 : input->newlineCapacity * 2;
+
+        if( ( newlines = realloc( input->newlines, capacity * sizeof( size_t ) ) ) == NULL )
+        {
+            return false;
+        }
+
+        input->newlines        = newlines;
+        input->newlineCapacity = capacity;
+    }
+
+    input->newlineCount += Scan_Newlines( input->buffer + input->indexed, length, input->indexed, input->newlines + input->newlineCount );
+    input->indexed      += length;
+
+    return true;
+}
+
+/*
+ * Number of indexed newlines before an offset.
+ */
+static size_t Input_CountNewlines( InputRef input, size_t offset )
+{
+    size_t low;
+    size_t high;
+
+    low  = 0;
+    high = input->newlineCount;
+
+    while( low < high )
+    {
+        size_t middle;
+
+        middle = low + ( high - low ) / 2;
+
+        if( input->newlines[ middle ] < offset )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * Finds the line and column, both starting at 1, of a byte offset in the
+ * data read so far. Columns count characters: UTF-8 continuation bytes
+ * are skipped.
+ */
+void Input_GetLocation( InputRef input, size_t offset, size_t * line, size_t * column )
+{
+    size_t low;
+    size_t start;
+
+    pthread_mutex_lock( &( input->lock ) );
+
+    while( input->indexed <= offset && input->indexed < ( size_t )( input->end - input->buffer ) )
+    {
+        if( Input_IndexBlock( input ) == false )
+        {
+            break;
+        }
+    }
+
+    low = Input_CountNewlines( input, offset );
+
+    start     = ( low == 0 ) ? 0 : input->newlines[ low - 1 ] + 1;
+    *( line ) = low + 1;
+
+    if( input->column == 0 || input->columnOffset < start || input->columnOffset > offset )
+    {
+        input->columnOffset = start;
+        input->column       = 1;
+    }
+
+    for( size_t i = input->columnOffset; i < offset; i++ )
+    {
+        if( ( ( unsigned char )input->buffer[ i ] & 0xC0 ) != 0x80 )
+        {
+            input->column++;
+        }
+    }
+
+    input->columnOffset = offset;
+    *( column )         = input->column + ( ( low == 0 ) ? input->originColumn : 0 );
+    *( line )          += input->originLine;
+
+    pthread_mutex_unlock( &( input->lock ) );
+}
+
+/*
+ * Sets the location of the first byte, for an input holding a part of a
+ * larger text, so that locations are found in that text.
+ */
+void Input_SetOrigin( InputRef input, size_t line, size_t column )
+{
+    pthread_mutex_lock( &( input->lock ) );
+
+    input->originLine   = ( line > 0 ) ? line - 1 : 0;
+    input->originColumn = ( column > 0 ) ? column - 1 : 0;
+
+    pthread_mutex_unlock( &( input->lock ) );
+}
+
+/*
+ * A mapped input never moves, so its bytes can be read by one thread while
+ * another one scans it.
+ */
+bool Input_IsMapped( InputRef input )
+{
+    return input->mapped;
+}
+
+/*
+ * Tells whether a NUL byte seen by the lexer is the sentinel placed after
+ * the buffered data, as opposed to a NUL byte in the input itself.
+ */
+bool Input_IsEnd( InputRef input, const char * current )
+{
+    return current == input->end;
+}
+
+size_t Input_GetOffset( InputRef input, const char * p )
+{
+    return ( size_t )( p - input->buffer );
+}
+
+/*
+ * Spans are offsets into the input, so they stay valid even if the buffer
+ * moves, but the returned pointer is only valid until the next refill.
+ */
+const char * Input_GetBytes( InputRef input, Span span )
+{
+    return input->buffer + span.offset;
+}
+
+bool Input_SpanEquals( InputRef input, Span span, const char * s )
+{
+    return strncmp( input->buffer + span.offset, s, span.length ) == 0 && s[ span.length ] == 0;
+}
+
+/*
+ * Called by the lexer when it reaches the sentinel.
+ * The next block is read right after the data already held, so a token
+ * spanning two reads is never split nor truncated, and nothing is moved
+ * unless the buffer needs to grow. Both pointers are updated if it does.
+ * Returns false at end of input, or if current isn't at the sentinel.
+ */
+bool Input_Fill( InputRef input, char ** mark, char ** current )
+{
+    size_t  used;
+    size_t  offset;
+    ssize_t n;
+
+    if( *( current ) != input->end || input->mapped || input->eof )
+    {
+        return false;
+    }
+
+    used   = ( size_t )( input->end - input->buffer );
+    offset = ( size_t )( *( mark ) - input->buffer );
+
+    if( used + INPUT_BLOCK_SIZE > input->size )
+    {
+        size_t size;
+        char * buffer;
+
+        size = ( input->size == 0 ) ? INPUT_BLOCK_SIZE * 2 : input->size * 2;
+
+        if( ( buffer = Input_Allocate( input, size, used ) ) == NULL )
+        {
+            Error( NULL, "Out of memory" );
+            abort();
+        }
+
+        input->buffer = buffer;
+        input->size   = size;
+    }
+
+    do
+    {
+        n = read( input->fd, input->buffer + used, input->size - used );
+    }
+    while( n < 0 && errno == EINTR );
+
+    if( n < 0 )
+    {
+        Error( NULL, "Cannot read input: %s", strerror( errno ) );
+    }
+
+    if( n <= 0 )
+    {
+        n          = 0;
+        input->eof = true;
+    }
+
+    input->end      = input->buffer + used + n;
+    *( input->end ) = 0;
+    *( mark )       = input->buffer + offset;
+    *( current )    = input->buffer + used;
+
+    return n > 0;
+}
+
+/*
+ * Replaces removed bytes at offset with length bytes of text, which must
+ * not point into the input. A streamed input is read to its end first.
+ * Mapped inputs are read-only and can't be edited.
+ * The newline index is only dropped from the offset of the edit, and the
+ * buffer may move, so pointers into it must be taken again.
+ */
+bool Input_Edit( InputRef input, size_t offset, size_t removed, const char * text, size_t length )
+{
+    char * current;
+    size_t used;
+    size_t total;
+
+    if( input->mapped )
+    {
+        return false;
+    }
+
+    current = input->end;
+
+    while( Input_Fill( input, &current, &current ) )
+    {
+        current = input->end;
+    }
+
+    used = ( size_t )( input->end - input->buffer );
+
+    if( offset > used || removed > used - offset )
+    {
+        return false;
+    }
+
+    total = used - removed + length;
+
+    if( total > input->size )
+    {
+        size_t size;
+        char * buffer;
+
+        size = ( input->size * 2 > total ) ? input->size * 2 : total;
+
+        if( ( buffer = Input_Allocate( input, size, used ) ) == NULL )
+        {
+            return false;
+        }
+
+        input->buffer = buffer;
+        input->size   = size;
+    }
+
+    memmove( input->buffer + offset + length, input->buffer + offset + removed, used - offset - removed );
+    memcpy( input->buffer + offset, text, length );
+
+    input->end      = input->buffer + total;
+    *( input->end ) = 0;
+
+    /*
+     * A shrinking edit leaves the old tail past the new sentinel, where the
+     * kernels of Scan.h expect zeroes.
+     */
+    if( total < used )
+    {
+        memset( input->end + 1, 0, used - total );
+    }
+
+    pthread_mutex_lock( &( input->lock ) );
+
+    input->indexed      = ( input->indexed < offset ) ? input->indexed : offset;
+    input->newlineCount = Input_CountNewlines( input, input->indexed );
+    input->column       = 0;
+
+    pthread_mutex_unlock( &( input->lock ) );
+
+    return true;
+}
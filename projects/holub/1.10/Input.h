@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Input.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct Input * InputRef;
+
+typedef struct
+{
+    size_t offset;
+    size_t length;
+} Span;
+
+/*
+ * The data of an input is followed by a NUL sentinel, and is held in a
+ * buffer aligned and padded for the kernels of Scan.h: it starts on a
+ * SCAN_ALIGNMENT boundary, with at least SCAN_PADDING bytes from the
+ * sentinel, which are zeroes unless the input is mapped.
+ */
+InputRef Input_Create( int fd );
+InputRef Input_CreateWithFile( const char * path );
+InputRef Input_CreateWithBytes( const char * bytes, size_t length );
+InputRef Input_Retain( InputRef input );
+void     Input_Release( InputRef input );
+char *   Input_GetStart( InputRef input );
+size_t   Input_GetLength( InputRef input );
+bool     Input_IsMapped( InputRef input );
+bool     Input_IsEnd( InputRef input, const char * current );
+bool     Input_Fill( InputRef input, char ** mark, char ** current );
+bool     Input_Edit( InputRef input, size_t offset, size_t removed, const char * text, size_t length );
+
+size_t       Input_GetOffset( InputRef input, const char * p );
+void         Input_GetLocation( InputRef input, size_t offset, size_t * line, size_t * column );
+void         Input_SetOrigin( InputRef input, size_t line, size_t column );
+const char * Input_GetBytes( InputRef input, Span span );
+bool         Input_SpanEquals( InputRef input, Span span, const char * s );
+
+#endif /* INPUT_H */
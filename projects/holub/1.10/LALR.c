@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        LALR.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-lrgen from LALR.y, do not edit.
+ *              12 states, 16 actions and 3 gotos packed in 24 and 13 entries.
+ */
+
+#include "LALR.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *   0  $accept    -> statements
+ *   1  statements -> statements expression TokenSemicolon
+ *   2  statements -> epsilon
+ *   3  expression -> expression TokenAdd expression
+ *   4  expression -> expression TokenMultiply expression
+ *   5  expression -> TokenLeftParenthesis expression TokenRightParenthesis
+ *   6  expression -> TokenNumericOrID
+ */
+
+/*
+ * Stack entries kept on the C stack before spilling to the heap.
+ */
+#define LALR_STACK 64
+
+/*
+ * Largest stack moved to the heap, until LALR_GetHeapPeak reads it.
+ */
+static size_t LALR_HeapPeak = 0;
+
+/*
+ * Column of the action table of each token, 0 being unused.
+ */
+static const uint8_t LALR_Columns[] =
+{
+    [ TokenEnd              ] = 1,
+    [ TokenSemicolon        ] = 2,
+    [ TokenLeftParenthesis  ] = 3,
+    [ TokenRightParenthesis ] = 4,
+    [ TokenNumericOrID      ] = 5,
+    [ TokenAdd              ] = 6,
+    [ TokenMultiply         ] = 7
+};
+
+/*
+ * Actions are the state to shift to, -1 minus the rule to reduce, rule 0
+ * accepting the input, or 0 for a syntax error.
+ */
+static const int16_t LALR_Default[ 12 ] =
+{
+      -3,    0,    0,   -7,    0,    0,   -2,    0,    0,   -6,   -4,   -5
+};
+
+static const uint16_t LALR_Base[ 12 ] =
+{
+      0,   1,   2,   3,   6,  10,   4,  15,  16,   5,   8,   7
+};
+
+static const uint16_t LALR_Check[ 24 ] =
+{
+    65535, 65535,   1, 65535,   1,   2,   1,   2,   4, 65535, 65535, 65535,   4,   4,   5,  10,
+      5,   5,   7,   8,   7,   8, 65535, 65535
+};
+
+static const int16_t LALR_Next[ 24 ] =
+{
+       0,    0,   -1,    0,    2,    2,    3,    3,    6,    0,    0,    0,    7,    8,    9,    8,
+       7,    8,    2,    2,    3,    3,    0,    0
+};
+
+/*
+ * State to go to after reducing to each nonterminal, by state.
+ */
+static const uint16_t LALR_GotoDefault[ 2 ] =
+{
+      1,   4
+};
+
+static const uint16_t LALR_GotoBase[ 2 ] =
+{
+      0,   1
+};
+
+static const uint16_t LALR_GotoCheck[ 13 ] =
+{
+    65535, 65535, 65535,   1, 65535, 65535, 65535, 65535,   1,   1, 65535, 65535, 65535
+};
+
+static const uint16_t LALR_GotoNext[ 13 ] =
+{
+       0,    0,    0,    5,    0,    0,    0,    0,   10,   11,    0,    0,    0
+};
+
+/*
+ * Length and left-hand side of each rule.
+ */
+static const uint8_t LALR_Lengths[ 7 ] =
+{
+      1,   3,   0,   3,   3,   3,   1
+};
+
+static const uint8_t LALR_Lhs[ 7 ] =
+{
+      0,   0,   0,   1,   1,   1,   1
+};
+
+size_t LALR_GetHeapPeak( void )
+{
+    size_t peak;
+
+    peak          = LALR_HeapPeak;
+    LALR_HeapPeak = 0;
+
+    return peak;
+}
+
+bool LALR_Parse( LexerRef lexer )
+{
+    uint16_t      inlineStates[ LALR_STACK ];
+    ParserValue   inlineValues[ LALR_STACK ];
+    uint16_t *    states;
+    ParserValue * values;
+    ParserValue   value;
+    size_t        count;
+    size_t        capacity;
+    bool          ok;
+
+    states      = inlineStates;
+    values      = inlineValues;
+    capacity    = LALR_STACK;
+    states[ 0 ] = 0;
+    count       = 1;
+    ok          = true;
+
+    while( true )
+    {
+        unsigned int state;
+        unsigned int token;
+        unsigned int index;
+        unsigned int production;
+        unsigned int lhs;
+        size_t       length;
+        int          action;
+
+        if( count == capacity )
+        {
+            uint16_t *    grownStates;
+            ParserValue * grownValues;
+
+            grownStates = malloc( capacity * 2 * sizeof( uint16_t ) );
+            grownValues = malloc( capacity * 2 * sizeof( ParserValue ) );
+
+            if( grownStates == NULL || grownValues == NULL )
+            {
+                free( grownStates );
+                free( grownValues );
+                Error( lexer, "Syntax error" );
+
+                ok = false;
+
+                break;
+            }
+
+            memcpy( grownStates, states, count * sizeof( uint16_t ) );
+            memcpy( grownValues, values, count * sizeof( ParserValue ) );
+
+            if( states != inlineStates )
+            {
+                free( states );
+                free( values );
+            }
+
+            states    = grownStates;
+            values    = grownValues;
+            capacity *= 2;
+
+            if( capacity * ( sizeof( uint16_t ) + sizeof( ParserValue ) ) > LALR_HeapPeak )
+            {
+                LALR_HeapPeak = capacity * ( sizeof( uint16_t ) + sizeof( ParserValue ) );
+            }
+        }
+
+        state  = states[ count - 1 ];
+        token  = ( unsigned int )( Lexer_GetLookahead( lexer ) );
+        index  = LALR_Base[ state ] + ( ( token < sizeof( LALR_Columns ) ) ? LALR_Columns[ token ] : 0U );
+        action = ( LALR_Check[ index ] == state ) ? LALR_Next[ index ] : LALR_Default[ state ];
+
+        if( action > 0 )
+        {
+            states[ count ] = ( uint16_t )action;
+
+            values[ count ].span = Lexer_GetSpan( lexer ); values[ count ].name = NULL;
+
+            count++;
+
+            Lexer_Advance( lexer );
+
+            continue;
+        }
+
+        if( action == 0 )
+        {
+            Error( lexer, "Syntax error" );
+
+            ok = false;
+
+            break;
+        }
+
+        if( ( production = ( unsigned int )( -action - 1 ) ) == 0 )
+        {
+            break;
+        }
+
+        length = LALR_Lengths[ production ];
+
+        if( length > 0 )
+        {
+            value = values[ count - length ];
+        }
+        else
+        {
+            memset( &value, 0, sizeof( value ) );
+        }
+
+        switch( production )
+        {
+            case 1:
+
+                Name_FreeName( values[ count - 2 ].name );
+
+                break;
+
+            case 3:
+
+                Debug( lexer, "%s += %s", values[ count - 3 ].name, values[ count - 1 ].name ); Name_FreeName( values[ count - 1 ].name );
+
+                break;
+
+            case 4:
+
+                Debug( lexer, "%s *= %s", values[ count - 3 ].name, values[ count - 1 ].name ); Name_FreeName( values[ count - 1 ].name );
+
+                break;
+
+            case 5:
+
+                value = values[ count - 2 ];
+
+                break;
+
+            case 6:
+
+                value.name = Name_NewName(); Debug( lexer, "%s = %1.*s", value.name, ( int )values[ count - 1 ].span.length, Input_GetBytes( Lexer_GetInput( lexer ), values[ count - 1 ].span ) );
+
+                break;
+
+            default:
+
+                break;
+        }
+
+        if( ok == false )
+        {
+            break;
+        }
+
+        count          -= length;
+        state           = states[ count - 1 ];
+        lhs             = LALR_Lhs[ production ];
+        index           = LALR_GotoBase[ lhs ] + state;
+        states[ count ] = ( LALR_GotoCheck[ index ] == lhs ) ? LALR_GotoNext[ index ] : LALR_GotoDefault[ lhs ];
+        values[ count ] = value;
+
+        count++;
+    }
+
+    while( ok == false && count > 1 )
+    {
+        count--;
+
+        if( values[ count ].name != NULL ) { Name_FreeName( values[ count ].name ); }
+    }
+
+    if( states != inlineStates )
+    {
+        free( states );
+        free( values );
+    }
+
+    return ok;
+}
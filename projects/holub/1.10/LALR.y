@@ -0,0 +1,34 @@
+#-------------------------------------------------------------------------------
+# Expression grammar, for tools-lrgen.
+# Regenerate LALR.c and LALR.h with `make lr` after editing it.
+#
+# Actions produce the same code as Parser.c. Tokens keep their text, as a
+# rule is only reduced once the token after it was read, and expressions
+# their temporary, released by %drop when left on the stack by an error.
+#-------------------------------------------------------------------------------
+
+%include   "Lexer.h"
+%include   "Parser.h"
+%include   "Print.h"
+%include   "Name.h"
+%param     LexerRef lexer
+%lookahead Lexer_GetLookahead( lexer )
+%advance   Lexer_Advance( lexer );
+%error     Error( lexer, "Syntax error" );
+%drop      if( $$.name != NULL ) { Name_FreeName( $$.name ); }
+%value     ParserValue
+%shift     $$.span = Lexer_GetSpan( lexer ); $$.name = NULL;
+%token     TokenEnd TokenSemicolon TokenLeftParenthesis TokenRightParenthesis TokenNumericOrID
+%left      TokenAdd
+%left      TokenMultiply
+%end       TokenEnd
+
+statements  : statements expression TokenSemicolon { Name_FreeName( $2.name ); }
+            |
+            ;
+
+expression  : expression TokenAdd expression { Debug( lexer, "%s += %s", $1.name, $3.name ); Name_FreeName( $3.name ); }
+            | expression TokenMultiply expression { Debug( lexer, "%s *= %s", $1.name, $3.name ); Name_FreeName( $3.name ); }
+            | TokenLeftParenthesis expression TokenRightParenthesis { $$ = $2; }
+            | TokenNumericOrID { $$.name = Name_NewName(); Debug( lexer, "%s = %1.*s", $$.name, ( int )$1.span.length, Input_GetBytes( Lexer_GetInput( lexer ), $1.span ) ); }
+            ;
@@ -31,176 +31,1272 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
+#include "UTF8.h"
+#include "TokenStream.h"
+#include "TokenQueue.h"
+#include "Number.h"
+#include "Scan.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <stdarg.h>
+#include <string.h>
+#include <pthread.h>
 
-static char * Lexer_Text      = "";
-static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
-static int    Lexer_Lookahead = -1;
+/*
+ * Smallest chunk Lexer_TokenizeParallel gives a thread of its own.
+ */
+#define LEXER_CHUNK_MIN ( 1024 * 1024 )
+
+/*
+ * Kind of the token queue entries carrying illegal input, which the lexer
+ * thread pushes before the token that follows it.
+ */
+#define LEXER_ILLEGAL 0xFF
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Illegal input found while lexing ahead of the parser, which is only
+ * reported when the parser reads the token after it.
+ */
+typedef struct
+{
+    size_t   token;
+    uint64_t offset;
+    uint32_t length;
+} LexerIllegal;
+
+/*
+ * Everything the lexer knows about a compilation lives here rather than in
+ * file-level globals, so independent inputs can be lexed on separate
+ * threads, each with its own lexer.
+ * A lexer which defers its messages records illegal input instead of
+ * reporting it, and leaves numbers too large to the lexer reading its
+ * tokens back, so messages are printed in the order of the input, along
+ * with the parser's, rather than while lexing ahead.
+ */
+struct Lexer
+{
+    uint64_t         rc;
+    InputRef         input;
+    char *           text;
+    size_t           length;
+    uint64_t         value;
+    int              lookahead;
+    TokenStreamRef   stream;
+    size_t           position;
+    const uint8_t *  kinds;
+    const uint64_t * offsets;
+    const uint32_t * lengths;
+    bool             debug;
+    LexerRef         scanner;
+    TokenQueueRef    queue;
+    pthread_t        thread;
+    bool             ended;
+    const char *     limit;
+    const char *     end;
+    bool             deferred;
+    LexerIllegal *   illegal;
+    size_t           illegalCount;
+    size_t           illegalCapacity;
+    size_t           illegalNext;
+    size_t           decoded;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+LexerRef Lexer_Create( InputRef input )
+{
+    LexerRef lexer;
+
+    if( input == NULL || ( lexer = calloc( 1, sizeof( struct Lexer ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->rc        = 1;
+    lexer->input     = Input_Retain( input );
+    lexer->lookahead = -1;
+    lexer->debug     = true;
+
+    return lexer;
+}
+
+LexerRef Lexer_Retain( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->rc++;
+
+    return lexer;
+}
+
+void Lexer_Release( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return;
+    }
+
+    if( --( lexer->rc ) > 0 )
+    {
+        return;
+    }
+
+    if( lexer->queue != NULL )
+    {
+        TokenQueue_Close( lexer->queue );
+        pthread_join( lexer->thread, NULL );
+        TokenQueue_Release( lexer->queue );
+        Lexer_Release( lexer->scanner );
+    }
+
+    TokenStream_Release( lexer->stream );
+    Input_Release( lexer->input );
+    free( lexer->illegal );
+    free( lexer );
+}
+
+/*
+ * Creates a lexer reading only a span of a mapped input, for which
+ * Lexer_Next returns TokenEnd once a token ends at the end of the span.
+ * The span must end where a token or the input does, like the statements
+ * found by Parser_StatementsParallel, which end with a semicolon.
+ */
+LexerRef Lexer_CreateWithSpan( InputRef input, Span span )
+{
+    LexerRef lexer;
+
+    if( input == NULL || Input_IsMapped( input ) == false || span.offset + span.length > Input_GetLength( input ) )
+    {
+        return NULL;
+    }
+
+    if( ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->text = Input_GetStart( input ) + span.offset;
+    lexer->end  = lexer->text + span.length;
+
+    return lexer;
+}
+
+InputRef Lexer_GetInput( LexerRef lexer )
+{
+    return lexer->input;
+}
+
+bool Lexer_IsDebug( LexerRef lexer )
+{
+    return lexer->debug;
+}
+
+void Lexer_SetDebug( LexerRef lexer, bool value )
+{
+    lexer->debug = value;
+}
+
+const char * Lexer_GetText( LexerRef lexer )
+{
+    return lexer->text;
+}
+
+size_t Lexer_GetLength( LexerRef lexer )
+{
+    return lexer->length;
+}
+
+/*
+ * Value of the current token, if it is a decimal number, decoded while
+ * scanning. Saturates at UINT64_MAX for numbers too large.
+ */
+uint64_t Lexer_GetValue( LexerRef lexer )
+{
+    return lexer->value;
+}
+
+Span Lexer_GetSpan( LexerRef lexer )
+{
+    Span span;
+
+    span.offset = ( lexer->text == NULL ) ? 0 : Input_GetOffset( lexer->input, lexer->text );
+    span.length = lexer->length;
+
+    return span;
+}
+
+/*
+ * Lines and columns aren't tracked while scanning, but looked up from the
+ * offset of the current token, which is only done for messages.
+ */
+void Lexer_GetLocation( LexerRef lexer, size_t * line, size_t * column )
+{
+    Input_GetLocation( lexer->input, Lexer_GetSpan( lexer ).offset, line, column );
+}
+
+/*
+ * Decodes the value of a numeric token. Identifiers, and numbers followed
+ * by letters, have a value of 0.
+ * Overflows are reported once: when the token is scanned or, if the lexer
+ * defers its messages, when it is first read back from a token stream or
+ * queue.
+ */
+static void Lexer_Decode( LexerRef lexer, bool report )
+{
+    lexer->value = 0;
+
+    if( lexer->length == 0 || CharClass_Is( *( lexer->text ), CharClassDigit ) == false )
+    {
+        return;
+    }
+
+    if( Number_Decode( lexer->text, lexer->length, &( lexer->value ) ) == NumberOverflow && report && ( lexer->limit == NULL || lexer->text < lexer->limit ) )
+    {
+        Error( lexer, "Numeric literal too large: %1.*s", ( int )( lexer->length ), lexer->text );
+    }
+}
+
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+static void Lexer_ReportIllegal( LexerRef lexer, const char * p, size_t length )
+{
+    if( *( p ) == 0 )
+    {
+        Error( lexer, "Ignoring illegal input: NUL" );
+    }
+    else if( length == 1 && CharClass_Is( *( p ), CharClassHigh ) )
+    {
+        Error( lexer, "Ignoring invalid UTF-8 byte: 0x%02X", ( unsigned char )*( p ) );
+    }
+    else
+    {
+        Error( lexer, "Ignoring illegal input: %1.*s", ( int )length, p );
+    }
+}
+
+/*
+ * Reports illegal input, or records it if the lexer defers its messages.
+ * It is reported right away if it can't be recorded.
+ */
+static void Lexer_Report( LexerRef lexer, const char * p, size_t length )
+{
+    if( lexer->deferred && lexer->illegalCount == lexer->illegalCapacity )
+    {
+        LexerIllegal * illegal;
+        size_t         capacity;
+
+        capacity = ( lexer->illegalCapacity == 0 ) ? 16 : lexer->illegalCapacity * 2;
+
+        if( ( illegal = realloc( lexer->illegal, capacity * sizeof( LexerIllegal ) ) ) != NULL )
+        {
+            lexer->illegal         = illegal;
+            lexer->illegalCapacity = capacity;
+        }
+    }
+
+    if( lexer->deferred == false || lexer->illegalCount == lexer->illegalCapacity )
+    {
+        Lexer_ReportIllegal( lexer, p, length );
+
+        return;
+    }
+
+    lexer->illegal[ lexer->illegalCount ].token  = SIZE_MAX;
+    lexer->illegal[ lexer->illegalCount ].offset = Input_GetOffset( lexer->input, p );
+    lexer->illegal[ lexer->illegalCount ].length = ( uint32_t )length;
+
+    lexer->illegalCount++;
+}
+
+/*
+ * Gives the illegal input recorded since the last call the index of the
+ * token following it, and returns the number of records.
+ */
+static size_t Lexer_TagIllegal( LexerRef lexer, size_t tagged, size_t token )
+{
+    for( ; tagged < lexer->illegalCount; tagged++ )
+    {
+        lexer->illegal[ tagged ].token = token;
+    }
+
+    return tagged;
+}
 
-const char * Lexer_GetText( void )
+/*
+ * Reports recorded illegal input, on the thread reading the tokens. The
+ * current token is moved to it, for its location, so this must be done
+ * before reading the next token.
+ */
+static void Lexer_Replay( LexerRef lexer, uint64_t offset, uint32_t length )
 {
-    return Lexer_Text;
+    lexer->text   = Input_GetStart( lexer->input ) + offset;
+    lexer->length = length;
+
+    Lexer_ReportIllegal( lexer, lexer->text, length );
 }
 
-size_t Lexer_GetLength( void )
+/*
+ * Reports the illegal input at p, unless it belongs to the next chunk, and
+ * returns its length: a whole UTF-8 sequence if it is a valid one, or a
+ * single byte.
+ */
+static size_t Lexer_Illegal( LexerRef lexer, const char * p )
 {
-    return Lexer_Length;
+    uint32_t codepoint;
+    size_t   length;
+
+    if( ( length = UTF8_Decode( p, &codepoint ) ) == 0 )
+    {
+        length = 1;
+    }
+
+    if( lexer->limit == NULL || p < lexer->limit )
+    {
+        Lexer_Report( lexer, p, length );
+    }
+
+    return length;
 }
 
-size_t Lexer_GetLine( void )
+/*
+ * Reads more input when the buffer ends within a UTF-8 sequence at p, the
+ * start of the current token, and moves p along with the buffer.
+ */
+static bool Lexer_Refill( LexerRef lexer, char ** p )
 {
-    return Lexer_Line;
+    char * end;
+
+    if( CharClass_Is( **( p ), CharClassHigh ) == false )
+    {
+        return false;
+    }
+
+    for( end = *( p ); *( end ) != 0 && end < *( p ) + UTF8_MAX_LENGTH; end++ )
+    {}
+
+    if( Input_Fill( lexer->input, &( lexer->text ), &end ) == false )
+    {
+        return false;
+    }
+
+    *( p ) = lexer->text;
+
+    return true;
 }
 
-Token Lexer_Next( void )
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: Debug( lexer, "Token: " text ); return name;
+
+static Token Lexer_Scan( LexerRef lexer )
 {
-    static char buf[ 128 ];
-    char *      current;
+    char * current;
+    char * end;
 
-    current = Lexer_Text + Lexer_Length;
+    current      = ( lexer->text == NULL ) ? Input_GetStart( lexer->input ) : lexer->text + lexer->length;
+    lexer->value = 0;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        lexer->text   = current;
+        lexer->length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( lexer->input, &( lexer->text ), &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( lexer->input, current ) )
+                {
+                    lexer->length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                if( lexer->limit == NULL || current < lexer->limit )
+                {
+                    Lexer_Report( lexer, current, 1 );
+                }
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
+                break;
 
-            switch( *( current ) )
-            {
-                case EOF: Debug( "Token: End" ); return TokenEnd;
-                case ';': Debug( "Token: ;" ); return TokenSemicolon;
-                case '+': Debug( "Token: +" ); return TokenAdd;
-                case '*': Debug( "Token: *" ); return TokenMultiply;
-                case '(': Debug( "Token: (" ); return TokenLeftParenthesis;
-                case ')': Debug( "Token: )" ); return TokenRightParenthesis;
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
 
-                case '\n':
-                case '\t':
-                case ' ':
+            case '\n':
+            case '\r':
+            case '\t':
+            case ' ':
 
-                    break;
+                current += Scan_Space( current );
 
-                default:
+                break;
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Error( "Ignoring illegal input: %c", *( current ) );
+            default:
 
-                        break;
-                    }
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current += Scan_Space( current );
+
+                    break;
+                }
 
-                    while( isalnum( *( current ) ) )
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false && UTF8_ScanIdentifier( current, UTF8_MAX_LENGTH ) == 0 )
+                {
+                    if( Lexer_Refill( lexer, &current ) == false )
                     {
-                        current++;
+                        current += Lexer_Illegal( lexer, current );
                     }
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                    break;
+                }
+
+                /*
+                 * After a refill, the run is scanned again from the start of
+                 * the token, as the buffer may have ended in the middle of a
+                 * UTF-8 sequence.
+                 */
+                do
+                {
+                    bool ascii;
+
+                    end     = lexer->text + Scan_Identifier( lexer->text, &ascii );
+                    current = ( ascii ) ? end : lexer->text + UTF8_ScanIdentifier( lexer->text, ( size_t )( end - lexer->text ) );
+                }
+                while( Input_Fill( lexer->input, &( lexer->text ), &end ) );
 
-                    Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
+                lexer->length = ( uintptr_t )current - ( uintptr_t )lexer->text;
 
-                    return TokenNumericOrID;
-            }
+                Debug( lexer, "Token: %1.*s", lexer->length, lexer->text );
+                Lexer_Decode( lexer, lexer->deferred == false );
+
+                return TokenNumericOrID;
         }
     }
 }
 
-void Lexer_Advance( void )
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
+/*
+ * Starts reading the token stream from its first token.
+ */
+static void Lexer_Rewind( LexerRef lexer )
 {
-    Lexer_Lookahead = ( int )( Lexer_Next() );
+    lexer->kinds    = TokenStream_GetKinds( lexer->stream );
+    lexer->offsets  = TokenStream_GetOffsets( lexer->stream );
+    lexer->lengths  = TokenStream_GetLengths( lexer->stream );
+    lexer->position = 0;
+    lexer->text     = NULL;
+    lexer->length   = 0;
 }
 
-bool Lexer_Match( Token token )
+/*
+ * Lexes the whole input up front into a token stream. From then on,
+ * Lexer_Next only reads the next entry of the stream, so scanning and
+ * parsing are separate passes.
+ * Messages are deferred while lexing, and tokens are printed as they are
+ * read, so the output is the same as without a token stream.
+ */
+bool Lexer_Tokenize( LexerRef lexer )
 {
-    if( Lexer_Lookahead == -1 )
+    Token  token;
+    bool   debug;
+    size_t tagged;
+
+    if( lexer->stream != NULL )
     {
-        Lexer_Advance();
+        return true;
     }
 
-    return ( int )token == Lexer_Lookahead;
-}
-
-bool Lexer_LegalLookahead( Token first, ... )
-{
-    va_list ap;
-    bool    ret;
+    if( ( lexer->stream = TokenStream_Create() ) == NULL )
+    {
+        return false;
+    }
 
-    va_start( ap, first );
+    debug  = lexer->debug;
+    tagged = 0;
 
-    ret = false;
+    lexer->debug    = false;
+    lexer->deferred = true;
 
-    if( first == TokenEnd )
+    do
     {
-        if( Lexer_Match( TokenEnd ) )
+        token  = Lexer_Scan( lexer );
+        tagged = Lexer_TagIllegal( lexer, tagged, TokenStream_GetCount( lexer->stream ) );
+
+        if( lexer->length > UINT32_MAX )
+        {
+            Error( lexer, "Input too large for a token stream" );
+            abort();
+        }
+
+        if( TokenStream_Append( lexer->stream, ( uint8_t )token, Lexer_GetSpan( lexer ).offset, ( uint32_t )lexer->length ) == false )
         {
-            ret = true;
+            Error( lexer, "Out of memory" );
+            abort();
         }
     }
-    else
+    while( token != TokenEnd );
+
+    lexer->debug    = debug;
+    lexer->deferred = false;
+
+    Lexer_Rewind( lexer );
+
+    return true;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * A part of the input lexed by Lexer_TokenizeParallel, from the start of a
+ * line up to the start of another one.
+ */
+typedef struct
+{
+    LexerRef       lexer;
+    TokenStreamRef stream;
+    const char *   begin;
+    const char *   end;
+    bool           failed;
+    pthread_t      thread;
+} LexerChunk;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Lexes a chunk into its own stream. The scanner may read past the end of
+ * the chunk, up to the next token, which is dropped, and doesn't report
+ * illegal input there, as the next chunk does.
+ * Illegal input at the end of the chunk is given the index of the first
+ * token of the next one.
+ */
+static void * Lexer_ScanChunk( void * arg )
+{
+    LexerChunk * chunk;
+    LexerRef     lexer;
+    Token        token;
+    size_t       tagged;
+
+    chunk  = arg;
+    lexer  = chunk->lexer;
+    tagged = 0;
+
+    while( true )
     {
-        Token   token;
-        Token   lookaheads[ 16 ];
-        Token * p;
-        Token * current;
-        bool    err;
+        token  = Lexer_Scan( lexer );
+        tagged = Lexer_TagIllegal( lexer, tagged, TokenStream_GetCount( chunk->stream ) );
 
-        err      = false;
-        p        = lookaheads;
-        *( p++ ) = first;
+        if( token == TokenEnd || lexer->text >= chunk->end )
+        {
+            break;
+        }
 
-        while( ( token = va_arg( ap, Token ) ) && p < &( lookaheads[ 16 ] ) )
+        if( lexer->length > UINT32_MAX )
         {
-            *( p++ ) = token;
+            Error( lexer, "Input too large for a token stream" );
+            abort();
         }
 
-        while( Lexer_Match( TokenSemicolon ) == false )
+        if( TokenStream_Append( chunk->stream, ( uint8_t )token, Lexer_GetSpan( lexer ).offset, ( uint32_t )lexer->length ) == false )
         {
-            for( current = lookaheads; current < p; current++ )
-            {
-                if( Lexer_Match( *( current ) ) )
-                {
-                    ret = true;
+            chunk->failed = true;
 
-                    goto done;
-                }
-            }
+            break;
+        }
+    }
 
-            if( err == false )
-            {
-                err = true;
+    return NULL;
+}
 
-                Error( "Syntax error" );
-            }
+/*
+ * Moves the illegal input recorded by a chunk's lexer to the lexer of the
+ * whole stream, where the chunk's tokens start at base. It is reported
+ * right away if it can't be moved.
+ */
+static void Lexer_MergeIllegal( LexerRef lexer, LexerRef chunk, size_t base )
+{
+    LexerIllegal * illegal;
+
+    if( chunk->illegalCount == 0 )
+    {
+        return;
+    }
 
-            Lexer_Advance();
+    if( ( illegal = realloc( lexer->illegal, ( lexer->illegalCount + chunk->illegalCount ) * sizeof( LexerIllegal ) ) ) == NULL )
+    {
+        for( size_t i = 0; i < chunk->illegalCount; i++ )
+        {
+            Lexer_Replay( lexer, chunk->illegal[ i ].offset, chunk->illegal[ i ].length );
         }
+
+        return;
     }
 
-done:
+    for( size_t i = 0; i < chunk->illegalCount; i++ )
+    {
+        illegal[ lexer->illegalCount ]        = chunk->illegal[ i ];
+        illegal[ lexer->illegalCount ].token += base;
+
+        lexer->illegalCount++;
+    }
 
-    va_end( ap );
+    lexer->illegal         = illegal;
+    lexer->illegalCapacity = lexer->illegalCount;
+}
+
+static bool Lexer_RunChunks( LexerChunk * chunks, size_t count, void * ( * func )( void * ) )
+{
+    size_t started;
+    bool   ret;
+
+    ret = true;
+
+    for( started = 0; started < count; started++ )
+    {
+        if( pthread_create( &( chunks[ started ].thread ), NULL, func, &( chunks[ started ] ) ) != 0 )
+        {
+            ret = false;
+
+            break;
+        }
+    }
+
+    for( size_t i = 0; i < started; i++ )
+    {
+        pthread_join( chunks[ i ].thread, NULL );
+    }
 
     return ret;
 }
+
+/*
+ * Same as Lexer_Tokenize, but splits a mapped input into chunks at line
+ * boundaries and lexes each one on its own thread. As no token spans two
+ * lines, the chunks are lexed independently, then their streams are
+ * concatenated. Tokens only carry offsets, so nothing needs fixing up,
+ * except the indices of the tokens following deferred illegal input.
+ */
+bool Lexer_TokenizeParallel( LexerRef lexer, size_t threads )
+{
+    LexerChunk * chunks;
+    const char * start;
+    size_t       size;
+    size_t       count;
+    bool         ret;
+
+    if( lexer->stream != NULL )
+    {
+        return true;
+    }
+
+    if( lexer->queue != NULL || lexer->text != NULL || Input_IsMapped( lexer->input ) == false )
+    {
+        return false;
+    }
+
+    start = Input_GetStart( lexer->input );
+    size  = Input_GetLength( lexer->input );
+    count = ( size / LEXER_CHUNK_MIN ) + 1;
+    count = ( threads < count ) ? threads : count;
+
+    if( count <= 1 )
+    {
+        return Lexer_Tokenize( lexer );
+    }
+
+    if( ( chunks = calloc( count, sizeof( LexerChunk ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        const char * end;
+
+        chunks[ i ].begin = ( i == 0 ) ? start : chunks[ i - 1 ].end;
+
+        if( i + 1 == count )
+        {
+            end = start + size;
+        }
+        else
+        {
+            end = start + ( size / count ) * ( i + 1 );
+            end = ( end < chunks[ i ].begin ) ? chunks[ i ].begin : end;
+            end = memchr( end, '\n', size - ( size_t )( end - start ) );
+            end = ( end == NULL ) ? start + size : end + 1;
+        }
+
+        chunks[ i ].end    = end;
+        chunks[ i ].stream = TokenStream_Create();
+        chunks[ i ].lexer  = Lexer_Create( lexer->input );
+
+        if( chunks[ i ].stream == NULL || chunks[ i ].lexer == NULL )
+        {
+            chunks[ i ].failed = true;
+        }
+    }
+
+    ret = true;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        ret = ret && chunks[ i ].failed == false;
+    }
+
+    if( ret )
+    {
+        for( size_t i = 0; i < count; i++ )
+        {
+            chunks[ i ].lexer->debug    = false;
+            chunks[ i ].lexer->deferred = true;
+            chunks[ i ].lexer->text     = ( char * )( uintptr_t )chunks[ i ].begin;
+            chunks[ i ].lexer->limit    = chunks[ i ].end;
+        }
+
+        ret = Lexer_RunChunks( chunks, count, Lexer_ScanChunk );
+    }
+
+    ret = ret && ( lexer->stream = TokenStream_Create() ) != NULL;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        size_t base;
+
+        base = ( ret ) ? TokenStream_GetCount( lexer->stream ) : 0;
+        ret  = ret && chunks[ i ].failed == false && TokenStream_AppendStream( lexer->stream, chunks[ i ].stream );
+
+        if( ret )
+        {
+            Lexer_MergeIllegal( lexer, chunks[ i ].lexer, base );
+        }
+
+        TokenStream_Release( chunks[ i ].stream );
+        Lexer_Release( chunks[ i ].lexer );
+    }
+
+    free( chunks );
+
+    ret = ret && TokenStream_Append( lexer->stream, ( uint8_t )TokenEnd, size, 0 );
+
+    if( ret == false )
+    {
+        TokenStream_Release( lexer->stream );
+
+        lexer->stream       = NULL;
+        lexer->illegalCount = 0;
+
+        return false;
+    }
+
+    Lexer_Rewind( lexer );
+
+    return true;
+}
+
+/*
+ * Reports the messages deferred for the tokens of the stream not read yet,
+ * before an edit changes them.
+ */
+static void Lexer_Flush( LexerRef lexer )
+{
+    size_t count;
+
+    count = TokenStream_GetCount( lexer->stream );
+
+    for( ; lexer->decoded < count; lexer->decoded++ )
+    {
+        while( lexer->illegalNext < lexer->illegalCount && lexer->illegal[ lexer->illegalNext ].token <= lexer->decoded )
+        {
+            Lexer_Replay( lexer, lexer->illegal[ lexer->illegalNext ].offset, lexer->illegal[ lexer->illegalNext ].length );
+
+            lexer->illegalNext++;
+        }
+
+        lexer->text   = Input_GetStart( lexer->input ) + lexer->offsets[ lexer->decoded ];
+        lexer->length = lexer->lengths[ lexer->decoded ];
+
+        Lexer_Decode( lexer, true );
+    }
+
+    lexer->illegalCount = 0;
+    lexer->illegalNext  = 0;
+}
+
+/*
+ * Index of the first token ending at or after an offset, which is the
+ * first one an edit there may change. The end token always qualifies.
+ */
+static size_t Lexer_FindToken( LexerRef lexer, size_t count, size_t offset, bool end )
+{
+    size_t low;
+    size_t high;
+
+    low  = 0;
+    high = count - 1;
+
+    while( low < high )
+    {
+        size_t middle;
+
+        middle = low + ( high - low ) / 2;
+
+        if( lexer->offsets[ middle ] + ( ( end ) ? lexer->lengths[ middle ] : 0 ) < offset )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * Replaces removed bytes at offset in the input of a tokenized lexer with
+ * length bytes of text, and updates the token stream to match.
+ * Lexing restarts after the last token ending before the edit, and stops
+ * at the first token past the edit which starts where an old token does,
+ * once shifted: the input is the same from there, and so are the tokens,
+ * which are kept and only get their offsets shifted.
+ * The stream is then read again from its first token. If it can't be
+ * updated, it is dropped, and Lexer_Tokenize lexes the whole input again.
+ * Messages deferred for tokens not read yet are reported first, and the
+ * tokens lexed again report theirs right away.
+ */
+bool Lexer_Edit( LexerRef lexer, size_t offset, size_t removed, const char * text, size_t length )
+{
+    TokenStreamRef tokens;
+    size_t         count;
+    size_t         first;
+    size_t         last;
+    size_t         restart;
+    int64_t        shift;
+    bool           debug;
+    bool           ret;
+    Token          token;
+
+    if( lexer->stream == NULL || lexer->queue != NULL )
+    {
+        return false;
+    }
+
+    if( ( tokens = TokenStream_Create() ) == NULL )
+    {
+        return false;
+    }
+
+    Lexer_Flush( lexer );
+
+    if( Input_Edit( lexer->input, offset, removed, text, length ) == false )
+    {
+        TokenStream_Release( tokens );
+
+        return false;
+    }
+
+    count   = TokenStream_GetCount( lexer->stream );
+    first   = Lexer_FindToken( lexer, count, offset, true );
+    last    = Lexer_FindToken( lexer, count, offset + removed, false );
+    restart = ( first == 0 ) ? 0 : lexer->offsets[ first - 1 ] + lexer->lengths[ first - 1 ];
+    shift   = ( int64_t )length - ( int64_t )removed;
+    debug   = lexer->debug;
+    ret     = true;
+
+    lexer->debug  = false;
+    lexer->text   = Input_GetStart( lexer->input ) + restart;
+    lexer->length = 0;
+
+    while( true )
+    {
+        size_t start;
+
+        token = Lexer_Scan( lexer );
+        start = Input_GetOffset( lexer->input, lexer->text );
+
+        if( start >= offset + length )
+        {
+            while( last < count && ( int64_t )( lexer->offsets[ last ] ) + shift < ( int64_t )start )
+            {
+                last++;
+            }
+
+            if( last < count && ( int64_t )( lexer->offsets[ last ] ) + shift == ( int64_t )start )
+            {
+                break;
+            }
+        }
+
+        if( lexer->length > UINT32_MAX )
+        {
+            Error( lexer, "Input too large for a token stream" );
+            abort();
+        }
+
+        if( TokenStream_Append( tokens, ( uint8_t )token, start, ( uint32_t )lexer->length ) == false )
+        {
+            ret = false;
+
+            break;
+        }
+
+        if( token == TokenEnd )
+        {
+            last = count;
+
+            break;
+        }
+    }
+
+    ret = ret && TokenStream_Splice( lexer->stream, first, last - first, tokens, shift );
+
+    TokenStream_Release( tokens );
+
+    lexer->debug = debug;
+
+    if( ret == false )
+    {
+        TokenStream_Release( lexer->stream );
+
+        lexer->stream  = NULL;
+        lexer->text    = NULL;
+        lexer->length  = 0;
+        lexer->decoded = 0;
+
+        return false;
+    }
+
+    lexer->decoded = TokenStream_GetCount( lexer->stream );
+
+    Lexer_Rewind( lexer );
+
+    return true;
+}
+
+/*
+ * Runs on the lexer thread, scanning the input with a lexer of its own and
+ * pushing the tokens into the queue, up to the end of input.
+ * Illegal input is queued as well, ahead of the token following it, so it
+ * is reported on the calling thread in the order of the input.
+ */
+static void * Lexer_Produce( void * arg )
+{
+    LexerRef lexer;
+    LexerRef scanner;
+    Token    token;
+
+    lexer   = arg;
+    scanner = lexer->scanner;
+
+    do
+    {
+        size_t i;
+
+        token = Lexer_Scan( scanner );
+
+        if( scanner->length > UINT32_MAX )
+        {
+            Error( scanner, "Input too large for a token queue" );
+            abort();
+        }
+
+        for( i = 0; i < scanner->illegalCount; i++ )
+        {
+            if( TokenQueue_Push( lexer->queue, LEXER_ILLEGAL, scanner->illegal[ i ].offset, scanner->illegal[ i ].length ) == false )
+            {
+                break;
+            }
+        }
+
+        scanner->illegalCount = 0;
+
+        if( TokenQueue_Push( lexer->queue, ( uint8_t )token, Lexer_GetSpan( scanner ).offset, ( uint32_t )scanner->length ) == false )
+        {
+            break;
+        }
+    }
+    while( token != TokenEnd );
+
+    TokenQueue_Flush( lexer->queue );
+
+    return NULL;
+}
+
+/*
+ * Scans the input on a separate thread, while Lexer_Next reads the tokens
+ * from a queue on the calling thread, so scanning and parsing overlap.
+ * The input must be mapped, as a streamed input moves when it is refilled.
+ * Tokens and lexer messages are still printed by Lexer_Next, on the
+ * calling thread, so the output is the same.
+ */
+bool Lexer_StartPipeline( LexerRef lexer )
+{
+    if( lexer->queue != NULL )
+    {
+        return true;
+    }
+
+    if( lexer->stream != NULL || lexer->text != NULL || Input_IsMapped( lexer->input ) == false )
+    {
+        return false;
+    }
+
+    if( ( lexer->scanner = Lexer_Create( lexer->input ) ) == NULL )
+    {
+        return false;
+    }
+
+    lexer->scanner->debug    = false;
+    lexer->scanner->deferred = true;
+
+    if( ( lexer->queue = TokenQueue_Create() ) == NULL )
+    {
+        Lexer_Release( lexer->scanner );
+
+        lexer->scanner = NULL;
+
+        return false;
+    }
+
+    if( pthread_create( &( lexer->thread ), NULL, Lexer_Produce, lexer ) != 0 )
+    {
+        TokenQueue_Release( lexer->queue );
+        Lexer_Release( lexer->scanner );
+
+        lexer->queue   = NULL;
+        lexer->scanner = NULL;
+
+        return false;
+    }
+
+    return true;
+}
+
+static Token Lexer_NextQueued( LexerRef lexer )
+{
+    uint8_t  kind;
+    uint64_t offset;
+    uint32_t length;
+
+    if( lexer->ended )
+    {
+        return TokenEnd;
+    }
+
+    TokenQueue_Pop( lexer->queue, &kind, &offset, &length );
+
+    while( kind == LEXER_ILLEGAL )
+    {
+        Lexer_Replay( lexer, offset, length );
+        TokenQueue_Pop( lexer->queue, &kind, &offset, &length );
+    }
+
+    lexer->text   = Input_GetStart( lexer->input ) + offset;
+    lexer->length = length;
+
+    if( kind == TokenEnd )
+    {
+        lexer->ended = true;
+    }
+    else
+    {
+        Debug( lexer, "Token: %1.*s", ( int )( lexer->length ), lexer->text );
+    }
+
+    Lexer_Decode( lexer, true );
+
+    return ( Token )kind;
+}
+
+Token Lexer_Next( LexerRef lexer )
+{
+    size_t i;
+
+    if( lexer->queue != NULL )
+    {
+        return Lexer_NextQueued( lexer );
+    }
+
+    if( lexer->stream == NULL )
+    {
+        if( lexer->end != NULL && lexer->text + lexer->length >= lexer->end )
+        {
+            lexer->text   = ( char * )( uintptr_t )( lexer->end );
+            lexer->length = 0;
+            lexer->value  = 0;
+
+            return TokenEnd;
+        }
+
+        return Lexer_Scan( lexer );
+    }
+
+    i = lexer->position;
+
+    if( i + 1 < TokenStream_GetCount( lexer->stream ) )
+    {
+        lexer->position++;
+    }
+
+    while( lexer->illegalNext < lexer->illegalCount && lexer->illegal[ lexer->illegalNext ].token <= i )
+    {
+        Lexer_Replay( lexer, lexer->illegal[ lexer->illegalNext ].offset, lexer->illegal[ lexer->illegalNext ].length );
+
+        lexer->illegalNext++;
+    }
+
+    lexer->text   = Input_GetStart( lexer->input ) + lexer->offsets[ i ];
+    lexer->length = lexer->lengths[ i ];
+
+    if( lexer->debug && lexer->kinds[ i ] != TokenEnd )
+    {
+        Debug( lexer, "Token: %1.*s", ( int )( lexer->length ), lexer->text );
+    }
+
+    Lexer_Decode( lexer, i >= lexer->decoded );
+
+    lexer->decoded = ( i >= lexer->decoded ) ? i + 1 : lexer->decoded;
+
+    return ( Token )( lexer->kinds[ i ] );
+}
+
+void Lexer_Advance( LexerRef lexer )
+{
+    lexer->lookahead = ( int )( Lexer_Next( lexer ) );
+}
+
+/*
+ * Returns the current token, reading the first one if needed.
+ */
+Token Lexer_GetLookahead( LexerRef lexer )
+{
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    return ( Token )lexer->lookahead;
+}
+
+bool Lexer_Match( LexerRef lexer, Token token )
+{
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    return ( int )token == lexer->lookahead;
+}
+
+/*
+ * Variadic form of Lexer_LegalLookaheadSet, taking a list of tokens
+ * terminated by TokenEnd.
+ */
+bool Lexer_LegalLookahead( LexerRef lexer, Token first, ... )
+{
+    va_list  ap;
+    TokenSet set;
+    Token    token;
+
+    if( first == TokenEnd )
+    {
+        return Lexer_Match( lexer, TokenEnd );
+    }
+
+    va_start( ap, first );
+
+    set = TOKEN_SET( first );
+
+    while( ( token = va_arg( ap, Token ) ) != TokenEnd )
+    {
+        set |= TOKEN_SET( token );
+    }
+
+    va_end( ap );
+
+    return Lexer_LegalLookaheadSet( lexer, set );
+}
+
+/*
+ * Skips tokens until the lookahead is in the set, reporting a syntax error
+ * once if any token had to be skipped.
+ * Returns false if a semicolon or the end of input is reached first.
+ */
+bool Lexer_LegalLookaheadSet( LexerRef lexer, TokenSet set )
+{
+    bool err;
+
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    err = false;
+
+    while( ( TOKEN_SET( lexer->lookahead ) & set ) == 0 )
+    {
+        if( ( TOKEN_SET( lexer->lookahead ) & ( TOKEN_SET( TokenSemicolon ) | TOKEN_SET( TokenEnd ) ) ) != 0 )
+        {
+            return false;
+        }
+
+        if( err == false )
+        {
+            err = true;
+
+            Error( lexer, "Syntax error" );
+        }
+
+        Lexer_Advance( lexer );
+    }
+
+    return true;
+}
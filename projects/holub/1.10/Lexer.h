@@ -33,26 +33,67 @@
 #define LEXER_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include "Tokens.h"
+#include "Input.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd              = 0, /* End of input */
-    TokenSemicolon        = 1, /* ; */
-    TokenAdd              = 2, /* + */
-    TokenMultiply         = 3, /* * */
-    TokenLeftParenthesis  = 4, /* ( */
-    TokenRightParenthesis = 5, /* ) */
-    TokenNumericOrID      = 6  /* Decimal number or identifier */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
-const char * Lexer_GetText( void );
-size_t       Lexer_GetLength( void );
-size_t       Lexer_GetLine( void );
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
+/*
+ * A set of tokens, with one bit per token, so that checking the lookahead
+ * against a FIRST set is a single AND.
+ */
+typedef uint32_t TokenSet;
+
+#define TOKEN_SET( token ) ( ( TokenSet )1 << ( unsigned int )( token ) )
+
+_Static_assert( TokenCount <= sizeof( TokenSet ) * 8, "Too many tokens for a TokenSet" );
+
+/*
+ * Expands a list of tokens from Tokens.h, such as FIRST_EXPRESSION, into
+ * a constant TokenSet.
+ */
+#define TOKEN_SET_MEMBER( token ) | TOKEN_SET( token )
+#define TOKEN_SET_OF( LIST )      ( ( TokenSet )0 LIST( TOKEN_SET_MEMBER ) )
+
+typedef struct Lexer * LexerRef;
+
+LexerRef Lexer_Create( InputRef input );
+LexerRef Lexer_CreateWithSpan( InputRef input, Span span );
+LexerRef Lexer_Retain( LexerRef lexer );
+void     Lexer_Release( LexerRef lexer );
+InputRef Lexer_GetInput( LexerRef lexer );
+bool     Lexer_IsDebug( LexerRef lexer );
+void     Lexer_SetDebug( LexerRef lexer, bool value );
+
+const char * Lexer_GetText( LexerRef lexer );
+size_t       Lexer_GetLength( LexerRef lexer );
+uint64_t     Lexer_GetValue( LexerRef lexer );
+Span         Lexer_GetSpan( LexerRef lexer );
+void         Lexer_GetLocation( LexerRef lexer, size_t * line, size_t * column );
 
-Token Lexer_Next( void );
-void  Lexer_Advance( void );
-bool  Lexer_Match( Token token );
-bool  Lexer_LegalLookahead( Token first, ... );
+bool  Lexer_Tokenize( LexerRef lexer );
+bool  Lexer_TokenizeParallel( LexerRef lexer, size_t threads );
+bool  Lexer_Edit( LexerRef lexer, size_t offset, size_t removed, const char * text, size_t length );
+bool  Lexer_StartPipeline( LexerRef lexer );
+Token Lexer_Next( LexerRef lexer );
+void  Lexer_Advance( LexerRef lexer );
+bool  Lexer_Match( LexerRef lexer, Token token );
+Token Lexer_GetLookahead( LexerRef lexer );
+bool  Lexer_LegalLookahead( LexerRef lexer, Token first, ... );
+bool  Lexer_LegalLookaheadSet( LexerRef lexer, TokenSet set );
 
 #endif /* LEXER_H */
@@ -33,29 +33,33 @@
 #include "Print.h"
 #include <stdlib.h>
 
-static const char *  Name_Names[] = { "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7" };
-static const char ** Name_Current = Name_Names;
+/*
+ * The pool is per thread, so compilations running on separate threads
+ * never hand out the same temporary.
+ */
+static _Thread_local const char * Name_Names[] = { "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7" };
+static _Thread_local size_t       Name_Current = 0;
 
 const char * Name_NewName( void )
 {
-    if( Name_Current >= &( Name_Names[ sizeof( Name_Names ) / sizeof( *( Name_Names ) ) ] ) )
+    if( Name_Current >= sizeof( Name_Names ) / sizeof( *( Name_Names ) ) )
     {
-        Error( "Expression too complex" );
+        Error( NULL, "Expression too complex" );
         abort();
     }
 
-    return *( Name_Current++ );
+    return Name_Names[ Name_Current++ ];
 }
 
 void Name_FreeName( const char * name )
 {
-    if( Name_Current > Name_Names )
+    if( Name_Current > 0 )
     {
-        *( --Name_Current ) = name;
+        Name_Names[ --Name_Current ] = name;
     }
     else
     {
-        Error( "Name stack underflow" );
+        Error( NULL, "Name stack underflow" );
         abort();
     }
 }
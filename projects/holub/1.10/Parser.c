@@ -34,107 +34,548 @@
 #include "Print.h"
 #include "Name.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * Smallest run of statements Parser_StatementsParallel compiles at once,
+ * and number of runs per thread that may wait to be printed.
+ */
+#define PARSER_BLOCK_MIN ( 256 * 1024 )
+#define PARSER_WINDOW    4
+
+/*
+ * FIRST( expression ) = FIRST( term ) = FIRST( factor )
+ */
+static const TokenSet Parser_First = TOKEN_SET_OF( FIRST_EXPRESSION );
 
 /*
  * statements -> expression SEMICOLON | expression SEMI statements
  */
-void Parser_Statements( void )
+void Parser_Statements( LexerRef lexer )
 {
-    while( Lexer_Match( TokenEnd ) == false )
+    while( Lexer_Match( lexer, TokenEnd ) == false )
     {
         const char * tmp;
 
-        Parser_Expression( tmp = Name_NewName() );
+        Parser_Expression( lexer, tmp = Name_NewName() );
         Name_FreeName( tmp );
 
-        if( Lexer_Match( TokenSemicolon ) )
+        if( Lexer_Match( lexer, TokenSemicolon ) )
         {
-            Lexer_Advance();
+            Lexer_Advance( lexer );
         }
         else
         {
-            Warning( "Inserting missing semicolon" );
+            Warning( lexer, "Inserting missing semicolon" );
         }
     }
 }
 
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
 /*
- * expression  -> term expression'
- * expression' -> ADD term expression' | epsilon
+ * A run of whole statements compiled by Parser_StatementsParallel, with
+ * the messages recorded while compiling it.
  */
-void Parser_Expression( const char * tmp )
+typedef struct
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
-    {
-        return;
-    }
+    Span   span;
+    char * messages;
+    size_t size;
+    bool   done;
+    bool   failed;
+} ParserBlock;
+
+/*
+ * Blocks are handed to the workers in order, but only up to a window past
+ * the first one not printed yet, so blocks compiled ahead don't pile up
+ * in memory while waiting to be printed.
+ */
+typedef struct
+{
+    InputRef        input;
+    bool            debug;
+    ParserBlock *   blocks;
+    size_t          count;
+    size_t          next;
+    size_t          printed;
+    size_t          window;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+} ParserQueue;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Splits the input into blocks of at least PARSER_BLOCK_MIN bytes, ending
+ * just after a semicolon, or at the end of input. Semicolons within
+ * parentheses end blocks too: the expression parser stops at any
+ * semicolon, even on a syntax error, and only Parser_Statements consumes
+ * it, so a statement always ends there, and each block parses the same
+ * as within the whole input. One unbalanced parenthesis then doesn't
+ * keep the rest of the input in a single block. Returns the number of
+ * blocks, which is at most size / PARSER_BLOCK_MIN + 1.
+ */
+static size_t Parser_FindBlocks( const char * text, size_t size, ParserBlock * blocks )
+{
+    size_t count;
+    size_t start;
 
-    Parser_Term( tmp );
+    count = 0;
+    start = 0;
 
-    while( Lexer_Match( TokenAdd ) )
+    for( size_t i = 0; i < size; i++ )
     {
-        const char * tmp2;
+        if( text[ i ] == ';' && i + 1 - start >= PARSER_BLOCK_MIN )
+        {
+            blocks[ count ].span.offset = start;
+            blocks[ count ].span.length = i + 1 - start;
+            start                       = i + 1;
+
+            count++;
+        }
+    }
 
-        Lexer_Advance();
-        Parser_Term( tmp2 = Name_NewName() );
-        Debug( "%s += %s", tmp, tmp2 );
-        Name_FreeName( tmp2 );
+    if( start < size || count == 0 )
+    {
+        blocks[ count ].span.offset   = start;
+        blocks[ count++ ].span.length = size - start;
     }
+
+    return count;
 }
 
 /*
- * term  -> factor term'
- * term' -> MULTIPLY factor term' | epsilon
+ * Compiles a block with a lexer of its own, recording its messages.
+ * The temporary names come from the pool of the worker thread.
  */
-void Parser_Term( const char * tmp )
+static void Parser_Compile( ParserQueue * queue, ParserBlock * block )
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    FILE *   fh;
+    LexerRef lexer;
+
+    if( ( fh = open_memstream( &( block->messages ), &( block->size ) ) ) == NULL )
     {
+        block->failed = true;
+
         return;
     }
 
-    Parser_Factor( tmp );
+    if( ( lexer = Lexer_CreateWithSpan( queue->input, block->span ) ) == NULL )
+    {
+        block->failed = true;
+    }
+    else
+    {
+        Lexer_SetDebug( lexer, queue->debug );
+        Print_Capture( fh );
+        Parser_Statements( lexer );
+        Print_Capture( NULL );
+        Lexer_Release( lexer );
+    }
+
+    if( fclose( fh ) != 0 )
+    {
+        block->failed = true;
+    }
+}
+
+static void * Parser_Work( void * arg )
+{
+    ParserQueue * queue;
+    ParserBlock * block;
 
-    while( Lexer_Match( TokenMultiply ) )
+    queue = arg;
+
+    while( true )
     {
-        const char * tmp2;
+        pthread_mutex_lock( &( queue->lock ) );
 
-        Lexer_Advance();
-        Parser_Factor( tmp2 = Name_NewName() );
-        Debug( "%s *= %s", tmp, tmp2 );
-        Name_FreeName( tmp2 );
+        while( queue->next < queue->count && queue->next >= queue->printed + queue->window )
+        {
+            pthread_cond_wait( &( queue->cond ), &( queue->lock ) );
+        }
+
+        block = ( queue->next < queue->count ) ? &( queue->blocks[ queue->next++ ] ) : NULL;
+
+        pthread_mutex_unlock( &( queue->lock ) );
+
+        if( block == NULL )
+        {
+            break;
+        }
+
+        Parser_Compile( queue, block );
+        pthread_mutex_lock( &( queue->lock ) );
+
+        block->done = true;
+
+        pthread_cond_broadcast( &( queue->cond ) );
+        pthread_mutex_unlock( &( queue->lock ) );
     }
+
+    return NULL;
 }
 
-/* factor -> NUMERIC_OR_ID | LEFT_PARENTHESIS expression RIGHT_PARENTHESIS */
-void Parser_Factor( const char * tmp )
+/*
+ * Same as Parser_Statements, but compiles runs of statements on separate
+ * threads, found by a quick scan of a mapped input for semicolons outside
+ * of parentheses. The calling thread prints the messages of each run as
+ * soon as the runs before it are printed, so the output is in source
+ * order, and the same as with Parser_Statements.
+ * The lexer must not have read anything yet, and is only used for its
+ * input and debug setting.
+ */
+bool Parser_StatementsParallel( LexerRef lexer, size_t threads )
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    ParserQueue queue;
+    pthread_t * workers;
+    size_t      started;
+    bool        ret;
+
+    queue.input = Lexer_GetInput( lexer );
+
+    if( Input_IsMapped( queue.input ) == false )
     {
-        return;
+        return false;
     }
 
-    if( Lexer_Match( TokenNumericOrID ) )
+    if( threads <= 1 || Input_GetLength( queue.input ) < PARSER_BLOCK_MIN * 2 )
     {
-        Debug( "%s = %1.*s", tmp, Lexer_GetLength(), Lexer_GetText() );
-        Lexer_Advance();
+        Parser_Statements( lexer );
+
+        return true;
     }
-    else if( Lexer_Match( TokenLeftParenthesis ) )
+
+    queue.blocks = calloc( Input_GetLength( queue.input ) / PARSER_BLOCK_MIN + 1, sizeof( ParserBlock ) );
+    workers      = calloc( threads, sizeof( pthread_t ) );
+
+    if( queue.blocks == NULL || workers == NULL || pthread_mutex_init( &( queue.lock ), NULL ) != 0 )
     {
-        Lexer_Advance();
-        Parser_Expression( tmp );
+        free( queue.blocks );
+        free( workers );
 
-        if( Lexer_Match( TokenRightParenthesis ) )
+        return false;
+    }
+
+    if( pthread_cond_init( &( queue.cond ), NULL ) != 0 )
+    {
+        pthread_mutex_destroy( &( queue.lock ) );
+        free( queue.blocks );
+        free( workers );
+
+        return false;
+    }
+
+    queue.debug   = Lexer_IsDebug( lexer );
+    queue.count   = Parser_FindBlocks( Input_GetStart( queue.input ), Input_GetLength( queue.input ), queue.blocks );
+    queue.next    = 0;
+    queue.printed = 0;
+    queue.window  = threads * PARSER_WINDOW;
+    threads       = ( threads < queue.count ) ? threads : queue.count;
+    ret           = true;
+
+    for( started = 0; started < threads; started++ )
+    {
+        if( pthread_create( &( workers[ started ] ), NULL, Parser_Work, &queue ) != 0 )
         {
-            Lexer_Advance();
+            break;
         }
-        else
+    }
+
+    /*
+     * Without any worker, nothing is printed, and the input isn't compiled.
+     */
+    if( started == 0 )
+    {
+        queue.count = 0;
+        ret         = false;
+    }
+
+    for( size_t i = 0; i < queue.count; i++ )
+    {
+        ParserBlock * block;
+
+        block = &( queue.blocks[ i ] );
+
+        pthread_mutex_lock( &( queue.lock ) );
+
+        while( block->done == false )
         {
-            Error( "Mismatch parenthesis" );
+            pthread_cond_wait( &( queue.cond ), &( queue.lock ) );
         }
+
+        pthread_mutex_unlock( &( queue.lock ) );
+
+        if( block->failed )
+        {
+            ret = false;
+        }
+        else if( ret )
+        {
+            Print_Replay( block->messages, block->size );
+        }
+
+        free( block->messages );
+        pthread_mutex_lock( &( queue.lock ) );
+
+        queue.printed++;
+
+        pthread_cond_broadcast( &( queue.cond ) );
+        pthread_mutex_unlock( &( queue.lock ) );
     }
-    else
+
+    for( size_t i = 0; i < started; i++ )
+    {
+        pthread_join( workers[ i ], NULL );
+    }
+
+    pthread_cond_destroy( &( queue.cond ) );
+    pthread_mutex_destroy( &( queue.lock ) );
+    free( queue.blocks );
+    free( workers );
+
+    if( ret == false )
+    {
+        Error( NULL, "Cannot compile the statements in parallel" );
+    }
+
+    return ret;
+}
+
+/*
+ * An expression being parsed, either the whole one or one between
+ * parentheses, with its pending operands: add is the temporary of the term
+ * being added to it, and mul the temporary of the factor the current term
+ * is being multiplied by.
+ */
+typedef struct
+{
+    const char * tmp;
+    const char * add;
+    const char * mul;
+} ParserFrame;
+
+typedef enum
+{
+    ParserStateExpression,
+    ParserStateFactor,
+    ParserStateTermTail,
+    ParserStateExpressionTail
+} ParserState;
+
+/*
+ * Frames kept on the C stack before spilling to the heap.
+ */
+#define PARSER_FRAMES 32
+
+/*
+ * Largest frame array moved to the heap, until Parser_GetHeapPeak reads
+ * it. Frames grow on all the threads of Parser_StatementsParallel.
+ */
+static size_t          Parser_HeapPeak = 0;
+static pthread_mutex_t Parser_HeapLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Size in bytes of the largest frame array Parser_Expression moved to the
+ * heap since the last call, for expressions nested too deep for its C
+ * stack.
+ */
+size_t Parser_GetHeapPeak( void )
+{
+    size_t peak;
+
+    pthread_mutex_lock( &Parser_HeapLock );
+
+    peak            = Parser_HeapPeak;
+    Parser_HeapPeak = 0;
+
+    pthread_mutex_unlock( &Parser_HeapLock );
+
+    return peak;
+}
+
+/*
+ * expression  -> term expression'
+ * expression' -> ADD term expression' | epsilon
+ * term        -> factor term'
+ * term'       -> MULTIPLY factor term' | epsilon
+ * factor      -> NUMERIC_OR_ID | LEFT_PARENTHESIS expression RIGHT_PARENTHESIS
+ *
+ * The grammar is parsed without recursion, with one frame per level of
+ * parentheses on an explicit stack, so nesting is only bounded by memory.
+ * The states stand for the points the recursive descent would be at:
+ *
+ *     ParserStateExpression       Starting an expression
+ *     ParserStateFactor           Starting a factor
+ *     ParserStateTermTail         After a factor, in term'
+ *     ParserStateExpressionTail   After a term, in expression'
+ *
+ * Lookahead checks and the generated code are the same as with recursive
+ * functions, including after syntax errors.
+ */
+void Parser_Expression( LexerRef lexer, const char * tmp )
+{
+    ParserFrame   inlineFrames[ PARSER_FRAMES ];
+    ParserFrame * frames;
+    ParserFrame * frame;
+    size_t        count;
+    size_t        capacity;
+    ParserState   state;
+
+    frames   = inlineFrames;
+    capacity = PARSER_FRAMES;
+    count    = 1;
+    frame    = frames;
+    state    = ParserStateExpression;
+
+    frame->tmp = tmp;
+    frame->add = NULL;
+    frame->mul = NULL;
+
+    while( true )
     {
-        Error( "Number or identifier expected" );
+        const char * target;
+
+        if( state == ParserStateExpression )
+        {
+            state = ( Lexer_LegalLookaheadSet( lexer, Parser_First ) ) ? ParserStateFactor : ParserStateExpressionTail;
+        }
+        else if( state == ParserStateFactor )
+        {
+            target = ( frame->mul != NULL ) ? frame->mul : ( ( frame->add != NULL ) ? frame->add : frame->tmp );
+
+            if( Lexer_Match( lexer, TokenNumericOrID ) )
+            {
+                Debug( lexer, "%s = %1.*s", target, Lexer_GetLength( lexer ), Lexer_GetText( lexer ) );
+                Lexer_Advance( lexer );
+
+                state = ParserStateTermTail;
+
+                continue;
+            }
+
+            if( Lexer_Match( lexer, TokenLeftParenthesis ) == false )
+            {
+                Error( lexer, "Number or identifier expected" );
+
+                state = ParserStateTermTail;
+
+                continue;
+            }
+
+            Lexer_Advance( lexer );
+
+            if( count == capacity )
+            {
+                ParserFrame * grown;
+
+                grown = malloc( capacity * 2 * sizeof( ParserFrame ) );
+
+                if( grown == NULL )
+                {
+                    Error( lexer, "Out of memory" );
+                    abort();
+                }
+
+                memcpy( grown, frames, count * sizeof( ParserFrame ) );
+
+                if( frames != inlineFrames )
+                {
+                    free( frames );
+                }
+
+                frames    = grown;
+                capacity *= 2;
+
+                pthread_mutex_lock( &Parser_HeapLock );
+
+                if( capacity * sizeof( ParserFrame ) > Parser_HeapPeak )
+                {
+                    Parser_HeapPeak = capacity * sizeof( ParserFrame );
+                }
+
+                pthread_mutex_unlock( &Parser_HeapLock );
+            }
+
+            frame      = &( frames[ count++ ] );
+            frame->tmp = target;
+            frame->add = NULL;
+            frame->mul = NULL;
+            state      = ParserStateExpression;
+        }
+        else if( state == ParserStateTermTail )
+        {
+            target = ( frame->add != NULL ) ? frame->add : frame->tmp;
+
+            if( frame->mul != NULL )
+            {
+                Debug( lexer, "%s *= %s", target, frame->mul );
+                Name_FreeName( frame->mul );
+
+                frame->mul = NULL;
+            }
+
+            if( Lexer_Match( lexer, TokenMultiply ) )
+            {
+                Lexer_Advance( lexer );
+
+                frame->mul = Name_NewName();
+                state      = ( Lexer_LegalLookaheadSet( lexer, Parser_First ) ) ? ParserStateFactor : ParserStateTermTail;
+            }
+            else
+            {
+                state = ParserStateExpressionTail;
+            }
+        }
+        else if( state == ParserStateExpressionTail )
+        {
+            if( frame->add != NULL )
+            {
+                Debug( lexer, "%s += %s", frame->tmp, frame->add );
+                Name_FreeName( frame->add );
+
+                frame->add = NULL;
+            }
+
+            if( Lexer_Match( lexer, TokenAdd ) )
+            {
+                Lexer_Advance( lexer );
+
+                frame->add = Name_NewName();
+                state      = ( Lexer_LegalLookaheadSet( lexer, Parser_First ) ) ? ParserStateFactor : ParserStateExpressionTail;
+
+                continue;
+            }
+
+            if( --count == 0 )
+            {
+                if( frames != inlineFrames )
+                {
+                    free( frames );
+                }
+
+                return;
+            }
+
+            frame = &( frames[ count - 1 ] );
+            state = ParserStateTermTail;
+
+            if( Lexer_Match( lexer, TokenRightParenthesis ) )
+            {
+                Lexer_Advance( lexer );
+            }
+            else
+            {
+                Error( lexer, "Mismatch parenthesis" );
+            }
+        }
     }
 }
@@ -32,9 +32,21 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-void Parser_Statements( void );
-void Parser_Expression( const char * tmp );
-void Parser_Term( const char * tmp );
-void Parser_Factor( const char * tmp );
+#include "Lexer.h"
+
+/*
+ * Value of a symbol of LALR.y: the text of a token, or the temporary
+ * holding the value of an expression.
+ */
+typedef struct
+{
+    Span         span;
+    const char * name;
+} ParserValue;
+
+void   Parser_Statements( LexerRef lexer );
+bool   Parser_StatementsParallel( LexerRef lexer, size_t threads );
+void   Parser_Expression( LexerRef lexer, const char * tmp );
+size_t Parser_GetHeapPeak( void );
 
 #endif /* PARSER_H */
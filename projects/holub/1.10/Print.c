@@ -33,47 +33,140 @@
 #include "Lexer.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
+
+/*
+ * Stream the messages of the calling thread are recorded into, if any,
+ * set by Print_Capture.
+ */
+static _Thread_local FILE * Print_Captured = NULL;
 
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
 #endif
 
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap );
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap )
+/*
+ * The stream is locked for the whole message, so messages from lexers
+ * running on different threads are never interleaved.
+ * Messages not tied to a lexer, like I/O errors, have no location, and
+ * are never captured, as they aren't part of the output of a statement.
+ * A captured message is recorded as a letter telling the stream it is
+ * meant for, then its text, terminated by a NUL byte, which a message
+ * can't contain.
+ */
+void Print( FILE * fh, LexerRef lexer, const char * level, const char * fmt, va_list ap );
+void Print( FILE * fh, LexerRef lexer, const char * level, const char * fmt, va_list ap )
 {
-    fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, Lexer_GetLine() );
+    size_t line;
+    size_t column;
+
+    if( lexer != NULL )
+    {
+        Lexer_GetLocation( lexer, &line, &column );
+
+        if( Print_Captured != NULL )
+        {
+            fputc( ( fh == stderr ) ? 'E' : 'O', Print_Captured );
+
+            fh = Print_Captured;
+        }
+    }
+
+    flockfile( fh );
+
+    if( lexer == NULL )
+    {
+        fprintf( fh, "*** [ %s ]> ", level );
+    }
+    else
+    {
+        fprintf( fh, "*** [ %s ]> [ #%zu:%zu ]> ", level, line, column );
+    }
+
     vfprintf( fh, fmt, ap );
     fprintf( fh, "\n" );
+
+    if( fh == Print_Captured )
+    {
+        fputc( 0, fh );
+    }
+
+    funlockfile( fh );
 }
 
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
 
-void Error( const char * fmt, ... )
+/*
+ * Records the messages of the calling thread into a stream instead of
+ * printing them, until called again with NULL. Print_Replay prints them.
+ */
+void Print_Capture( FILE * fh )
+{
+    Print_Captured = fh;
+}
+
+/*
+ * Prints messages recorded by Print_Capture to the streams they were
+ * meant for, in the order they were recorded. stdout is flushed before
+ * an error or warning, so they stay in order even if it is buffered.
+ */
+void Print_Replay( const char * messages, size_t size )
+{
+    const char * end;
+
+    end = messages + size;
+
+    while( messages < end )
+    {
+        size_t length;
+
+        length = strnlen( messages + 1, ( size_t )( end - messages ) - 1 );
+
+        if( messages[ 0 ] == 'E' )
+        {
+            fflush( stdout );
+            fwrite( messages + 1, 1, length, stderr );
+        }
+        else
+        {
+            fwrite( messages + 1, 1, length, stdout );
+        }
+
+        messages += length + 2;
+    }
+}
+
+void Error( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "ERROR", fmt, ap );
+    Print( stderr, lexer, "ERROR", fmt, ap );
     va_end( ap );
 }
 
-void Warning( const char * fmt, ... )
+void Warning( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "WARNING", fmt, ap );
+    Print( stderr, lexer, "WARNING", fmt, ap );
     va_end( ap );
 }
 
-void Debug( const char * fmt, ... )
+void Debug( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
+    if( lexer != NULL && Lexer_IsDebug( lexer ) == false )
+    {
+        return;
+    }
+
     va_start( ap, fmt );
-    Print( stdout, "DEBUG", fmt, ap );
+    Print( stdout, lexer, "DEBUG", fmt, ap );
     va_end( ap );
 }
@@ -32,8 +32,13 @@
 #ifndef PRINT_H
 #define PRINT_H
 
-void Error( const char * fmt, ... );
-void Warning( const char * fmt, ... );
-void Debug( const char * fmt, ... );
+#include <stdio.h>
+#include "Lexer.h"
+
+void Error( LexerRef lexer, const char * fmt, ... );
+void Warning( LexerRef lexer, const char * fmt, ... );
+void Debug( LexerRef lexer, const char * fmt, ... );
+void Print_Capture( FILE * fh );
+void Print_Replay( const char * messages, size_t size );
 
 #endif /* PRINT_H */
@@ -0,0 +1,504 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Scan.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Scan.h"
+#include "CharClass.h"
+#include <stdint.h>
+
+/*
+ * Length of the prefix of a run checked without a vector kernel.
+ */
+#define SCAN_SHORT_RUN 8
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define SCAN_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * The kernels return the length of the run of alphanumeric or space
+ * characters starting at p. Runs always end at the NUL sentinel placed
+ * after the input, so no bounds are needed.
+ * The vector kernels only issue aligned loads, which stay within the
+ * buffer thanks to SCAN_ALIGNMENT and SCAN_PADDING. Bytes before p in the
+ * first block are masked out.
+ */
+
+static size_t Scan_AlnumScalar( const char * p );
+static size_t Scan_SpaceScalar( const char * p );
+static size_t Scan_WordScalar( const char * p, bool * ascii );
+
+static ScanKernel Scan_Kernel = ScanKernelScalar;
+static size_t ( * Scan_AlnumFunc )( const char * p ) = Scan_AlnumScalar;
+static size_t ( * Scan_SpaceFunc )( const char * p ) = Scan_SpaceScalar;
+static size_t ( * Scan_WordFunc )( const char * p, bool * ascii ) = Scan_WordScalar;
+
+static size_t Scan_AlnumScalar( const char * p )
+{
+    const char * current;
+
+    for( current = p; CharClass_Is( *( current ), CharClassAlnum ); current++ )
+    {}
+
+    return ( size_t )( current - p );
+}
+
+static size_t Scan_SpaceScalar( const char * p )
+{
+    const char * current;
+
+    for( current = p; CharClass_Is( *( current ), CharClassSpace ); current++ )
+    {}
+
+    return ( size_t )( current - p );
+}
+
+/*
+ * The word kernels also accept non-ASCII bytes, and tell whether there
+ * were any, so that pure ASCII runs need no UTF-8 decoding.
+ */
+static size_t Scan_WordScalar( const char * p, bool * ascii )
+{
+    const char *  current;
+    unsigned char classes;
+
+    classes = CharClassNone;
+
+    for( current = p; CharClass_Is( *( current ), CharClassWord ); current++ )
+    {
+        classes |= CharClass_Get( *( current ) );
+    }
+
+    *( ascii ) = ( classes & CharClassHigh ) == 0;
+
+    return ( size_t )( current - p );
+}
+
+#ifdef SCAN_X86
+
+static inline unsigned int Scan_AlnumMaskSSE2( __m128i v )
+{
+    __m128i digit;
+    __m128i alpha;
+
+    digit = _mm_sub_epi8( v, _mm_set1_epi8( '0' ) );
+    alpha = _mm_sub_epi8( _mm_or_si128( v, _mm_set1_epi8( 0x20 ) ), _mm_set1_epi8( 'a' ) );
+    digit = _mm_cmpeq_epi8( _mm_min_epu8( digit, _mm_set1_epi8( 9 ) ), digit );
+    alpha = _mm_cmpeq_epi8( _mm_min_epu8( alpha, _mm_set1_epi8( 25 ) ), alpha );
+
+    return ( unsigned int )_mm_movemask_epi8( _mm_or_si128( digit, alpha ) );
+}
+
+static inline unsigned int Scan_SpaceMaskSSE2( __m128i v )
+{
+    __m128i control;
+    __m128i space;
+
+    control = _mm_sub_epi8( v, _mm_set1_epi8( '\t' ) );
+    control = _mm_cmpeq_epi8( _mm_min_epu8( control, _mm_set1_epi8( '\r' - '\t' ) ), control );
+    space   = _mm_cmpeq_epi8( v, _mm_set1_epi8( ' ' ) );
+
+    return ( unsigned int )_mm_movemask_epi8( _mm_or_si128( control, space ) );
+}
+
+static size_t Scan_AlnumSSE2( const char * p )
+{
+    uintptr_t    block;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )15;
+    stop  = ~Scan_AlnumMaskSSE2( _mm_load_si128( ( const __m128i * )block ) ) & ( 0xFFFFu << ( ( uintptr_t )p & 15 ) ) & 0xFFFFu;
+
+    while( stop == 0 )
+    {
+        block += 16;
+        stop   = ~Scan_AlnumMaskSSE2( _mm_load_si128( ( const __m128i * )block ) ) & 0xFFFFu;
+    }
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+static size_t Scan_SpaceSSE2( const char * p )
+{
+    uintptr_t    block;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )15;
+    stop  = ~Scan_SpaceMaskSSE2( _mm_load_si128( ( const __m128i * )block ) ) & ( 0xFFFFu << ( ( uintptr_t )p & 15 ) ) & 0xFFFFu;
+
+    while( stop == 0 )
+    {
+        block += 16;
+        stop   = ~Scan_SpaceMaskSSE2( _mm_load_si128( ( const __m128i * )block ) ) & 0xFFFFu;
+    }
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+/*
+ * The sign bits of the bytes are the non-ASCII bytes. Only those before
+ * the end of the run, in the last block, count.
+ */
+static size_t Scan_WordSSE2( const char * p, bool * ascii )
+{
+    uintptr_t    block;
+    __m128i      v;
+    unsigned int high;
+    unsigned int seen;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )15;
+    v     = _mm_load_si128( ( const __m128i * )block );
+    high  = ( unsigned int )_mm_movemask_epi8( v ) & ( 0xFFFFu << ( ( uintptr_t )p & 15 ) );
+    stop  = ~( Scan_AlnumMaskSSE2( v ) | high ) & ( 0xFFFFu << ( ( uintptr_t )p & 15 ) ) & 0xFFFFu;
+    seen  = 0;
+
+    while( stop == 0 )
+    {
+        seen  |= high;
+        block += 16;
+        v      = _mm_load_si128( ( const __m128i * )block );
+        high   = ( unsigned int )_mm_movemask_epi8( v );
+        stop   = ~( Scan_AlnumMaskSSE2( v ) | high ) & 0xFFFFu;
+    }
+
+    seen      |= high & ( ( 1u << __builtin_ctz( stop ) ) - 1 );
+    *( ascii ) = seen == 0;
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static inline unsigned int Scan_AlnumMaskAVX2( __m256i v )
+{
+    __m256i digit;
+    __m256i alpha;
+
+    digit = _mm256_sub_epi8( v, _mm256_set1_epi8( '0' ) );
+    alpha = _mm256_sub_epi8( _mm256_or_si256( v, _mm256_set1_epi8( 0x20 ) ), _mm256_set1_epi8( 'a' ) );
+    digit = _mm256_cmpeq_epi8( _mm256_min_epu8( digit, _mm256_set1_epi8( 9 ) ), digit );
+    alpha = _mm256_cmpeq_epi8( _mm256_min_epu8( alpha, _mm256_set1_epi8( 25 ) ), alpha );
+
+    return ( unsigned int )_mm256_movemask_epi8( _mm256_or_si256( digit, alpha ) );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static inline unsigned int Scan_SpaceMaskAVX2( __m256i v )
+{
+    __m256i control;
+    __m256i space;
+
+    control = _mm256_sub_epi8( v, _mm256_set1_epi8( '\t' ) );
+    control = _mm256_cmpeq_epi8( _mm256_min_epu8( control, _mm256_set1_epi8( '\r' - '\t' ) ), control );
+    space   = _mm256_cmpeq_epi8( v, _mm256_set1_epi8( ' ' ) );
+
+    return ( unsigned int )_mm256_movemask_epi8( _mm256_or_si256( control, space ) );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static size_t Scan_AlnumAVX2( const char * p )
+{
+    uintptr_t    block;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )31;
+    stop  = ~Scan_AlnumMaskAVX2( _mm256_load_si256( ( const __m256i * )block ) ) & ( 0xFFFFFFFFu << ( ( uintptr_t )p & 31 ) );
+
+    while( stop == 0 )
+    {
+        block += 32;
+        stop   = ~Scan_AlnumMaskAVX2( _mm256_load_si256( ( const __m256i * )block ) );
+    }
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static size_t Scan_SpaceAVX2( const char * p )
+{
+    uintptr_t    block;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )31;
+    stop  = ~Scan_SpaceMaskAVX2( _mm256_load_si256( ( const __m256i * )block ) ) & ( 0xFFFFFFFFu << ( ( uintptr_t )p & 31 ) );
+
+    while( stop == 0 )
+    {
+        block += 32;
+        stop   = ~Scan_SpaceMaskAVX2( _mm256_load_si256( ( const __m256i * )block ) );
+    }
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+__attribute__( ( target( "avx2" ) ) )
+static size_t Scan_WordAVX2( const char * p, bool * ascii )
+{
+    uintptr_t    block;
+    __m256i      v;
+    unsigned int high;
+    unsigned int seen;
+    unsigned int stop;
+
+    block = ( uintptr_t )p & ~( uintptr_t )31;
+    v     = _mm256_load_si256( ( const __m256i * )block );
+    high  = ( unsigned int )_mm256_movemask_epi8( v ) & ( 0xFFFFFFFFu << ( ( uintptr_t )p & 31 ) );
+    stop  = ~( Scan_AlnumMaskAVX2( v ) | high ) & ( 0xFFFFFFFFu << ( ( uintptr_t )p & 31 ) );
+    seen  = 0;
+
+    while( stop == 0 )
+    {
+        seen  |= high;
+        block += 32;
+        v      = _mm256_load_si256( ( const __m256i * )block );
+        high   = ( unsigned int )_mm256_movemask_epi8( v );
+        stop   = ~( Scan_AlnumMaskAVX2( v ) | high );
+    }
+
+    seen      |= high & ( ( 1u << __builtin_ctz( stop ) ) - 1 );
+    *( ascii ) = seen == 0;
+
+    return ( size_t )( block - ( uintptr_t )p ) + ( size_t )__builtin_ctz( stop );
+}
+
+#endif /* SCAN_X86 */
+
+/*
+ * Selects the best kernel supported by the CPU when the program starts,
+ * before any thread can scan, so the dispatch pointers are never written
+ * while lexers on other threads read them.
+ */
+__attribute__( ( constructor ) )
+static void Scan_Initialize( void )
+{
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+#endif
+
+    Scan_SetKernel( Scan_IsSupported( ScanKernelAVX2 ) ? ScanKernelAVX2 : ( Scan_IsSupported( ScanKernelSSE2 ) ? ScanKernelSSE2 : ScanKernelScalar ) );
+}
+
+/*
+ * Returns the length of the run of alphanumeric characters at p.
+ * Most identifiers are short: the first bytes are checked one at a time,
+ * and the vector kernel only takes over for longer runs.
+ */
+size_t Scan_Alnum( const char * p )
+{
+    size_t n;
+
+    for( n = 0; n < SCAN_SHORT_RUN; n++ )
+    {
+        if( CharClass_Is( p[ n ], CharClassAlnum ) == false )
+        {
+            return n;
+        }
+    }
+
+    return n + Scan_AlnumFunc( p + n );
+}
+
+/*
+ * Returns the length of the run of alphanumeric and non-ASCII bytes at p,
+ * and whether it is pure ASCII. If it is, the run is a whole identifier,
+ * and otherwise UTF8_ScanIdentifier finds where the identifier ends.
+ * Short ASCII runs, the common case, cost one more test than Scan_Alnum.
+ */
+size_t Scan_Identifier( const char * p, bool * ascii )
+{
+    size_t n;
+
+    for( n = 0; n < SCAN_SHORT_RUN; n++ )
+    {
+        if( CharClass_Is( p[ n ], CharClassAlnum ) )
+        {
+            continue;
+        }
+
+        if( CharClass_Is( p[ n ], CharClassHigh ) == false )
+        {
+            *( ascii ) = true;
+
+            return n;
+        }
+
+        break;
+    }
+
+    return n + Scan_WordFunc( p + n, ascii );
+}
+
+/*
+ * Returns the length of the run of space characters at p.
+ * Single spaces between tokens are the common case, and are handled here
+ * without going through a vector kernel.
+ */
+size_t Scan_Space( const char * p )
+{
+    if( CharClass_Is( p[ 0 ], CharClassSpace ) == false )
+    {
+        return 0;
+    }
+
+    if( CharClass_Is( p[ 1 ], CharClassSpace ) == false )
+    {
+        return 1;
+    }
+
+    return Scan_SpaceFunc( p );
+}
+
+/*
+ * Stores the offsets of the newlines in the length bytes at p, plus base,
+ * and returns how many there are. offsets must have room for length
+ * entries.
+ * Unlike the other kernels, the length is known, so unaligned loads are
+ * used, and SSE2 is enough to keep up with memory.
+ */
+size_t Scan_Newlines( const char * p, size_t length, size_t base, size_t * offsets )
+{
+    size_t n;
+    size_t i;
+
+    n = 0;
+    i = 0;
+
+#ifdef __SSE2__
+
+    for( ; i + 16 <= length; i += 16 )
+    {
+        unsigned int mask;
+
+        mask = ( unsigned int )_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( ( const __m128i * )( p + i ) ), _mm_set1_epi8( '\n' ) ) );
+
+        while( mask != 0 )
+        {
+            offsets[ n++ ] = base + i + ( size_t )__builtin_ctz( mask );
+            mask          &= mask - 1;
+        }
+    }
+
+#endif
+
+    for( ; i < length; i++ )
+    {
+        if( p[ i ] == '\n' )
+        {
+            offsets[ n++ ] = base + i;
+        }
+    }
+
+    return n;
+}
+
+ScanKernel Scan_GetKernel( void )
+{
+    return Scan_Kernel;
+}
+
+bool Scan_IsSupported( ScanKernel kernel )
+{
+    if( kernel == ScanKernelScalar )
+    {
+        return true;
+    }
+
+#ifdef SCAN_X86
+
+    if( kernel == ScanKernelSSE2 )
+    {
+        return __builtin_cpu_supports( "sse2" ) != 0;
+    }
+
+    if( kernel == ScanKernelAVX2 )
+    {
+        return __builtin_cpu_supports( "avx2" ) != 0;
+    }
+
+#endif
+
+    return false;
+}
+
+/*
+ * Replaces the kernels, as the benchmarks do. It must not be called while
+ * other threads may be scanning.
+ */
+bool Scan_SetKernel( ScanKernel kernel )
+{
+    if( Scan_IsSupported( kernel ) == false )
+    {
+        return false;
+    }
+
+#ifdef SCAN_X86
+
+    if( kernel == ScanKernelSSE2 )
+    {
+        Scan_AlnumFunc = Scan_AlnumSSE2;
+        Scan_SpaceFunc = Scan_SpaceSSE2;
+        Scan_WordFunc  = Scan_WordSSE2;
+        Scan_Kernel    = kernel;
+
+        return true;
+    }
+
+    if( kernel == ScanKernelAVX2 )
+    {
+        Scan_AlnumFunc = Scan_AlnumAVX2;
+        Scan_SpaceFunc = Scan_SpaceAVX2;
+        Scan_WordFunc  = Scan_WordAVX2;
+        Scan_Kernel    = kernel;
+
+        return true;
+    }
+
+#endif
+
+    Scan_AlnumFunc = Scan_AlnumScalar;
+    Scan_SpaceFunc = Scan_SpaceScalar;
+    Scan_WordFunc  = Scan_WordScalar;
+    Scan_Kernel    = kernel;
+
+    return true;
+}
+
+const char * Scan_GetKernelName( ScanKernel kernel )
+{
+    static const char * const names[] = { "Scalar", "SSE2", "AVX2" };
+
+    if( ( unsigned int )kernel >= sizeof( names ) / sizeof( *( names ) ) )
+    {
+        return "Unknown";
+    }
+
+    return names[ kernel ];
+}
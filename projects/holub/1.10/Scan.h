@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Scan.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Buffers scanned by the kernels start on a SCAN_ALIGNMENT boundary, and
+ * have SCAN_PADDING readable bytes from their NUL sentinel, as the vector
+ * kernels read whole aligned blocks, up to the end of the one holding it.
+ */
+#define SCAN_ALIGNMENT 32
+#define SCAN_PADDING   32
+
+typedef enum
+{
+    ScanKernelScalar = 0,
+    ScanKernelSSE2   = 1,
+    ScanKernelAVX2   = 2
+} ScanKernel;
+
+size_t       Scan_Alnum( const char * p );
+size_t       Scan_Identifier( const char * p, bool * ascii );
+size_t       Scan_Space( const char * p );
+size_t       Scan_Newlines( const char * p, size_t length, size_t base, size_t * offsets );
+ScanKernel   Scan_GetKernel( void );
+bool         Scan_SetKernel( ScanKernel kernel );
+bool         Scan_IsSupported( ScanKernel kernel );
+const char * Scan_GetKernelName( ScanKernel kernel );
+
+#endif /* SCAN_H */
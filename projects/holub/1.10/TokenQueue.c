@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+/*!
+ * @file        TokenQueue.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "TokenQueue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+/*
+ * Must be powers of two.
+ */
+#define TOKEN_QUEUE_SIZE  4096
+#define TOKEN_QUEUE_BATCH 64
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    uint64_t offset;
+    uint32_t length;
+    uint8_t  kind;
+} TokenQueueEntry;
+
+/*
+ * A ring of tokens with a single producer and a single consumer.
+ * Each side only publishes its position every TOKEN_QUEUE_BATCH tokens,
+ * or before waiting for the other side, and keeps a copy of the other
+ * side's position, which it only reloads when it looks full or empty.
+ * The shared positions and the private state of each side are on
+ * separate cache lines, so the lines only move between cores once per
+ * batch.
+ */
+struct TokenQueue
+{
+    uint64_t                        rc;
+    atomic_bool                     closed;
+    _Alignas( 64 ) atomic_size_t    head;
+    _Alignas( 64 ) atomic_size_t    tail;
+    _Alignas( 64 ) size_t           pushed;
+    size_t                          tailCache;
+    _Alignas( 64 ) size_t           popped;
+    size_t                          headCache;
+    _Alignas( 64 ) TokenQueueEntry  entries[ TOKEN_QUEUE_SIZE ];
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+TokenQueueRef TokenQueue_Create( void )
+{
+    TokenQueueRef queue;
+
+    if( ( queue = aligned_alloc( _Alignof( struct TokenQueue ), sizeof( struct TokenQueue ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    memset( queue, 0, sizeof( struct TokenQueue ) );
+
+    queue->rc = 1;
+
+    atomic_init( &( queue->closed ), false );
+    atomic_init( &( queue->head ), 0 );
+    atomic_init( &( queue->tail ), 0 );
+
+    return queue;
+}
+
+/*
+ * Retaining and releasing aren't atomic: the queue must only be retained
+ * or released by the thread that created it.
+ */
+TokenQueueRef TokenQueue_Retain( TokenQueueRef queue )
+{
+    if( queue == NULL )
+    {
+        return NULL;
+    }
+
+    queue->rc++;
+
+    return queue;
+}
+
+void TokenQueue_Release( TokenQueueRef queue )
+{
+    if( queue == NULL )
+    {
+        return;
+    }
+
+    if( --( queue->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( queue );
+}
+
+/*
+ * Called by the producer. Waits while the queue is full.
+ * Returns false if the consumer closed the queue.
+ */
+bool TokenQueue_Push( TokenQueueRef queue, uint8_t kind, uint64_t offset, uint32_t length )
+{
+    TokenQueueEntry * entry;
+
+    if( queue->pushed - queue->tailCache == TOKEN_QUEUE_SIZE )
+    {
+        TokenQueue_Flush( queue );
+
+        while( queue->pushed - ( queue->tailCache = atomic_load_explicit( &( queue->tail ), memory_order_acquire ) ) == TOKEN_QUEUE_SIZE )
+        {
+            if( atomic_load_explicit( &( queue->closed ), memory_order_relaxed ) )
+            {
+                return false;
+            }
+
+            sched_yield();
+        }
+    }
+
+    entry         = &( queue->entries[ queue->pushed & ( TOKEN_QUEUE_SIZE - 1 ) ] );
+    entry->kind   = kind;
+    entry->offset = offset;
+    entry->length = length;
+
+    queue->pushed++;
+
+    if( ( queue->pushed & ( TOKEN_QUEUE_BATCH - 1 ) ) == 0 )
+    {
+        TokenQueue_Flush( queue );
+    }
+
+    return true;
+}
+
+/*
+ * Called by the producer, to publish the tokens pushed since the last
+ * batch.
+ */
+void TokenQueue_Flush( TokenQueueRef queue )
+{
+    atomic_store_explicit( &( queue->head ), queue->pushed, memory_order_release );
+}
+
+/*
+ * Called by the consumer. Waits while the queue is empty, so the producer
+ * must always end with a token telling the consumer to stop.
+ */
+void TokenQueue_Pop( TokenQueueRef queue, uint8_t * kind, uint64_t * offset, uint32_t * length )
+{
+    TokenQueueEntry * entry;
+
+    if( queue->popped == queue->headCache )
+    {
+        atomic_store_explicit( &( queue->tail ), queue->popped, memory_order_release );
+
+        while( ( queue->headCache = atomic_load_explicit( &( queue->head ), memory_order_acquire ) ) == queue->popped )
+        {
+            sched_yield();
+        }
+    }
+
+    entry       = &( queue->entries[ queue->popped & ( TOKEN_QUEUE_SIZE - 1 ) ] );
+    *( kind )   = entry->kind;
+    *( offset ) = entry->offset;
+    *( length ) = entry->length;
+
+    queue->popped++;
+
+    if( ( queue->popped & ( TOKEN_QUEUE_BATCH - 1 ) ) == 0 )
+    {
+        atomic_store_explicit( &( queue->tail ), queue->popped, memory_order_release );
+    }
+}
+
+/*
+ * Called by the consumer, to stop a producer waiting for room.
+ */
+void TokenQueue_Close( TokenQueueRef queue )
+{
+    atomic_store_explicit( &( queue->closed ), true, memory_order_relaxed );
+}
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Tokens.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef TOKENS_H
+#define TOKENS_H
+
+/*
+ * The tokens, in the order of their values. This is the only place they
+ * are defined: the Token enum, the names returned by Token_GetName() and
+ * the cases of the lexer matching single characters are all expanded from
+ * this table.
+ *
+ *     TOKEN( name, text )             Scanned by the lexer's own code
+ *     PUNCTUATOR( name, c, text )     A single character
+ */
+#define TOKENS( TOKEN, PUNCTUATOR )                                  \
+    TOKEN(      TokenEnd,                   "end of input"         ) \
+    PUNCTUATOR( TokenSemicolon,        ';', ";"                    ) \
+    PUNCTUATOR( TokenAdd,              '+', "+"                    ) \
+    PUNCTUATOR( TokenMultiply,         '*', "*"                    ) \
+    PUNCTUATOR( TokenLeftParenthesis,  '(', "("                    ) \
+    PUNCTUATOR( TokenRightParenthesis, ')', ")"                    ) \
+    TOKEN(      TokenNumericOrID,           "number or identifier" )
+
+/*
+ * FIRST( expression ), which is also FIRST( term ) and FIRST( factor ):
+ * the tokens the parser accepts as a lookahead when entering a rule.
+ * Expanded with TOKEN_SET_OF() into a constant TokenSet.
+ */
+#define FIRST_EXPRESSION( TOKEN ) \
+    TOKEN( TokenNumericOrID )     \
+    TOKEN( TokenLeftParenthesis )
+
+#endif /* TOKENS_H */
@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        UTF8.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "UTF8.h"
+#include "CharClass.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+} UTF8Range;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Code points allowed in identifiers, from C11 Annex D.1, sorted.
+ */
+static const UTF8Range UTF8_Identifier[] =
+{
+    { 0x00A8,  0x00A8  }, { 0x00AA,  0x00AA  }, { 0x00AD,  0x00AD  }, { 0x00AF,  0x00AF  },
+    { 0x00B2,  0x00B5  }, { 0x00B7,  0x00BA  }, { 0x00BC,  0x00BE  }, { 0x00C0,  0x00D6  },
+    { 0x00D8,  0x00F6  }, { 0x00F8,  0x00FF  }, { 0x0100,  0x167F  }, { 0x1681,  0x180D  },
+    { 0x180F,  0x1FFF  }, { 0x200B,  0x200D  }, { 0x202A,  0x202E  }, { 0x203F,  0x2040  },
+    { 0x2054,  0x2054  }, { 0x2060,  0x206F  }, { 0x2070,  0x218F  }, { 0x2460,  0x24FF  },
+    { 0x2776,  0x2793  }, { 0x2C00,  0x2DFF  }, { 0x2E80,  0x2FFF  }, { 0x3004,  0x3007  },
+    { 0x3021,  0x302F  }, { 0x3031,  0x303F  }, { 0x3040,  0xD7FF  }, { 0xF900,  0xFD3D  },
+    { 0xFD40,  0xFDCF  }, { 0xFDF0,  0xFE44  }, { 0xFE47,  0xFFFD  }, { 0x10000, 0x1FFFD },
+    { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD }, { 0x40000, 0x4FFFD }, { 0x50000, 0x5FFFD },
+    { 0x60000, 0x6FFFD }, { 0x70000, 0x7FFFD }, { 0x80000, 0x8FFFD }, { 0x90000, 0x9FFFD },
+    { 0xA0000, 0xAFFFD }, { 0xB0000, 0xBFFFD }, { 0xC0000, 0xCFFFD }, { 0xD0000, 0xDFFFD },
+    { 0xE0000, 0xEFFFD }
+};
+
+/*
+ * Combining marks, which C11 Annex D.2 disallows at the start of an
+ * identifier.
+ */
+static const UTF8Range UTF8_NotStart[] =
+{
+    { 0x0300, 0x036F }, { 0x1DC0, 0x1DFF }, { 0x20D0, 0x20FF }, { 0xFE20, 0xFE2F }
+};
+
+static bool UTF8_InRanges( const UTF8Range * ranges, size_t count, uint32_t codepoint )
+{
+    size_t low;
+    size_t high;
+
+    low  = 0;
+    high = count;
+
+    while( low < high )
+    {
+        size_t middle;
+
+        middle = low + ( high - low ) / 2;
+
+        if( codepoint < ranges[ middle ].first )
+        {
+            high = middle;
+        }
+        else if( codepoint > ranges[ middle ].last )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Decodes the UTF-8 sequence at p, and returns its length, or 0 if it is
+ * not a valid sequence: a stray continuation byte, a truncated, overlong
+ * or surrogate sequence, or a code point above U+10FFFF.
+ * A NUL sentinel is never a continuation byte, so this never reads past
+ * the end of the input.
+ */
+size_t UTF8_Decode( const char * p, uint32_t * codepoint )
+{
+    const unsigned char * s;
+    size_t                length;
+    uint32_t              value;
+    uint32_t              min;
+
+    s = ( const unsigned char * )p;
+
+    if( s[ 0 ] < 0x80 )
+    {
+        *( codepoint ) = s[ 0 ];
+
+        return 1;
+    }
+    else if( s[ 0 ] >= 0xC2 && s[ 0 ] <= 0xDF )
+    {
+        length = 2;
+        value  = s[ 0 ] & 0x1FU;
+        min    = 0x80;
+    }
+    else if( s[ 0 ] >= 0xE0 && s[ 0 ] <= 0xEF )
+    {
+        length = 3;
+        value  = s[ 0 ] & 0x0FU;
+        min    = 0x800;
+    }
+    else if( s[ 0 ] >= 0xF0 && s[ 0 ] <= 0xF4 )
+    {
+        length = 4;
+        value  = s[ 0 ] & 0x07U;
+        min    = 0x10000;
+    }
+    else
+    {
+        return 0;
+    }
+
+    for( size_t i = 1; i < length; i++ )
+    {
+        if( ( s[ i ] & 0xC0 ) != 0x80 )
+        {
+            return 0;
+        }
+
+        value = ( value << 6 ) | ( s[ i ] & 0x3FU );
+    }
+
+    if( value < min || value > 0x10FFFF || ( value >= 0xD800 && value <= 0xDFFF ) )
+    {
+        return 0;
+    }
+
+    *( codepoint ) = value;
+
+    return length;
+}
+
+/*
+ * Whether a non-ASCII code point can appear in an identifier, or start
+ * one.
+ */
+bool UTF8_IsIdentifier( uint32_t codepoint, bool start )
+{
+    if( UTF8_InRanges( UTF8_Identifier, sizeof( UTF8_Identifier ) / sizeof( *( UTF8_Identifier ) ), codepoint ) == false )
+    {
+        return false;
+    }
+
+    return start == false || UTF8_InRanges( UTF8_NotStart, sizeof( UTF8_NotStart ) / sizeof( *( UTF8_NotStart ) ), codepoint ) == false;
+}
+
+/*
+ * Returns the length of the identifier at p, given a run of length
+ * alphanumeric and non-ASCII bytes starting there. The identifier ends
+ * before the first sequence that is not valid UTF-8, or not a code point
+ * allowed in identifiers.
+ */
+size_t UTF8_ScanIdentifier( const char * p, size_t length )
+{
+    size_t i;
+
+    i = 0;
+
+    while( i < length )
+    {
+        uint32_t codepoint;
+        size_t   n;
+
+        if( CharClass_Is( p[ i ], CharClassAlnum ) )
+        {
+            i++;
+
+            continue;
+        }
+
+        if( ( n = UTF8_Decode( p + i, &codepoint ) ) == 0 || i + n > length || UTF8_IsIdentifier( codepoint, i == 0 ) == false )
+        {
+            break;
+        }
+
+        i += n;
+    }
+
+    return i;
+}
@@ -30,11 +30,266 @@
  */
 
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include "Parser.h"
+#include "Grammar.h"
+#include "LALR.h"
+#include "Lexer.h"
+#include "Input.h"
+#include "Print.h"
+#include "Bench.h"
+#include "Compiler.h"
 
-int main( void )
+/*
+ * Compiles the input as it is read, printing the code of each statement as
+ * soon as its semicolon is, which suits a pipe kept open by a producer.
+ */
+static int Main_Push( const char * path, bool quiet )
 {
-    Parser_Statements();
+    CompilerRef compiler;
+    int         fd;
+    bool        ok;
+
+    if( path == NULL )
+    {
+        fd = STDIN_FILENO;
+    }
+    else if( ( fd = open( path, O_RDONLY ) ) < 0 )
+    {
+        Error( NULL, "Cannot open %s: %s", path, strerror( errno ) );
+
+        return EXIT_FAILURE;
+    }
+
+    if( ( compiler = Compiler_Create( NULL, NULL ) ) == NULL )
+    {
+        ok = false;
+    }
+    else
+    {
+        Compiler_SetDebug( compiler, quiet == false );
+
+        ok = Compiler_Read( compiler, fd );
+    }
+
+    Compiler_Release( compiler );
+
+    if( fd != STDIN_FILENO )
+    {
+        close( fd );
+    }
+
+    return ( ok ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ * Runs one of the table-driven parsers, which stop at the first syntax
+ * error. Like the hand-written parser, they then resume after the next
+ * semicolon, so the later statements are still compiled, and all errors
+ * reported. Returns false if any error was found.
+ */
+static bool Main_Parse( LexerRef lexer, bool ( * parse )( LexerRef lexer ) )
+{
+    bool ok;
+
+    ok = true;
+
+    while( parse( lexer ) == false )
+    {
+        ok = false;
+
+        while( Lexer_Match( lexer, TokenSemicolon ) == false && Lexer_Match( lexer, TokenEnd ) == false )
+        {
+            Lexer_Advance( lexer );
+        }
+
+        if( Lexer_Match( lexer, TokenEnd ) )
+        {
+            break;
+        }
+
+        Lexer_Advance( lexer );
+    }
+
+    return ok;
+}
+
+int main( int argc, char * argv[] )
+{
+    const char * path;
+    bool         tokenize;
+    size_t       threads;
+    bool         pipeline;
+    bool         quiet;
+    bool         table;
+    bool         lalr;
+    bool         statements;
+    bool         push;
+    InputRef     input;
+    LexerRef     lexer;
+    int          status;
+
+    path       = NULL;
+    tokenize   = false;
+    threads    = 1;
+    pipeline   = false;
+    quiet      = false;
+    table      = false;
+    lalr       = false;
+    statements = false;
+    push       = false;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[ i ], "--bench-scan" ) == 0 )
+        {
+            return Bench_Scan();
+        }
+        else if( strcmp( argv[ i ], "--bench-pipeline" ) == 0 )
+        {
+            return Bench_Pipeline();
+        }
+        else if( strcmp( argv[ i ], "--bench-tokenize" ) == 0 )
+        {
+            return Bench_Tokenize();
+        }
+        else if( strcmp( argv[ i ], "--bench-edit" ) == 0 )
+        {
+            return Bench_Edit();
+        }
+        else if( strcmp( argv[ i ], "--bench-dfa" ) == 0 )
+        {
+            return Bench_DFA();
+        }
+        else if( strcmp( argv[ i ], "--bench-ll" ) == 0 )
+        {
+            return Bench_LL();
+        }
+        else if( strcmp( argv[ i ], "--bench-lr" ) == 0 )
+        {
+            return Bench_LR();
+        }
+        else if( strcmp( argv[ i ], "--bench-statements" ) == 0 )
+        {
+            return Bench_Statements();
+        }
+        else if( strcmp( argv[ i ], "--tokens" ) == 0 )
+        {
+            tokenize = true;
+        }
+        else if( strcmp( argv[ i ], "--parallel" ) == 0 )
+        {
+            tokenize = true;
+            threads  = ( size_t )sysconf( _SC_NPROCESSORS_ONLN );
+        }
+        else if( strcmp( argv[ i ], "--pipeline" ) == 0 )
+        {
+            pipeline = true;
+        }
+        else if( strcmp( argv[ i ], "--statements" ) == 0 )
+        {
+            statements = true;
+            threads    = ( size_t )sysconf( _SC_NPROCESSORS_ONLN );
+        }
+        else if( strcmp( argv[ i ], "--push" ) == 0 )
+        {
+            push = true;
+        }
+        else if( strcmp( argv[ i ], "--ll" ) == 0 )
+        {
+            table = true;
+        }
+        else if( strcmp( argv[ i ], "--lr" ) == 0 )
+        {
+            lalr = true;
+        }
+        else if( strcmp( argv[ i ], "--quiet" ) == 0 )
+        {
+            quiet = true;
+        }
+        else
+        {
+            path = argv[ i ];
+        }
+    }
+
+    if( push )
+    {
+        return Main_Push( path, quiet );
+    }
+
+    input = ( path == NULL ) ? Input_Create( STDIN_FILENO ) : Input_CreateWithFile( path );
+    lexer = Lexer_Create( input );
+
+    Input_Release( input );
+
+    if( lexer == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    Lexer_SetDebug( lexer, quiet == false );
+
+    status = EXIT_SUCCESS;
+
+    if( tokenize && threads > 1 && Input_IsMapped( Lexer_GetInput( lexer ) ) )
+    {
+        if( Lexer_TokenizeParallel( lexer, threads ) == false )
+        {
+            status = EXIT_FAILURE;
+        }
+        else
+        {
+            Parser_Statements( lexer );
+        }
+    }
+    else if( tokenize && Lexer_Tokenize( lexer ) == false )
+    {
+        status = EXIT_FAILURE;
+    }
+    else if( tokenize == false && pipeline && Lexer_StartPipeline( lexer ) == false )
+    {
+        Error( NULL, "Cannot start the lexer thread: the input must be a file" );
+
+        status = EXIT_FAILURE;
+    }
+    else if( statements )
+    {
+        if( Input_IsMapped( Lexer_GetInput( lexer ) ) == false )
+        {
+            Error( NULL, "Cannot compile statements in parallel: the input must be a file" );
+
+            status = EXIT_FAILURE;
+        }
+        else if( Parser_StatementsParallel( lexer, threads ) == false )
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    else if( table )
+    {
+        if( Main_Parse( lexer, Grammar_Parse ) == false )
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    else if( lalr )
+    {
+        if( Main_Parse( lexer, LALR_Parse ) == false )
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        Parser_Statements( lexer );
+    }
+
+    Lexer_Release( lexer );
 
-    return EXIT_SUCCESS;
+    return status;
 }
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Bench.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Bench.h"
+#include "Input.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "Grammar.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Parser_Statements recurses once per statement, so the input is kept
+ * small enough for the C stack, and parsed more times.
+ */
+#define BENCH_SIZE   ( 1024 * 1024 )
+#define BENCH_ROUNDS 20
+
+static double Bench_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( double )ts.tv_sec + ( double )ts.tv_nsec / 1e9;
+}
+
+static void Bench_WriteFactor( FILE * fh, int depth );
+
+static void Bench_WriteExpression( FILE * fh, int depth )
+{
+    int terms;
+
+    terms = 1 + rand() % 3;
+
+    for( int i = 0; i < terms; i++ )
+    {
+        int factors;
+
+        factors = 1 + rand() % 3;
+
+        for( int j = 0; j < factors; j++ )
+        {
+            Bench_WriteFactor( fh, depth );
+            fputs( ( j + 1 < factors ) ? " * " : "", fh );
+        }
+
+        fputs( ( i + 1 < terms ) ? " + " : "", fh );
+    }
+}
+
+static void Bench_WriteFactor( FILE * fh, int depth )
+{
+    int length;
+
+    if( depth < 2 && rand() % 4 == 0 )
+    {
+        fputs( "( ", fh );
+        Bench_WriteExpression( fh, depth + 1 );
+        fputs( " )", fh );
+
+        return;
+    }
+
+    length = 1 + rand() % 12;
+
+    for( int i = 0; i < length; i++ )
+    {
+        fputc( "abcdefghijklmnopqrstuvwxyz0123456789"[ rand() % ( ( i == 0 ) ? 26 : 36 ) ], fh );
+    }
+}
+
+/*
+ * Writes BENCH_SIZE bytes of valid statements to a temporary file.
+ */
+static bool Bench_CreateInput( char * path )
+{
+    int    fd;
+    FILE * fh;
+
+    if( ( fd = mkstemp( path ) ) < 0 || ( fh = fdopen( fd, "w" ) ) == NULL )
+    {
+        return false;
+    }
+
+    srand( 42 );
+
+    while( ftell( fh ) < BENCH_SIZE )
+    {
+        Bench_WriteExpression( fh, 0 );
+        fputs( ";\n", fh );
+    }
+
+    fclose( fh );
+
+    return true;
+}
+
+/*
+ * Parses the whole input with the hand-written parser or the one
+ * generated from Grammar.g, and returns the throughput in MB/s.
+ * The lexer prints every token, so its output goes to /dev/null while
+ * parsing, but is still formatted.
+ */
+static double Bench_Parse( const char * path, bool table )
+{
+    double best;
+    int    out;
+    int    null;
+
+    best = 0;
+
+    fflush( stdout );
+
+    if( ( out = dup( STDOUT_FILENO ) ) < 0 || ( null = open( "/dev/null", O_WRONLY ) ) < 0 )
+    {
+        return 0;
+    }
+
+    dup2( null, STDOUT_FILENO );
+    close( null );
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        double start;
+        double elapsed;
+
+        if( Input_OpenFile( path ) == false )
+        {
+            break;
+        }
+
+        Lexer_Reset();
+
+        start = Bench_Now();
+
+        if( table )
+        {
+            Grammar_Parse();
+        }
+        else
+        {
+            Parser_Statements();
+        }
+
+        elapsed = Bench_Now() - start;
+
+        Input_Close();
+
+        if( elapsed > 0 && ( double )BENCH_SIZE / elapsed / 1e6 > best )
+        {
+            best = ( double )BENCH_SIZE / elapsed / 1e6;
+        }
+    }
+
+    fflush( stdout );
+    dup2( out, STDOUT_FILENO );
+    close( out );
+
+    return best;
+}
+
+/*
+ * Compares the hand-written recursive descent parser to the table-driven
+ * one generated from Grammar.g.
+ */
+int Bench_LL( void )
+{
+    char   path[] = "/tmp/holub-bench-XXXXXX";
+    double parser;
+    double table;
+
+    if( Bench_CreateInput( path ) == false )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    printf( "%-14s %8s    (MB/s)\n", "Parser", "Parse" );
+
+    parser = Bench_Parse( path, false );
+
+    printf( "%-14s %8.0f\n", "Hand-written", parser );
+    fflush( stdout );
+
+    table = Bench_Parse( path, true );
+
+    printf( "%-14s %8.0f    x%.2f\n", "Table-driven", table, ( parser > 0 ) ? table / parser : 0 );
+
+    unlink( path );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#-------------------------------------------------------------------------------
+# Expression grammar, for tools-llgen.
+# Regenerate Grammar.c and Grammar.h with `make ll` after editing it.
+#-------------------------------------------------------------------------------
+
+%include   "Lexer.h"
+%include   "Print.h"
+%lookahead Lexer_GetLookahead()
+%advance   Lexer_Advance();
+%error     Error( "Syntax error" );
+%token     TokenEnd TokenSemicolon TokenAdd TokenMultiply TokenLeftParenthesis TokenRightParenthesis TokenNumericOrID
+%end       TokenEnd
+
+statements  : expression TokenSemicolon statements
+            |
+            ;
+
+expression  : term expression'
+            ;
+
+expression' : TokenAdd term expression'
+            |
+            ;
+
+term        : factor term'
+            ;
+
+term'       : TokenMultiply factor term'
+            |
+            ;
+
+factor      : TokenNumericOrID
+            | TokenLeftParenthesis expression TokenRightParenthesis
+            ;
@@ -31,12 +31,14 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdint.h>
 
-static char * Lexer_Text      = "";
+static char * Lexer_Text      = NULL;
 static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
+static size_t Lexer_Line      = 1;
 static int    Lexer_Lookahead = -1;
 
 const char * Lexer_GetText( void )
@@ -54,83 +56,151 @@ size_t Lexer_GetLine( void )
     return Lexer_Line;
 }
 
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: Debug( "Token: " text ); return name;
+
 Token Lexer_Next( void )
 {
-    static char buf[ 128 ];
-    char *      current;
+    char * current;
 
-    current = Lexer_Text + Lexer_Length;
+    current = ( Lexer_Text == NULL ) ? Input_GetStart() : Lexer_Text + Lexer_Length;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        Lexer_Text   = current;
+        Lexer_Length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
+
+                if( Input_Fill( &Lexer_Text, &current ) )
+                {
+                    break;
+                }
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_IsEnd( current ) )
+                {
+                    Lexer_Length = 0;
 
-                return TokenEnd;
-            }
+                    return TokenEnd;
+                }
 
-            Lexer_Line++;
+                Error( "Ignoring illegal input: NUL" );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
-
-            switch( *( current ) )
-            {
-                case EOF: Debug( "Token: End" ); return TokenEnd;
-                case ';': Debug( "Token: ;" ); return TokenSemicolon;
-                case '+': Debug( "Token: +" ); return TokenAdd;
-                case '*': Debug( "Token: *" ); return TokenMultiply;
-                case '(': Debug( "Token: (" ); return TokenLeftParenthesis;
-                case ')': Debug( "Token: )" ); return TokenRightParenthesis;
-
-                case '\n':
-                case '\t':
-                case ' ':
+                break;
+
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
+
+            case '\n':
+
+                Lexer_Line++;
+                current++;
+
+                break;
+
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
+
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Error( "Ignoring illegal input: %c", *( current ) );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Error( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
                         current++;
                     }
+                }
+                while( Input_Fill( &Lexer_Text, &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
 
-                    Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
+                Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
 
-                    return TokenNumericOrID;
-            }
+                return TokenNumericOrID;
         }
     }
 }
 
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
 void Lexer_Advance( void )
 {
     Lexer_Lookahead = ( int )( Lexer_Next() );
 }
 
+/*
+ * Starts over at the beginning of the input, after it was reopened.
+ */
+void Lexer_Reset( void )
+{
+    Lexer_Text      = NULL;
+    Lexer_Length    = 0;
+    Lexer_Line      = 1;
+    Lexer_Lookahead = -1;
+}
+
+/*
+ * Returns the current token, reading the first one if needed.
+ */
+Token Lexer_GetLookahead( void )
+{
+    if( Lexer_Lookahead == -1 )
+    {
+        Lexer_Advance();
+    }
+
+    return ( Token )Lexer_Lookahead;
+}
+
 bool Lexer_Match( Token token )
 {
     if( Lexer_Lookahead == -1 )
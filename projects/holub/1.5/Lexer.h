@@ -34,24 +34,30 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "Tokens.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd              = 0, /* End of input */
-    TokenSemicolon        = 1, /* ; */
-    TokenAdd              = 2, /* + */
-    TokenMultiply         = 3, /* * */
-    TokenLeftParenthesis  = 4, /* ( */
-    TokenRightParenthesis = 5, /* ) */
-    TokenNumericOrID      = 6  /* Decimal number or identifier */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
 const char * Lexer_GetText( void );
 size_t       Lexer_GetLength( void );
 size_t       Lexer_GetLine( void );
 
+void  Lexer_Reset( void );
 Token Lexer_Next( void );
 void  Lexer_Advance( void );
 bool  Lexer_Match( Token token );
+Token Lexer_GetLookahead( void );
 
 #endif /* LEXER_H */
@@ -30,11 +30,25 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "Parser.h"
+#include "Input.h"
+#include "Bench.h"
 
-int main( void )
+int main( int argc, char * argv[] )
 {
+    if( argc > 1 && strcmp( argv[ 1 ], "--bench-ll" ) == 0 )
+    {
+        return Bench_LL();
+    }
+
+    if( argc > 1 && Input_OpenFile( argv[ 1 ] ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+
     Parser_Statements();
+    Input_Close();
 
     return EXIT_SUCCESS;
 }
@@ -31,14 +31,16 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 
-static char * Lexer_Text      = "";
+static char * Lexer_Text      = NULL;
 static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
+static size_t Lexer_Line      = 1;
 static int    Lexer_Lookahead = -1;
 
 const char * Lexer_GetText( void )
@@ -56,78 +58,122 @@ size_t Lexer_GetLine( void )
     return Lexer_Line;
 }
 
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: Debug( "Token: " text ); return name;
+
 Token Lexer_Next( void )
 {
-    static char buf[ 128 ];
-    char *      current;
+    char * current;
 
-    current = Lexer_Text + Lexer_Length;
+    current = ( Lexer_Text == NULL ) ? Input_GetStart() : Lexer_Text + Lexer_Length;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        Lexer_Text   = current;
+        Lexer_Length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( &Lexer_Text, &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( current ) )
+                {
+                    Lexer_Length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                Error( "Ignoring illegal input: NUL" );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
-
-            switch( *( current ) )
-            {
-                case EOF: Debug( "Token: End" ); return TokenEnd;
-                case ';': Debug( "Token: ;" ); return TokenSemicolon;
-                case '+': Debug( "Token: +" ); return TokenAdd;
-                case '*': Debug( "Token: *" ); return TokenMultiply;
-                case '(': Debug( "Token: (" ); return TokenLeftParenthesis;
-                case ')': Debug( "Token: )" ); return TokenRightParenthesis;
-
-                case '\n':
-                case '\t':
-                case ' ':
+                break;
+
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
+
+            case '\n':
+
+                Lexer_Line++;
+                current++;
+
+                break;
+
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
+
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Error( "Ignoring illegal input: %c", *( current ) );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Error( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
                         current++;
                     }
+                }
+                while( Input_Fill( &Lexer_Text, &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
 
-                    Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
+                Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
 
-                    return TokenNumericOrID;
-            }
+                return TokenNumericOrID;
         }
     }
 }
 
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
 void Lexer_Advance( void )
 {
     Lexer_Lookahead = ( int )( Lexer_Next() );
@@ -143,62 +189,67 @@ bool Lexer_Match( Token token )
     return ( int )token == Lexer_Lookahead;
 }
 
+/*
+ * Variadic form of Lexer_LegalLookaheadSet, taking a list of tokens
+ * terminated by TokenEnd.
+ */
 bool Lexer_LegalLookahead( Token first, ... )
 {
-    va_list ap;
-    bool    ret;
+    va_list  ap;
+    TokenSet set;
+    Token    token;
+
+    if( first == TokenEnd )
+    {
+        return Lexer_Match( TokenEnd );
+    }
 
     va_start( ap, first );
 
-    ret = false;
+    set = TOKEN_SET( first );
 
-    if( first == TokenEnd )
+    while( ( token = va_arg( ap, Token ) ) != TokenEnd )
     {
-        ret = Lexer_Match( TokenEnd );
+        set |= TOKEN_SET( token );
     }
-    else
+
+    va_end( ap );
+
+    return Lexer_LegalLookaheadSet( set );
+}
+
+/*
+ * Skips tokens until the lookahead is in the set, reporting a syntax error
+ * once if any token had to be skipped.
+ * Returns false if a semicolon or the end of input is reached first.
+ */
+bool Lexer_LegalLookaheadSet( TokenSet set )
+{
+    bool err;
+
+    if( Lexer_Lookahead == -1 )
     {
-        Token   token;
-        Token   lookaheads[ 16 ];
-        Token * p;
-        Token * current;
-        bool    err;
+        Lexer_Advance();
+    }
 
-        err      = false;
-        p        = lookaheads;
-        *( p++ ) = first;
+    err = false;
 
-        while( ( token = va_arg( ap, Token ) ) != TokenEnd && p < &( lookaheads[ 16 ] ) )
+    while( ( TOKEN_SET( Lexer_Lookahead ) & set ) == 0 )
+    {
+        if( ( TOKEN_SET( Lexer_Lookahead ) & ( TOKEN_SET( TokenSemicolon ) | TOKEN_SET( TokenEnd ) ) ) != 0 )
         {
-            *( p++ ) = token;
+            return false;
         }
 
-        while( Lexer_Match( TokenSemicolon ) == false )
+        if( err == false )
         {
-            for( current = lookaheads; current < p; current++ )
-            {
-                if( Lexer_Match( *( current ) ) )
-                {
-                    ret = true;
+            err = true;
 
-                    goto done;
-                }
-            }
-
-            if( err == false )
-            {
-                err = true;
-
-                Error( "Syntax error" );
-            }
-
-            Lexer_Advance();
+            Error( "Syntax error" );
         }
-    }
 
-done:
-
-    va_end( ap );
+        Lexer_Advance();
+    }
 
-    return ret;
+    return true;
 }
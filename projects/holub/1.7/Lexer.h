@@ -33,19 +33,41 @@
 #define LEXER_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include "Tokens.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd              = 0, /* End of input */
-    TokenSemicolon        = 1, /* ; */
-    TokenAdd              = 2, /* + */
-    TokenMultiply         = 3, /* * */
-    TokenLeftParenthesis  = 4, /* ( */
-    TokenRightParenthesis = 5, /* ) */
-    TokenNumericOrID      = 6  /* Decimal number or identifier */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
+/*
+ * A set of tokens, with one bit per token, so that checking the lookahead
+ * against a FIRST set is a single AND.
+ */
+typedef uint32_t TokenSet;
+
+#define TOKEN_SET( token ) ( ( TokenSet )1 << ( unsigned int )( token ) )
+
+_Static_assert( TokenCount <= sizeof( TokenSet ) * 8, "Too many tokens for a TokenSet" );
+
+/*
+ * Expands a list of tokens from Tokens.h, such as FIRST_EXPRESSION, into
+ * a constant TokenSet.
+ */
+#define TOKEN_SET_MEMBER( token ) | TOKEN_SET( token )
+#define TOKEN_SET_OF( LIST )      ( ( TokenSet )0 LIST( TOKEN_SET_MEMBER ) )
+
 const char * Lexer_GetText( void );
 size_t       Lexer_GetLength( void );
 size_t       Lexer_GetLine( void );
@@ -54,5 +76,6 @@ Token Lexer_Next( void );
 void  Lexer_Advance( void );
 bool  Lexer_Match( Token token );
 bool  Lexer_LegalLookahead( Token first, ... );
+bool  Lexer_LegalLookaheadSet( TokenSet set );
 
 #endif /* LEXER_H */
@@ -34,6 +34,11 @@
 #include "Print.h"
 #include <stdio.h>
 
+/*
+ * FIRST( expression ) = FIRST( term ) = FIRST( factor )
+ */
+static const TokenSet Parser_First = TOKEN_SET_OF( FIRST_EXPRESSION );
+
 /*
  * statements -> expression SEMICOLON | expression SEMI statements
  */
@@ -60,7 +65,7 @@ void Parser_Statements( void )
  */
 void Parser_Expression( void )
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return;
     }
@@ -80,7 +85,7 @@ void Parser_Expression( void )
  */
 void Parser_Term( void )
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return;
     }
@@ -97,7 +102,7 @@ void Parser_Term( void )
 /* factor -> NUMERIC_OR_ID | LEFT_PARENTHESIS expression RIGHT_PARENTHESIS */
 void Parser_Factor( void )
 {
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return;
     }
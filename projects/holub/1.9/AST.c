@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        AST.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "AST.h"
+#include "Print.h"
+#include <stdlib.h>
+
+/*
+ * All nodes live in one block, grown by doubling, so a tree is dense in
+ * memory and freed at once.
+ */
+static ASTNode * AST_Nodes    = NULL;
+static size_t    AST_Count    = 0;
+static size_t    AST_Capacity = 0;
+
+/*
+ * Appends a node. The input is addressed with 32 bits, and tokens with
+ * 24, which is checked here rather than silently truncated.
+ */
+ASTIndex AST_NewNode( ASTKind kind, Span span, ASTIndex left, ASTIndex right )
+{
+    ASTNode * node;
+
+    if( span.offset > UINT32_MAX || span.length > 0xFFFFFF )
+    {
+        Error( "Input too large for the syntax tree" );
+        abort();
+    }
+
+    if( AST_Count == AST_Capacity )
+    {
+        ASTNode * nodes;
+        size_t    capacity;
+
+        capacity = ( AST_Capacity == 0 ) ? 1024 : AST_Capacity * 2;
+
+        if( capacity > AST_NONE || ( nodes = realloc( AST_Nodes, capacity * sizeof( ASTNode ) ) ) == NULL )
+        {
+            Error( "Out of memory" );
+            abort();
+        }
+
+        AST_Nodes    = nodes;
+        AST_Capacity = capacity;
+    }
+
+    node         = &( AST_Nodes[ AST_Count ] );
+    node->kind   = ( uint32_t )kind & 0xFF;
+    node->length = ( uint32_t )span.length & 0xFFFFFF;
+    node->offset = ( uint32_t )span.offset;
+    node->left   = left;
+    node->right  = right;
+
+    return ( ASTIndex )( AST_Count++ );
+}
+
+/*
+ * Pointers to nodes are only valid until the next AST_NewNode.
+ */
+ASTNode * AST_GetNode( ASTIndex index )
+{
+    return &( AST_Nodes[ index ] );
+}
+
+Span AST_GetSpan( ASTIndex index )
+{
+    Span span;
+
+    span.offset = AST_Nodes[ index ].offset;
+    span.length = AST_Nodes[ index ].length;
+
+    return span;
+}
+
+size_t AST_GetCount( void )
+{
+    return AST_Count;
+}
+
+/*
+ * Drops every node, keeping the block for the next tree.
+ */
+void AST_Reset( void )
+{
+    AST_Count = 0;
+}
+
+void AST_Free( void )
+{
+    free( AST_Nodes );
+
+    AST_Nodes    = NULL;
+    AST_Count    = 0;
+    AST_Capacity = 0;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      AST.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef AST_H
+#define AST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Input.h"
+
+typedef uint32_t ASTIndex;
+
+#define AST_NONE ( ( ASTIndex )UINT32_MAX )
+
+typedef enum
+{
+    ASTKindName       = 0, /* A number or identifier */
+    ASTKindAdd        = 1,
+    ASTKindMultiply   = 2,
+    ASTKindStatements = 3  /* left is an expression, right the next statement */
+} ASTKind;
+
+/*
+ * Nodes refer to their children by index in the arena, and to the input
+ * by the span of their token, the operator of a binary node.
+ */
+typedef struct
+{
+    uint32_t kind   : 8;
+    uint32_t length : 24;
+    uint32_t offset;
+    ASTIndex left;
+    ASTIndex right;
+} ASTNode;
+
+_Static_assert( sizeof( ASTNode ) == 16, "AST nodes must fit in 16 bytes" );
+
+ASTIndex  AST_NewNode( ASTKind kind, Span span, ASTIndex left, ASTIndex right );
+ASTNode * AST_GetNode( ASTIndex index );
+Span      AST_GetSpan( ASTIndex index );
+size_t    AST_GetCount( void );
+void      AST_Reset( void );
+void      AST_Free( void );
+
+#endif /* AST_H */
@@ -34,6 +34,19 @@
 #include "Print.h"
 #include "Name.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Operators kept on the C stack by Parser_Generate before spilling to the
+ * heap.
+ */
+#define PARSER_SPINE 32
+
+/*
+ * FIRST( expression ) = FIRST( term ) = FIRST( factor )
+ */
+static const TokenSet Parser_First = TOKEN_SET_OF( FIRST_EXPRESSION );
 
 /*
  * statements -> expression SEMICOLON | expression SEMI statements
@@ -44,7 +57,7 @@ void Parser_Statements( void )
     {
         const char * tmp;
 
-        tmp = Parser_Expression();
+        tmp = Parser_Expression( NULL );
 
         if( Lexer_Match( TokenSemicolon ) )
         {
@@ -59,28 +72,92 @@ void Parser_Statements( void )
     }
 }
 
+/*
+ * Parses the statements into the syntax tree instead of generating code,
+ * and returns the first one, each being linked to the next.
+ */
+ASTIndex Parser_Tree( void )
+{
+    ASTIndex first;
+    ASTIndex last;
+
+    first = AST_NONE;
+    last  = AST_NONE;
+
+    while( Lexer_Match( TokenEnd ) == false )
+    {
+        ASTIndex expression;
+        ASTIndex statement;
+
+        Parser_Expression( &expression );
+
+        statement = AST_NewNode( ASTKindStatements, Lexer_GetSpan(), expression, AST_NONE );
+
+        if( last == AST_NONE )
+        {
+            first = statement;
+        }
+        else
+        {
+            AST_GetNode( last )->right = statement;
+        }
+
+        last = statement;
+
+        if( Lexer_Match( TokenSemicolon ) )
+        {
+            Lexer_Advance();
+        }
+        else
+        {
+            Warning( "Inserting missing semicolon" );
+        }
+    }
+
+    return first;
+}
+
 /*
  * expression  -> term expression'
  * expression' -> ADD term expression' | epsilon
+ *
+ * With a node, builds the tree of the expression there instead of
+ * generating its code, and returns NULL. So do the term and factor.
  */
-const char * Parser_Expression( void )
+const char * Parser_Expression( ASTIndex * node )
 {
     const char * tmp1;
 
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( node != NULL )
+    {
+        *( node ) = AST_NONE;
+    }
+
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return NULL;
     }
 
-    tmp1 = Parser_Term();
+    tmp1 = Parser_Term( node );
 
     while( Lexer_Match( TokenAdd ) )
     {
         const char * tmp2;
+        ASTIndex     right;
+        Span         span;
+
+        span = Lexer_GetSpan();
 
         Lexer_Advance();
 
-        tmp2 = Parser_Term();
+        tmp2 = Parser_Term( ( node == NULL ) ? NULL : &right );
+
+        if( node != NULL )
+        {
+            *( node ) = AST_NewNode( ASTKindAdd, span, *( node ), right );
+
+            continue;
+        }
 
         Debug( "%s += %s", tmp1, tmp2 );
 
@@ -94,24 +171,40 @@ const char * Parser_Expression( void )
  * term  -> factor term'
  * term' -> MULTIPLY factor term' | epsilon
  */
-const char * Parser_Term( void )
+const char * Parser_Term( ASTIndex * node )
 {
     const char * tmp1;
 
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( node != NULL )
+    {
+        *( node ) = AST_NONE;
+    }
+
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return NULL;
     }
 
-    tmp1 = Parser_Factor();
+    tmp1 = Parser_Factor( node );
 
     while( Lexer_Match( TokenMultiply ) )
     {
         const char * tmp2;
+        ASTIndex     right;
+        Span         span;
+
+        span = Lexer_GetSpan();
 
         Lexer_Advance();
 
-        tmp2 = Parser_Factor();
+        tmp2 = Parser_Factor( ( node == NULL ) ? NULL : &right );
+
+        if( node != NULL )
+        {
+            *( node ) = AST_NewNode( ASTKindMultiply, span, *( node ), right );
+
+            continue;
+        }
 
         Debug( "%s *= %s", tmp1, tmp2 );
 
@@ -122,27 +215,40 @@ const char * Parser_Term( void )
 }
 
 /* factor -> NUMERIC_OR_ID | LEFT_PARENTHESIS expression RIGHT_PARENTHESIS */
-const char * Parser_Factor( void )
+const char * Parser_Factor( ASTIndex * node )
 {
     const char * tmp;
 
     tmp = NULL;
 
-    if( Lexer_LegalLookahead( TokenNumericOrID, TokenLeftParenthesis, TokenEnd ) == false )
+    if( node != NULL )
+    {
+        *( node ) = AST_NONE;
+    }
+
+    if( Lexer_LegalLookaheadSet( Parser_First ) == false )
     {
         return NULL;
     }
 
     if( Lexer_Match( TokenNumericOrID ) )
     {
-        Debug( "%s = %1.*s", tmp = Name_NewName(), Lexer_GetLength(), Lexer_GetText() );
+        if( node != NULL )
+        {
+            *( node ) = AST_NewNode( ASTKindName, Lexer_GetSpan(), AST_NONE, AST_NONE );
+        }
+        else
+        {
+            Debug( "%s = %1.*s", tmp = Name_NewName(), Lexer_GetLength(), Lexer_GetText() );
+        }
+
         Lexer_Advance();
     }
     else if( Lexer_Match( TokenLeftParenthesis ) )
     {
         Lexer_Advance();
 
-        tmp = Parser_Expression();
+        tmp = Parser_Expression( node );
 
         if( Lexer_Match( TokenRightParenthesis ) )
         {
@@ -160,3 +266,97 @@ const char * Parser_Factor( void )
 
     return tmp;
 }
+
+/*
+ * Generates the code of a tree built by Parser_Tree, the same as parsing
+ * without a tree does, and returns the temporary holding the value of an
+ * expression. Missing nodes, left by syntax errors, have none.
+ * The whole input was read by then, so each line is tagged with the line
+ * of its node, a name or an operator, rather than the lexer's.
+ * Chains like a + b + c lean left, so the left operands are walked with a
+ * loop, keeping the operators on an explicit stack, and the depth of the
+ * recursion only grows with the nesting of parentheses, as when parsing.
+ */
+const char * Parser_Generate( ASTIndex node )
+{
+    ASTIndex     inlineSpine[ PARSER_SPINE ];
+    ASTIndex *   spine;
+    size_t       count;
+    size_t       capacity;
+    const char * tmp1;
+
+    if( node == AST_NONE )
+    {
+        return NULL;
+    }
+
+    if( AST_GetNode( node )->kind == ASTKindStatements )
+    {
+        for( ; node != AST_NONE; node = AST_GetNode( node )->right )
+        {
+            Name_FreeName( Parser_Generate( AST_GetNode( node )->left ) );
+        }
+
+        return NULL;
+    }
+
+    spine    = inlineSpine;
+    capacity = PARSER_SPINE;
+    count    = 0;
+    tmp1     = NULL;
+
+    while( node != AST_NONE && AST_GetNode( node )->kind != ASTKindName )
+    {
+        if( count == capacity )
+        {
+            ASTIndex * grown;
+
+            if( ( grown = malloc( capacity * 2 * sizeof( ASTIndex ) ) ) == NULL )
+            {
+                Error( "Out of memory" );
+                abort();
+            }
+
+            memcpy( grown, spine, count * sizeof( ASTIndex ) );
+
+            if( spine != inlineSpine )
+            {
+                free( spine );
+            }
+
+            spine     = grown;
+            capacity *= 2;
+        }
+
+        spine[ count++ ] = node;
+        node             = AST_GetNode( node )->left;
+    }
+
+    if( node != AST_NONE )
+    {
+        Span span;
+
+        span = AST_GetSpan( node );
+
+        DebugAt( Input_GetLine( span.offset ), "%s = %1.*s", tmp1 = Name_NewName(), ( int )span.length, Input_GetBytes( span ) );
+    }
+
+    while( count > 0 )
+    {
+        ASTIndex     op;
+        const char * tmp2;
+
+        op   = spine[ --count ];
+        tmp2 = Parser_Generate( AST_GetNode( op )->right );
+
+        DebugAt( Input_GetLine( AST_GetSpan( op ).offset ), ( AST_GetNode( op )->kind == ASTKindAdd ) ? "%s += %s" : "%s *= %s", tmp1, tmp2 );
+        Name_FreeName( tmp2 );
+    }
+
+    if( spine != inlineSpine )
+    {
+        free( spine );
+    }
+
+    return tmp1;
+}
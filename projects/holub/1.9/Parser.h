@@ -32,9 +32,13 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "AST.h"
+
 void         Parser_Statements( void );
-const char * Parser_Expression( void );
-const char * Parser_Term( void );
-const char * Parser_Factor( void );
+ASTIndex     Parser_Tree( void );
+const char * Parser_Expression( ASTIndex * node );
+const char * Parser_Term( ASTIndex * node );
+const char * Parser_Factor( ASTIndex * node );
+const char * Parser_Generate( ASTIndex node );
 
 #endif /* PARSER_H */
@@ -39,10 +39,10 @@
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
 #endif
 
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap );
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap )
+void Print( FILE * fh, const char * level, size_t line, const char * fmt, va_list ap );
+void Print( FILE * fh, const char * level, size_t line, const char * fmt, va_list ap )
 {
-    fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, Lexer_GetLine() );
+    fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, line );
     vfprintf( fh, fmt, ap );
     fprintf( fh, "\n" );
 }
@@ -56,7 +56,7 @@ void Error( const char * fmt, ... )
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "ERROR", fmt, ap );
+    Print( stderr, "ERROR", Lexer_GetLine(), fmt, ap );
     va_end( ap );
 }
 
@@ -65,7 +65,7 @@ void Warning( const char * fmt, ... )
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "WARNING", fmt, ap );
+    Print( stderr, "WARNING", Lexer_GetLine(), fmt, ap );
     va_end( ap );
 }
 
@@ -74,6 +74,19 @@ void Debug( const char * fmt, ... )
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stdout, "DEBUG", fmt, ap );
+    Print( stdout, "DEBUG", Lexer_GetLine(), fmt, ap );
+    va_end( ap );
+}
+
+/*
+ * Debug output for a given line, rather than the line of the current
+ * token, for code generated once the whole input was parsed.
+ */
+void DebugAt( size_t line, const char * fmt, ... )
+{
+    va_list ap;
+
+    va_start( ap, fmt );
+    Print( stdout, "DEBUG", line, fmt, ap );
     va_end( ap );
 }
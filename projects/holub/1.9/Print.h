@@ -32,8 +32,11 @@
 #ifndef PRINT_H
 #define PRINT_H
 
+#include <stddef.h>
+
 void Error( const char * fmt, ... );
 void Warning( const char * fmt, ... );
 void Debug( const char * fmt, ... );
+void DebugAt( size_t line, const char * fmt, ... );
 
 #endif /* PRINT_H */
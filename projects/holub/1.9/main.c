@@ -30,11 +30,48 @@
  */
 
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
 #include "Parser.h"
+#include "Input.h"
+#include "AST.h"
 
-int main( void )
+int main( int argc, char * argv[] )
 {
-    Parser_Statements();
+    const char * path;
+    bool         tree;
+
+    path = NULL;
+    tree = false;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[ i ], "--ast" ) == 0 )
+        {
+            tree = true;
+        }
+        else
+        {
+            path = argv[ i ];
+        }
+    }
+
+    if( path != NULL && Input_OpenFile( path ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( tree )
+    {
+        Parser_Generate( Parser_Tree() );
+        AST_Free();
+    }
+    else
+    {
+        Parser_Statements();
+    }
+
+    Input_Close();
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Input.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Input.h"
+#include "Print.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/*
+ * Size of a single read() when streaming.
+ * The whole input is kept for the duration of the compilation, so spans
+ * remain valid. The buffer always has room for at least one more block
+ * after the data it holds, and doubles when it doesn't.
+ */
+#define INPUT_BLOCK_SIZE 65536
+
+static char   Input_Empty[ 1 ] = { 0 };
+static char * Input_Buffer     = Input_Empty;
+static char * Input_End        = Input_Empty;
+static size_t Input_Size       = 0;
+static size_t Input_MapSize    = 0;
+static bool   Input_Mapped     = false;
+static bool   Input_EOF        = false;
+
+/*
+ * Maps the whole file read-only, so the lexer can scan it in place.
+ * The mapping is placed over an anonymous region one byte larger than the
+ * file, which guarantees a NUL sentinel right after the last character,
+ * even when the file size is a multiple of the page size.
+ */
+bool Input_OpenFile( const char * path )
+{
+    int         fd;
+    struct stat st;
+    size_t      size;
+    size_t      page;
+    char *      map;
+
+    Input_Close();
+
+    if( ( fd = open( path, O_RDONLY ) ) < 0 )
+    {
+        Error( "Cannot open %s: %s", path, strerror( errno ) );
+
+        return false;
+    }
+
+    if( fstat( fd, &st ) != 0 || S_ISREG( st.st_mode ) == false )
+    {
+        Error( "Cannot map %s: not a regular file", path );
+        close( fd );
+
+        return false;
+    }
+
+    Input_Mapped = true;
+    size         = ( size_t )( st.st_size );
+
+    if( size == 0 )
+    {
+        close( fd );
+
+        return true;
+    }
+
+    page = ( size_t )sysconf( _SC_PAGESIZE );
+    size = ( ( size + 1 + page - 1 ) / page ) * page;
+    map  = mmap( NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0 );
+
+    if( map == MAP_FAILED )
+    {
+        Error( "Cannot map %s: %s", path, strerror( errno ) );
+        close( fd );
+        Input_Close();
+
+        return false;
+    }
+
+    if( mmap( map, ( size_t )( st.st_size ), PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0 ) == MAP_FAILED )
+    {
+        Error( "Cannot map %s: %s", path, strerror( errno ) );
+        munmap( map, size );
+        close( fd );
+        Input_Close();
+
+        return false;
+    }
+
+    close( fd );
+
+#ifdef MADV_SEQUENTIAL
+    madvise( map, size, MADV_SEQUENTIAL );
+#endif
+
+    Input_Buffer  = map;
+    Input_End     = map + st.st_size;
+    Input_MapSize = size;
+
+    return true;
+}
+
+void Input_Close( void )
+{
+    if( Input_Mapped && Input_MapSize > 0 )
+    {
+        munmap( Input_Buffer, Input_MapSize );
+    }
+    else if( Input_Size > 0 )
+    {
+        free( Input_Buffer );
+    }
+
+    Input_Buffer  = Input_Empty;
+    Input_End     = Input_Empty;
+    Input_Size    = 0;
+    Input_MapSize = 0;
+    Input_Mapped  = false;
+    Input_EOF     = false;
+}
+
+char * Input_GetStart( void )
+{
+    return Input_Buffer;
+}
+
+/*
+ * Tells whether a NUL byte seen by the lexer is the sentinel placed after
+ * the buffered data, as opposed to a NUL byte in the input itself.
+ */
+bool Input_IsEnd( const char * current )
+{
+    return current == Input_End;
+}
+
+size_t Input_GetOffset( const char * p )
+{
+    return ( size_t )( p - Input_Buffer );
+}
+
+/*
+ * Spans are offsets into the input, so they stay valid even if the buffer
+ * moves, but the returned pointer is only valid until the next refill.
+ */
+const char * Input_GetBytes( Span span )
+{
+    return Input_Buffer + span.offset;
+}
+
+bool Input_SpanEquals( Span span, const char * s )
+{
+    return strncmp( Input_Buffer + span.offset, s, span.length ) == 0 && s[ span.length ] == 0;
+}
+
+/*
+ * Called by the lexer when it reaches the sentinel.
+ * The next block is read right after the data already held, so a token
+ * spanning two reads is never split nor truncated, and nothing is moved
+ * unless the buffer needs to grow. Both pointers are updated if it does.
+ * Returns false at end of input, or if current isn't at the sentinel.
+ */
+bool Input_Fill( char ** mark, char ** current )
+{
+    size_t  used;
+    size_t  offset;
+    ssize_t n;
+
+    if( *( current ) != Input_End || Input_Mapped || Input_EOF )
+    {
+        return false;
+    }
+
+    used   = ( size_t )( Input_End - Input_Buffer );
+    offset = ( size_t )( *( mark ) - Input_Buffer );
+
+    if( used + INPUT_BLOCK_SIZE > Input_Size )
+    {
+        size_t size;
+        char * buffer;
+
+        size = ( Input_Size == 0 ) ? INPUT_BLOCK_SIZE * 2 : Input_Size * 2;
+
+        if( ( buffer = realloc( ( Input_Size == 0 ) ? NULL : Input_Buffer, size + 1 ) ) == NULL )
+        {
+            Error( "Out of memory" );
+            abort();
+        }
+
+        Input_Buffer = buffer;
+        Input_Size   = size;
+    }
+
+    do
+    {
+        n = read( STDIN_FILENO, Input_Buffer + used, Input_Size - used );
+    }
+    while( n < 0 && errno == EINTR );
+
+    if( n < 0 )
+    {
+        Error( "Cannot read input: %s", strerror( errno ) );
+    }
+
+    if( n <= 0 )
+    {
+        n         = 0;
+        Input_EOF = true;
+    }
+
+    Input_End      = Input_Buffer + used + n;
+    *( Input_End ) = 0;
+    *( mark )      = Input_Buffer + offset;
+    *( current )   = Input_Buffer + used;
+
+    return n > 0;
+}
@@ -31,14 +31,16 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 
-static char * Lexer_Text      = "";
+static char * Lexer_Text      = NULL;
 static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
+static size_t Lexer_Line      = 1;
 static int    Lexer_Lookahead = -1;
 
 const char * Lexer_GetText( void )
@@ -56,97 +58,168 @@ size_t Lexer_GetLine( void )
     return Lexer_Line;
 }
 
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    const char * name;
+    size_t       length;
+    Token        token;
+} Keyword;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+#define KEYWORD_ENTRY( text, token ) { text, sizeof( text ) - 1, token },
+
+static const Keyword Lexer_Keywords[] =
+{
+    KEYWORDS( KEYWORD_ENTRY )
+};
+
+#undef KEYWORD_ENTRY
+
+static bool Lexer_IsKeyword( Token * token )
+{
+    for( size_t i = 0; i < sizeof( Lexer_Keywords ) / sizeof( *( Lexer_Keywords ) ); i++ )
+    {
+        if( Lexer_Keywords[ i ].length == Lexer_Length && memcmp( Lexer_Keywords[ i ].name, Lexer_Text, Lexer_Length ) == 0 )
+        {
+            *( token ) = Lexer_Keywords[ i ].token;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: Debug( "Token: " text ); return name;
+
 Token Lexer_Next( void )
 {
-    static char buf[ 128 ];
-    char *      current;
+    char * current;
+    Token  token;
 
-    current = Lexer_Text + Lexer_Length;
+    current = ( Lexer_Text == NULL ) ? Input_GetStart() : Lexer_Text + Lexer_Length;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        Lexer_Text   = current;
+        Lexer_Length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( &Lexer_Text, &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( current ) )
+                {
+                    Lexer_Length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                Error( "Ignoring illegal input: NUL" );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
+                break;
 
-            switch( *( current ) )
-            {
-                case EOF: Debug( "Token: End" ); return TokenEnd;
-                case ';': Debug( "Token: ;" ); return TokenSemicolon;
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
+
+            case '\n':
+
+                Lexer_Line++;
+                current++;
+
+                break;
+
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
 
-                case '\n':
-                case '\t':
-                case ' ':
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Error( "Ignoring illegal input: %c", *( current ) );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Error( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
                         current++;
                     }
+                }
+                while( Input_Fill( &Lexer_Text, &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
 
-                    Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
+                Debug( "Token: %1.*s", Lexer_Length, Lexer_Text );
 
-                    {
-                        static const char * types[] = {
-                            "int",
-                            "char",
-                            "long",
-                            "float",
-                            "double",
-                            "signed",
-                            "unsigned",
-                            "short",
-                            "const",
-                            "volatile"
-                        };
-
-                        for( size_t i = 0; i < sizeof( types ) / sizeof( *( types ) ); i++ )
-                        {
-                            if( strncmp( types[ i ], Lexer_Text, Lexer_Length ) == 0 )
-                            {
-                                return TokenType;
-                            }
-                        }
-                    }
+                if( Lexer_IsKeyword( &token ) )
+                {
+                    return token;
+                }
 
-                    return TokenID;
-            }
+                return TokenID;
         }
     }
 }
 
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
 void Lexer_Advance( void )
 {
     Lexer_Lookahead = ( int )( Lexer_Next() );
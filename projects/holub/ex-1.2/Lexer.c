@@ -31,14 +31,16 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 
-static char * Lexer_Text      = "";
+static char * Lexer_Text      = NULL;
 static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
+static size_t Lexer_Line      = 1;
 static int    Lexer_Lookahead = -1;
 
 const char * Lexer_GetText( void )
@@ -61,101 +63,196 @@ Token Lexer_GetCurrent( void )
     return ( Token )Lexer_Lookahead;
 }
 
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    const char * name;
+    size_t       length;
+    Token        token;
+} Keyword;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+#define KEYWORD_ENTRY( text, token ) { text, sizeof( text ) - 1, token },
+
+static const Keyword Lexer_Keywords[] =
+{
+    KEYWORDS( KEYWORD_ENTRY )
+};
+
+#undef KEYWORD_ENTRY
+
+static bool Lexer_IsKeyword( Token * token )
+{
+    for( size_t i = 0; i < sizeof( Lexer_Keywords ) / sizeof( *( Lexer_Keywords ) ); i++ )
+    {
+        if( Lexer_Keywords[ i ].length == Lexer_Length && memcmp( Lexer_Keywords[ i ].name, Lexer_Text, Lexer_Length ) == 0 )
+        {
+            *( token ) = Lexer_Keywords[ i ].token;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: return name;
+
 Token Lexer_Next( void )
 {
-    static char buf[ 128 ];
-    char *      current;
+    char * current;
+    Token  token;
 
-    current = Lexer_Text + Lexer_Length;
+    current = ( Lexer_Text == NULL ) ? Input_GetStart() : Lexer_Text + Lexer_Length;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        Lexer_Text   = current;
+        Lexer_Length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( &Lexer_Text, &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( current ) )
+                {
+                    Lexer_Length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                Warning( "Ignoring illegal input: NUL" );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
+                break;
 
-            switch( *( current ) )
-            {
-                case EOF: return TokenEnd;
-                case ';': return TokenSemicolon;
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
 
-                case '\n':
-                case '\t':
-                case ' ':
+            case '\n':
+
+                Lexer_Line++;
+                current++;
+
+                break;
+
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
+
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Warning( "Ignoring illegal input: %c", *( current ) );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Warning( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
                         current++;
                     }
+                }
+                while( Input_Fill( &Lexer_Text, &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
 
-                    if( Lexer_Compare( "const" ) )
-                    {
-                        return TokenConst;
-                    }
-                    else if( Lexer_Compare( "volatile" ) )
-                    {
-                        return TokenVolatile;
-                    }
-                    else if( Lexer_Compare( "signed" ) || Lexer_Compare( "unsigned" ) )
-                    {
-                        return TokenSign;
-                    }
-                    else if( Lexer_Compare( "short" ) || Lexer_Compare( "long" ) )
-                    {
-                        return TokenSize;
-                    }
-                    else if( Lexer_Compare( "char" ) || Lexer_Compare( "int" ) || Lexer_Compare( "float" ) || Lexer_Compare( "double" ) )
-                    {
-                        return TokenType;
-                    }
+                if( Lexer_IsKeyword( &token ) )
+                {
+                    return token;
+                }
 
-                    return TokenID;
-            }
+                return TokenID;
         }
     }
 }
 
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
 void Lexer_Advance( void )
 {
     Lexer_Lookahead = ( int )( Lexer_Next() );
 }
 
+/*
+ * Discards the rest of the current line.
+ */
 void Lexer_Discard( void )
 {
-    Lexer_Text      = "";
+    char * current;
+
+    current = ( Lexer_Text == NULL ) ? Input_GetStart() : Lexer_Text + Lexer_Length;
+
+    while( *( current ) != '\n' )
+    {
+        if( *( current ) == 0 && Input_IsEnd( current ) )
+        {
+            if( Input_Fill( &current, &current ) == false )
+            {
+                break;
+            }
+        }
+        else
+        {
+            current++;
+        }
+    }
+
+    Lexer_Text      = current;
     Lexer_Length    = 0;
     Lexer_Lookahead = -1;
 }
@@ -172,7 +269,7 @@ bool Lexer_Match( Token token )
 
 bool Lexer_Compare( const char * value )
 {
-    return strncmp( value, Lexer_Text, Lexer_Length ) == 0;
+    return strlen( value ) == Lexer_Length && strncmp( value, Lexer_Text, Lexer_Length ) == 0;
 }
 
 bool Lexer_LegalLookahead( Token first, ... )
@@ -34,19 +34,22 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "Tokens.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd       = 0, /* End of input */
-    TokenSemicolon = 1, /* ; */
-    TokenConst     = 2, /* const */
-    TokenVolatile  = 3, /* volatile */
-    TokenSign      = 4, /* signed, unsigned */
-    TokenSize      = 5, /* short, long, long long */
-    TokenType      = 6, /* Type */
-    TokenID        = 7  /* Identifier */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
 const char * Lexer_GetText( void );
 size_t       Lexer_GetLength( void );
 size_t       Lexer_GetLine( void );
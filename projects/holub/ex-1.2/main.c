@@ -31,10 +31,17 @@
 
 #include <stdlib.h>
 #include "Parser.h"
+#include "Input.h"
 
-int main( void )
+int main( int argc, char * argv[] )
 {
+    if( argc > 1 && Input_OpenFile( argv[ 1 ] ) == false )
+    {
+        return EXIT_FAILURE;
+    }
+
     Parser_Statements();
+    Input_Close();
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,558 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Bench.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Bench.h"
+#include "Input.h"
+#include "Lexer.h"
+#include "TokenStream.h"
+#include "DFA.h"
+#include "Parser.h"
+#include "LALR.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BENCH_SIZE   ( 64 * 1024 * 1024 )
+#define BENCH_ROUNDS 5
+#define BENCH_STACK  ( 64 * 1024 )
+
+static volatile uintptr_t Bench_Area = 0;
+
+static double Bench_Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( double )ts.tv_sec + ( double )ts.tv_nsec / 1e9;
+}
+
+/*
+ * Writes one declaration, with random qualifiers, pointers and array
+ * sizes. Valid declarations only combine qualifiers their type accepts,
+ * and never use a keyword as identifier, so that a parser stopping on the
+ * first error reads them all.
+ */
+static void Bench_WriteDeclaration( FILE * fh, bool valid )
+{
+    static const char * const sizes[] = { "", "short ", "long " };
+    static const char * const types[] = { "char", "int", "float", "double" };
+    static const char * const words[] = { "const", "volatile", "signed", "unsigned", "short", "long", "char", "int", "float", "double" };
+    char                      id[ 13 ];
+    const char *              sign;
+    int                       size;
+    int                       type;
+    bool                      keyword;
+
+    fputs( ( rand() % 4 == 0 ) ? "const " : "", fh );
+    fputs( ( rand() % 8 == 0 ) ? "volatile " : "", fh );
+
+    sign = ( rand() % 4 == 0 ) ? ( ( rand() % 2 ) ? "signed " : "unsigned " ) : "";
+    size = rand() % 3;
+    type = rand() % 4;
+
+    if( valid )
+    {
+        sign = ( type <= 1 ) ? sign : "";
+        size = ( type == 0 || type == 2 || ( type == 3 && size == 1 ) ) ? 0 : size;
+    }
+
+    fputs( sign, fh );
+    fputs( sizes[ size ], fh );
+    fputs( types[ type ], fh );
+    fputs( " ", fh );
+
+    for( int i = rand() % 3; i > 0; i-- )
+    {
+        fputs( "*", fh );
+    }
+
+    do
+    {
+        int length;
+
+        length = 1 + rand() % 12;
+
+        for( int i = 0; i < length; i++ )
+        {
+            id[ i ] = "abcdefghijklmnopqrstuvwxyz0123456789"[ rand() % ( ( i == 0 ) ? 26 : 36 ) ];
+        }
+
+        id[ length ] = 0;
+        keyword      = false;
+
+        for( size_t i = 0; valid && i < sizeof( words ) / sizeof( *( words ) ); i++ )
+        {
+            keyword = keyword || strcmp( id, words[ i ] ) == 0;
+        }
+    }
+    while( keyword );
+
+    fputs( id, fh );
+
+    if( rand() % 4 == 0 )
+    {
+        fprintf( fh, "[ %d ]", ( valid ) ? 1 + rand() % 999 : rand() % 1000 );
+    }
+
+    fputs( ";\n", fh );
+}
+
+/*
+ * Writes BENCH_SIZE bytes of declarations to a temporary file, and maps
+ * it.
+ */
+static InputRef Bench_CreateInput( bool valid )
+{
+    char     path[] = "/tmp/holub-bench-XXXXXX";
+    int      fd;
+    FILE *   fh;
+    InputRef input;
+
+    if( ( fd = mkstemp( path ) ) < 0 || ( fh = fdopen( fd, "w" ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    srand( 42 );
+
+    while( ftell( fh ) < BENCH_SIZE )
+    {
+        Bench_WriteDeclaration( fh, valid );
+    }
+
+    fclose( fh );
+
+    input = Input_CreateWithFile( path );
+
+    unlink( path );
+
+    return input;
+}
+
+/*
+ * Lexes the whole input into a token stream, and returns the throughput
+ * in MB/s.
+ */
+static double Bench_Lex( InputRef input, size_t size )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        LexerRef lexer;
+        double   start;
+        double   elapsed;
+        bool     ok;
+
+        if( ( lexer = Lexer_Create( input ) ) == NULL )
+        {
+            return 0;
+        }
+
+        start   = Bench_Now();
+        ok      = Lexer_Tokenize( lexer );
+        elapsed = Bench_Now() - start;
+
+        Lexer_Release( lexer );
+
+        if( ok == false )
+        {
+            return 0;
+        }
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Scans the whole input into a token stream with the table-driven scanner
+ * generated from DFA.l, and returns the throughput in MB/s. The stream of
+ * the last round is kept for comparison.
+ */
+static double Bench_Match( InputRef input, size_t size, TokenStreamRef * tokens )
+{
+    double best;
+
+    best = 0;
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        TokenStreamRef stream;
+        const char *   text;
+        const char *   p;
+        double         start;
+        double         elapsed;
+        bool           ok;
+
+        if( ( stream = TokenStream_Create() ) == NULL )
+        {
+            return 0;
+        }
+
+        text  = Input_GetStart( input );
+        p     = text;
+        ok    = true;
+        start = Bench_Now();
+
+        while( ok && *( p ) != 0 )
+        {
+            size_t length;
+            int    kind;
+
+            kind = DFA_Match( p, &length );
+
+            if( kind >= 0 )
+            {
+                ok = TokenStream_Append( stream, ( uint8_t )kind, ( uint64_t )( p - text ), ( uint32_t )length, 0, SYMBOL_NONE );
+            }
+
+            p += length;
+        }
+
+        ok      = ok && TokenStream_Append( stream, ( uint8_t )TokenEnd, ( uint64_t )( p - text ), 0, 0, SYMBOL_NONE );
+        elapsed = Bench_Now() - start;
+
+        TokenStream_Release( *( tokens ) );
+
+        *( tokens ) = stream;
+
+        if( ok == false )
+        {
+            return 0;
+        }
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Checks that the lexer produces the same tokens as the stream.
+ */
+static bool Bench_Compare( InputRef input, TokenStreamRef tokens )
+{
+    LexerRef         lexer;
+    const uint8_t *  kinds;
+    const uint64_t * offsets;
+    const uint32_t * lengths;
+    bool             ok;
+
+    if( ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        return false;
+    }
+
+    kinds   = TokenStream_GetKinds( tokens );
+    offsets = TokenStream_GetOffsets( tokens );
+    lengths = TokenStream_GetLengths( tokens );
+    ok      = Lexer_Tokenize( lexer );
+
+    for( size_t i = 0; ok && i < TokenStream_GetCount( tokens ); i++ )
+    {
+        Token token;
+
+        token = Lexer_Next( lexer );
+        ok    = kinds[ i ] == token && offsets[ i ] == ( uint64_t )( Lexer_GetText( lexer ) - Input_GetStart( input ) ) && lengths[ i ] == Lexer_GetLength( lexer );
+    }
+
+    Lexer_Release( lexer );
+
+    return ok;
+}
+
+/*
+ * Compares Lexer_Tokenize to the table-driven scanner generated from
+ * DFA.l, both filling a token stream from the same input. The lexer also
+ * interns identifiers, decodes numbers and counts lines, which the
+ * scanner leaves to its caller.
+ */
+int Bench_DFA( void )
+{
+    InputRef       input;
+    TokenStreamRef tokens;
+    double         lexer;
+    double         dfa;
+
+    if( ( input = Bench_CreateInput( false ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+
+        return EXIT_FAILURE;
+    }
+
+    tokens = NULL;
+
+    printf( "%-14s %8s    (MB/s)\n", "Scanner", "Lex" );
+
+    lexer = Bench_Lex( input, BENCH_SIZE );
+
+    printf( "%-14s %8.0f\n", "Hand-written", lexer );
+    fflush( stdout );
+
+    dfa = Bench_Match( input, BENCH_SIZE, &tokens );
+
+    printf( "%-14s %8.0f    x%.2f\n", "Table-driven", dfa, ( lexer > 0 ) ? dfa / lexer : 0 );
+
+    if( tokens == NULL || Bench_Compare( input, tokens ) == false )
+    {
+        fprintf( stderr, "The scanners produce different tokens\n" );
+
+        TokenStream_Release( tokens );
+        Input_Release( input );
+
+        return EXIT_FAILURE;
+    }
+
+    TokenStream_Release( tokens );
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
+
+/*
+ * Runs one of the parsers. It is never inlined, so that its stack usage
+ * starts where Bench_PaintStack painted.
+ */
+__attribute__( ( noinline ) )
+static void Bench_RunParser( LexerRef lexer, bool lalr )
+{
+    if( lalr )
+    {
+        LALR_Parse( lexer );
+    }
+    else
+    {
+        Parser_Statements( lexer );
+    }
+}
+
+/*
+ * Parses the whole input with the hand-written parser or the one
+ * generated from LALR.y, and returns the throughput in MB/s. Debug output
+ * goes to /dev/null meanwhile.
+ */
+static double Bench_Parse( InputRef input, size_t size, bool lalr )
+{
+    double best;
+    int    out;
+    int    null;
+
+    best = 0;
+
+    fflush( stdout );
+
+    if( ( out = dup( STDOUT_FILENO ) ) < 0 || ( null = open( "/dev/null", O_WRONLY ) ) < 0 )
+    {
+        return 0;
+    }
+
+    dup2( null, STDOUT_FILENO );
+    close( null );
+
+    for( int round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        LexerRef lexer;
+        double   start;
+        double   elapsed;
+
+        if( ( lexer = Lexer_Create( input ) ) == NULL )
+        {
+            break;
+        }
+
+        start = Bench_Now();
+
+        Bench_RunParser( lexer, lalr );
+        Lexer_Release( lexer );
+
+        elapsed = Bench_Now() - start;
+
+        if( elapsed > 0 && ( double )size / elapsed / 1e6 > best )
+        {
+            best = ( double )size / elapsed / 1e6;
+        }
+    }
+
+    fflush( stdout );
+    dup2( out, STDOUT_FILENO );
+    close( out );
+
+    return best;
+}
+
+/*
+ * Fills the stack below the caller with a pattern, which calls made after
+ * it overwrite as deep as they go, and remembers where it is.
+ */
+__attribute__( ( noinline ) )
+static void Bench_PaintStack( void )
+{
+    volatile unsigned char area[ BENCH_STACK ];
+
+    for( size_t i = 0; i < BENCH_STACK; i++ )
+    {
+        area[ i ] = 0xA5;
+    }
+
+    Bench_Area = ( uintptr_t )area;
+}
+
+/*
+ * Returns how deep into the painted stack the calls made since
+ * Bench_PaintStack went, as the stack grows down.
+ */
+static size_t Bench_MeasureStack( void )
+{
+    const volatile unsigned char * area;
+    size_t                         i;
+
+    area = ( const volatile unsigned char * )Bench_Area;
+    i    = 0;
+
+    while( i < BENCH_STACK && area[ i ] == 0xA5 )
+    {
+        i++;
+    }
+
+    return BENCH_STACK - i;
+}
+
+/*
+ * Parses the input once, and returns the peak stack usage of the parser
+ * in bytes: on the C stack, and in heap, where the LALR(1) parser moves
+ * its stack once it is nested too deep. The hand-written parser only uses
+ * the C stack.
+ */
+static size_t Bench_Stack( InputRef input, bool lalr, size_t * heap )
+{
+    LexerRef lexer;
+    size_t   stack;
+    int      out;
+    int      null;
+
+    *( heap ) = 0;
+
+    fflush( stdout );
+
+    if( ( out = dup( STDOUT_FILENO ) ) < 0 || ( null = open( "/dev/null", O_WRONLY ) ) < 0 )
+    {
+        return 0;
+    }
+
+    dup2( null, STDOUT_FILENO );
+    close( null );
+
+    if( ( lexer = Lexer_Create( input ) ) != NULL )
+    {
+        LALR_GetHeapPeak();
+        Bench_PaintStack();
+        Bench_RunParser( lexer, lalr );
+    }
+
+    stack     = Bench_MeasureStack();
+    *( heap ) = ( lalr ) ? LALR_GetHeapPeak() : 0;
+
+    Lexer_Release( lexer );
+    fflush( stdout );
+    dup2( out, STDOUT_FILENO );
+    close( out );
+
+    return ( lexer == NULL ) ? 0 : stack;
+}
+
+/*
+ * Compares the hand-written parser to the LALR(1) one generated from
+ * LALR.y, on declarations that are all valid: throughput in bytes and
+ * tokens, and peak stack usage, on the C stack and in heap.
+ */
+int Bench_LR( void )
+{
+    InputRef input;
+    LexerRef lexer;
+    size_t   tokens;
+    size_t   stack;
+    size_t   heap;
+    double   parser;
+    double   lalr;
+
+    if( ( input = Bench_CreateInput( true ) ) == NULL || ( lexer = Lexer_Create( input ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot create benchmark input\n" );
+        Input_Release( input );
+
+        return EXIT_FAILURE;
+    }
+
+    tokens = 0;
+
+    while( Lexer_GetLookahead( lexer ) != TokenEnd )
+    {
+        Lexer_Advance( lexer );
+
+        tokens++;
+    }
+
+    Lexer_Release( lexer );
+
+    printf( "%-14s %8s %8s %10s %10s\n", "Parser", "MB/s", "Mtok/s", "Stack", "Heap" );
+
+    parser = Bench_Parse( input, BENCH_SIZE, false );
+    stack  = Bench_Stack( input, false, &heap );
+
+    printf( "%-14s %8.0f %8.1f %10zu %10zu\n", "Hand-written", parser, parser * ( double )tokens / BENCH_SIZE, stack, heap );
+    fflush( stdout );
+
+    lalr  = Bench_Parse( input, BENCH_SIZE, true );
+    stack = Bench_Stack( input, true, &heap );
+
+    printf( "%-14s %8.0f %8.1f %10zu %10zu    x%.2f\n", "LALR(1)", lalr, lalr * ( double )tokens / BENCH_SIZE, stack, heap, ( parser > 0 ) ? lalr / parser : 0 );
+
+    Input_Release( input );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        DFA.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-lexgen from DFA.l, do not edit.
+ *              53 states, 27 byte classes, 42 distinct rows.
+ */
+
+#include "DFA.h"
+#include "Lexer.h"
+#include <stdint.h>
+
+/*
+ * Class of each input byte.
+ */
+static const uint8_t DFA_Classes[ 256 ] =
+{
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,   0,   0,   0,   0,   0,   0,   0,   2,   3,   4,   0,   0,   0,   0,   0,
+      5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   0,   6,   0,   0,   0,   0,
+      0,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,
+      7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   7,   8,   0,   9,   0,   0,
+      0,  10,  11,  12,  13,  14,  15,  16,  17,  18,   7,   7,  19,   7,  20,  21,
+      7,   7,  22,  23,  24,  25,  26,   7,   7,   7,   7,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0
+};
+
+/*
+ * Row of the transition table of each state. State 0 is the dead state,
+ * and state 1 the start state.
+ */
+static const uint8_t DFA_Rows[ 53 ] =
+{
+      0,   1,   2,   0,   0,   0,   3,   0,   4,   0,   0,   5,   6,   7,   8,   9,
+     10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,
+     26,   4,  27,  28,  29,  30,  31,  32,  33,   4,  34,  35,  36,   4,  37,  38,
+     39,   4,  40,  41,   4
+};
+
+static const uint8_t DFA_Transitions[ 42 ][ 27 ] =
+{
+    {
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0
+    },
+    {
+          0,   2,   3,   4,   5,   6,   7,   8,   9,  10,   8,   8,  11,  12,   8,  13,
+          8,   8,  14,  15,   8,   8,   8,  16,   8,  17,  18
+    },
+    {
+          0,   2,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+          0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0
+    },
+    {
+          0,   0,   0,   0,   0,   6,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,  19,   8,   8,   8,  20,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,  21,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,  22,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,  23,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,  24,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,  25,  26,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,  27,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,  28,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,  29,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,  30,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,  31,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,  32,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,  33,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,  34,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,  35,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+         36,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,  37,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,  38,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,  33,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,  39,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,  40,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,  23,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+         41,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,  42,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,  43,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,  26,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,  44,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,  45,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,  46,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,  41,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,  47,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,  48,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,  33,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,  49,   8,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,  50,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,   8,   8,
+          8,   8,   8,  51,   8,   8,   8,   8,   8,   8,   8
+    },
+    {
+          0,   0,   0,   0,   0,   8,   0,   8,   0,   0,   8,   8,   8,   8,  52,   8,
+          8,   8,   8,   8,   8,   8,   8,   8,   8,   8,   8
+    },
+};
+
+/*
+ * Rule accepted by each state.
+ */
+static const int DFA_Accept[ 53 ] =
+{
+    DFA_NONE,
+    DFA_NONE,
+    DFA_SKIP,
+    TokenLeftParenthesis,
+    TokenRightParenthesis,
+    TokenPointer,
+    TokenNumeric,
+    TokenSemicolon,
+    TokenID,
+    TokenLeftBracket,
+    TokenRightBracket,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenType,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenSize,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenConst,
+    TokenID,
+    TokenID,
+    TokenID,
+    TokenSign,
+    TokenID,
+    TokenID,
+    TokenVolatile,
+};
+
+int DFA_Match( const char * text, size_t * length )
+{
+    const unsigned char * p;
+    unsigned int          state;
+    int                   accept;
+    size_t                i;
+
+    p           = ( const unsigned char * )text;
+    state       = 1;
+    accept      = DFA_NONE;
+    i           = 0;
+    *( length ) = 1;
+
+    while( ( state = DFA_Transitions[ DFA_Rows[ state ] ][ DFA_Classes[ p[ i ] ] ] ) != 0 )
+    {
+        i++;
+
+        if( DFA_Accept[ state ] != DFA_NONE )
+        {
+            accept      = DFA_Accept[ state ];
+            *( length ) = i;
+        }
+    }
+
+    return accept;
+}
@@ -0,0 +1,307 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Input.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Input.h"
+#include "Print.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/*
+ * Size of a single read() when streaming.
+ * The whole input is kept for the duration of the compilation, so spans
+ * remain valid. The buffer always has room for at least one more block
+ * after the data it holds, and doubles when it doesn't.
+ */
+#define INPUT_BLOCK_SIZE 65536
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+struct Input
+{
+    uint64_t rc;
+    int      fd;
+    char *   buffer;
+    char *   end;
+    size_t   size;
+    size_t   mapSize;
+    bool     mapped;
+    bool     eof;
+    char     empty[ 1 ];
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Creates an input streamed from a file descriptor, such as a pipe.
+ */
+InputRef Input_Create( int fd )
+{
+    InputRef input;
+
+    if( ( input = calloc( 1, sizeof( struct Input ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    input->rc     = 1;
+    input->fd     = fd;
+    input->buffer = input->empty;
+    input->end    = input->empty;
+
+    return input;
+}
+
+/*
+ * Maps the whole file read-only, so the lexer can scan it in place.
+ * The mapping is placed over an anonymous region one byte larger than the
+ * file, which guarantees a NUL sentinel right after the last character,
+ * even when the file size is a multiple of the page size.
+ */
+InputRef Input_CreateWithFile( const char * path )
+{
+    InputRef    input;
+    int         fd;
+    struct stat st;
+    size_t      size;
+    size_t      page;
+    char *      map;
+
+    if( ( fd = open( path, O_RDONLY ) ) < 0 )
+    {
+        Error( NULL, "Cannot open %s: %s", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    if( fstat( fd, &st ) != 0 || S_ISREG( st.st_mode ) == false )
+    {
+        Error( NULL, "Cannot map %s: not a regular file", path );
+        close( fd );
+
+        return NULL;
+    }
+
+    if( ( input = Input_Create( -1 ) ) == NULL )
+    {
+        close( fd );
+
+        return NULL;
+    }
+
+    input->mapped = true;
+    size          = ( size_t )( st.st_size );
+
+    if( size == 0 )
+    {
+        close( fd );
+
+        return input;
+    }
+
+    page = ( size_t )sysconf( _SC_PAGESIZE );
+    size = ( ( size + 1 + page - 1 ) / page ) * page;
+    map  = mmap( NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0 );
+
+    if( map == MAP_FAILED )
+    {
+        Error( NULL, "Cannot map %s: %s", path, strerror( errno ) );
+        close( fd );
+        Input_Release( input );
+
+        return NULL;
+    }
+
+    if( mmap( map, ( size_t )( st.st_size ), PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0 ) == MAP_FAILED )
+    {
+        Error( NULL, "Cannot map %s: %s", path, strerror( errno ) );
+        munmap( map, size );
+        close( fd );
+        Input_Release( input );
+
+        return NULL;
+    }
+
+    close( fd );
+
+#ifdef MADV_SEQUENTIAL
+    madvise( map, size, MADV_SEQUENTIAL );
+#endif
+
+    input->buffer  = map;
+    input->end     = map + st.st_size;
+    input->mapSize = size;
+
+    return input;
+}
+
+InputRef Input_Retain( InputRef input )
+{
+    if( input == NULL )
+    {
+        return NULL;
+    }
+
+    input->rc++;
+
+    return input;
+}
+
+void Input_Release( InputRef input )
+{
+    if( input == NULL )
+    {
+        return;
+    }
+
+    if( --( input->rc ) > 0 )
+    {
+        return;
+    }
+
+    if( input->mapped && input->mapSize > 0 )
+    {
+        munmap( input->buffer, input->mapSize );
+    }
+    else if( input->size > 0 )
+    {
+        free( input->buffer );
+    }
+
+    free( input );
+}
+
+char * Input_GetStart( InputRef input )
+{
+    return input->buffer;
+}
+
+/*
+ * Tells whether a NUL byte seen by the lexer is the sentinel placed after
+ * the buffered data, as opposed to a NUL byte in the input itself.
+ */
+bool Input_IsEnd( InputRef input, const char * current )
+{
+    return current == input->end;
+}
+
+size_t Input_GetOffset( InputRef input, const char * p )
+{
+    return ( size_t )( p - input->buffer );
+}
+
+/*
+ * Spans are offsets into the input, so they stay valid even if the buffer
+ * moves, but the returned pointer is only valid until the next refill.
+ */
+const char * Input_GetBytes( InputRef input, Span span )
+{
+    return input->buffer + span.offset;
+}
+
+bool Input_SpanEquals( InputRef input, Span span, const char * s )
+{
+    return strncmp( input->buffer + span.offset, s, span.length ) == 0 && s[ span.length ] == 0;
+}
+
+/*
+ * Called by the lexer when it reaches the sentinel.
+ * The next block is read right after the data already held, so a token
+ * spanning two reads is never split nor truncated, and nothing is moved
+ * unless the buffer needs to grow. Both pointers are updated if it does.
+ * Returns false at end of input, or if current isn't at the sentinel.
+ */
+bool Input_Fill( InputRef input, char ** mark, char ** current )
+{
+    size_t  used;
+    size_t  offset;
+    ssize_t n;
+
+    if( *( current ) != input->end || input->mapped || input->eof )
+    {
+        return false;
+    }
+
+    used   = ( size_t )( input->end - input->buffer );
+    offset = ( size_t )( *( mark ) - input->buffer );
+
+    if( used + INPUT_BLOCK_SIZE > input->size )
+    {
+        size_t size;
+        char * buffer;
+
+        size = ( input->size == 0 ) ? INPUT_BLOCK_SIZE * 2 : input->size * 2;
+
+        if( ( buffer = realloc( ( input->size == 0 ) ? NULL : input->buffer, size + 1 ) ) == NULL )
+        {
+            Error( NULL, "Out of memory" );
+            abort();
+        }
+
+        input->buffer = buffer;
+        input->size   = size;
+    }
+
+    do
+    {
+        n = read( input->fd, input->buffer + used, input->size - used );
+    }
+    while( n < 0 && errno == EINTR );
+
+    if( n < 0 )
+    {
+        Error( NULL, "Cannot read input: %s", strerror( errno ) );
+    }
+
+    if( n <= 0 )
+    {
+        n          = 0;
+        input->eof = true;
+    }
+
+    input->end      = input->buffer + used + n;
+    *( input->end ) = 0;
+    *( mark )       = input->buffer + offset;
+    *( current )    = input->buffer + used;
+
+    return n > 0;
+}
@@ -0,0 +1,362 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        LALR.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-lrgen from LALR.y, do not edit.
+ *              27 states, 21 actions and 3 gotos packed in 41 and 35 entries.
+ */
+
+#include "LALR.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ *   0  $accept          -> statements
+ *   1  statements       -> statements declaration TokenSemicolon
+ *   2  statements       -> epsilon
+ *   3  declaration      -> qualifiers type pointers id_or_pointer_id array
+ *   4  qualifiers       -> qualifiers qualifier
+ *   5  qualifiers       -> epsilon
+ *   6  qualifier        -> TokenConst
+ *   7  qualifier        -> TokenVolatile
+ *   8  qualifier        -> TokenSign
+ *   9  qualifier        -> TokenSize
+ *  10  type             -> TokenType
+ *  11  type             -> epsilon
+ *  12  pointers         -> pointers TokenPointer qualifiers
+ *  13  pointers         -> epsilon
+ *  14  id_or_pointer_id -> identifier
+ *  15  id_or_pointer_id -> TokenLeftParenthesis pointers identifier TokenRightParenthesis
+ *  16  identifier       -> TokenID
+ *  17  array            -> TokenLeftBracket TokenRightBracket
+ *  18  array            -> TokenLeftBracket TokenNumeric TokenRightBracket
+ *  19  array            -> epsilon
+ */
+
+/*
+ * Stack entries kept on the C stack before spilling to the heap.
+ */
+#define LALR_STACK 64
+
+/*
+ * Largest stack moved to the heap, until LALR_GetHeapPeak reads it.
+ */
+static size_t LALR_HeapPeak = 0;
+
+/*
+ * Column of the action table of each token, 0 being unused.
+ */
+static const uint8_t LALR_Columns[] =
+{
+    [ TokenEnd              ] = 1,
+    [ TokenSemicolon        ] = 2,
+    [ TokenLeftParenthesis  ] = 3,
+    [ TokenRightParenthesis ] = 4,
+    [ TokenLeftBracket      ] = 5,
+    [ TokenRightBracket     ] = 6,
+    [ TokenConst            ] = 7,
+    [ TokenVolatile         ] = 8,
+    [ TokenSign             ] = 9,
+    [ TokenSize             ] = 10,
+    [ TokenPointer          ] = 11,
+    [ TokenType             ] = 12,
+    [ TokenID               ] = 13,
+    [ TokenNumeric          ] = 14
+};
+
+/*
+ * Actions are the state to shift to, -1 minus the rule to reduce, rule 0
+ * accepting the input, or 0 for a syntax error.
+ */
+static const int16_t LALR_Default[ 27 ] =
+{
+      -3,   -6,    0,  -12,   -2,   -7,   -8,   -9,  -10,  -11,  -14,   -5,    0,  -14,   -6,  -17,
+     -20,  -15,    0,  -13,    0,   -4,    0,  -18,    0,  -16,  -19
+};
+
+static const uint16_t LALR_Base[ 27 ] =
+{
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  13,  12,  14,  15,
+     16,  17,  18,  25,  22,  19,  21,  20,  24,  23,  26
+};
+
+static const uint16_t LALR_Check[ 41 ] =
+{
+    65535, 65535,   1, 65535,   2, 65535, 65535, 65535, 65535, 65535,   3,   3,   3,   3, 65535,   3,
+     12, 65535, 65535, 65535, 65535,  16, 65535, 65535,  12,  22,  12, 65535,  20,  18,  24,  18,
+     19,  19,  19,  19,  20, 65535, 65535, 65535, 65535
+};
+
+static const int16_t LALR_Next[ 41 ] =
+{
+       0,    0,   -1,    0,    4,    0,    0,    0,    0,    0,    5,    6,    7,    8,    0,    9,
+      13,    0,    0,    0,    0,   20,    0,    0,   14,   25,   15,    0,   23,   14,   26,   15,
+       5,    6,    7,    8,   24,    0,    0,    0,    0
+};
+
+/*
+ * State to go to after reducing to each nonterminal, by state.
+ */
+static const uint16_t LALR_GotoDefault[ 9 ] =
+{
+      1,   2,   3,  10,  12,  16,  21,  11,  17
+};
+
+static const uint16_t LALR_GotoBase[ 9 ] =
+{
+      0,   1,   2,   3,   4,   5,   6,   7,   8
+};
+
+static const uint16_t LALR_GotoCheck[ 35 ] =
+{
+    65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+      2,   4, 65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,   8, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 65535
+};
+
+static const uint16_t LALR_GotoNext[ 35 ] =
+{
+       0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      19,   18,    0,    0,    0,    0,    0,    0,    0,    0,   22,    0,    0,    0,    0,    0,
+       0,    0,    0
+};
+
+/*
+ * Length and left-hand side of each rule.
+ */
+static const uint8_t LALR_Lengths[ 20 ] =
+{
+      1,   3,   0,   5,   2,   0,   1,   1,   1,   1,   1,   0,   3,   0,   1,   4,
+      1,   2,   3,   0
+};
+
+static const uint8_t LALR_Lhs[ 20 ] =
+{
+      0,   0,   0,   1,   2,   2,   7,   7,   7,   7,   3,   3,   4,   4,   5,   5,
+      8,   6,   6,   6
+};
+
+size_t LALR_GetHeapPeak( void )
+{
+    size_t peak;
+
+    peak          = LALR_HeapPeak;
+    LALR_HeapPeak = 0;
+
+    return peak;
+}
+
+bool LALR_Parse( LexerRef lexer )
+{
+    uint16_t      inlineStates[ LALR_STACK ];
+    ParserValue   inlineValues[ LALR_STACK ];
+    uint16_t *    states;
+    ParserValue * values;
+    ParserValue   value;
+    size_t        count;
+    size_t        capacity;
+    bool          ok;
+
+    Qualifier qualifiers[ 10 ];
+    size_t    size = 0;
+
+    states      = inlineStates;
+    values      = inlineValues;
+    capacity    = LALR_STACK;
+    states[ 0 ] = 0;
+    count       = 1;
+    ok          = true;
+
+    while( true )
+    {
+        unsigned int state;
+        unsigned int token;
+        unsigned int index;
+        unsigned int production;
+        unsigned int lhs;
+        size_t       length;
+        int          action;
+
+        if( count == capacity )
+        {
+            uint16_t *    grownStates;
+            ParserValue * grownValues;
+
+            grownStates = malloc( capacity * 2 * sizeof( uint16_t ) );
+            grownValues = malloc( capacity * 2 * sizeof( ParserValue ) );
+
+            if( grownStates == NULL || grownValues == NULL )
+            {
+                free( grownStates );
+                free( grownValues );
+                Error( lexer, "Syntax error" );
+
+                ok = false;
+
+                break;
+            }
+
+            memcpy( grownStates, states, count * sizeof( uint16_t ) );
+            memcpy( grownValues, values, count * sizeof( ParserValue ) );
+
+            if( states != inlineStates )
+            {
+                free( states );
+                free( values );
+            }
+
+            states    = grownStates;
+            values    = grownValues;
+            capacity *= 2;
+
+            if( capacity * ( sizeof( uint16_t ) + sizeof( ParserValue ) ) > LALR_HeapPeak )
+            {
+                LALR_HeapPeak = capacity * ( sizeof( uint16_t ) + sizeof( ParserValue ) );
+            }
+        }
+
+        state  = states[ count - 1 ];
+        token  = ( unsigned int )( Lexer_GetLookahead( lexer ) );
+        index  = LALR_Base[ state ] + ( ( token < sizeof( LALR_Columns ) ) ? LALR_Columns[ token ] : 0U );
+        action = ( LALR_Check[ index ] == state ) ? LALR_Next[ index ] : LALR_Default[ state ];
+
+        if( action > 0 )
+        {
+            states[ count ] = ( uint16_t )action;
+
+            values[ count ].token = Lexer_GetCurrent( lexer ); values[ count ].name = Lexer_GetSymbol( lexer ); values[ count ].value = Lexer_GetValue( lexer ); values[ count ].line = Lexer_GetLine( lexer );
+
+            count++;
+
+            Lexer_Advance( lexer );
+
+            continue;
+        }
+
+        if( action == 0 )
+        {
+            Error( lexer, "Syntax error" );
+
+            ok = false;
+
+            break;
+        }
+
+        if( ( production = ( unsigned int )( -action - 1 ) ) == 0 )
+        {
+            break;
+        }
+
+        length = LALR_Lengths[ production ];
+
+        if( length > 0 )
+        {
+            value = values[ count - length ];
+        }
+        else
+        {
+            memset( &value, 0, sizeof( value ) );
+        }
+
+        switch( production )
+        {
+            case 1:
+
+                DebugAt( values[ count - 1 ].line, "Syntax OK" );
+
+                break;
+
+            case 4:
+
+                if( size == sizeof( qualifiers ) / sizeof( *( qualifiers ) ) ) { Error( lexer, "Buffer too small" ); abort(); } qualifiers[ size ].token = values[ count - 1 ].token; qualifiers[ size++ ].name = values[ count - 1 ].name;
+
+                break;
+
+            case 5:
+
+                size = 0;
+
+                break;
+
+            case 10:
+
+                ok = Parser_ValidType( lexer, values[ count - 1 ].name, qualifiers, size );
+
+                break;
+
+            case 11:
+
+                ok = Parser_ValidType( lexer, SYMBOL_NONE, qualifiers, size );
+
+                break;
+
+            case 12:
+
+                ok = Parser_ValidPointerQualifiers( lexer, qualifiers, size );
+
+                break;
+
+            case 16:
+
+                ok = Parser_ValidID( lexer, Lexer_GetName( lexer, values[ count - 1 ].name ) );
+
+                break;
+
+            case 18:
+
+                ok = Parser_ValidArraySize( lexer, values[ count - 2 ].value );
+
+                break;
+
+            default:
+
+                break;
+        }
+
+        if( ok == false )
+        {
+            break;
+        }
+
+        count          -= length;
+        state           = states[ count - 1 ];
+        lhs             = LALR_Lhs[ production ];
+        index           = LALR_GotoBase[ lhs ] + state;
+        states[ count ] = ( LALR_GotoCheck[ index ] == lhs ) ? LALR_GotoNext[ index ] : LALR_GotoDefault[ lhs ];
+        values[ count ] = value;
+
+        count++;
+    }
+
+    if( states != inlineStates )
+    {
+        free( states );
+        free( values );
+    }
+
+    return ok;
+}
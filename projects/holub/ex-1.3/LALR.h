@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      LALR.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Generated by tools-lrgen from LALR.y, do not edit.
+ *              27 states, 21 actions and 3 gotos packed in 41 and 35 entries.
+ */
+
+#ifndef LALR_H
+#define LALR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "Lexer.h"
+#include "Parser.h"
+#include "Print.h"
+
+/*
+ * Parses the input, running the actions of the grammar as rules are
+ * reduced, and returns false on the first syntax error.
+ */
+bool LALR_Parse( LexerRef lexer );
+
+/*
+ * Size in bytes of the largest stack the parser moved to the heap since
+ * the last call, for inputs nested too deep for its C stack. It is not
+ * synchronized, so it is only meaningful when parsing on one thread.
+ */
+size_t LALR_GetHeapPeak( void );
+
+#endif /* LALR_H */
@@ -0,0 +1,62 @@
+#-------------------------------------------------------------------------------
+# Declaration grammar, for tools-lrgen.
+# Regenerate LALR.c and LALR.h with `make lr` after editing it.
+#
+# Actions make the same checks as Parser.c, but the parse stops on the
+# first error instead of skipping the declaration. Qualifiers are collected
+# as their list is reduced, and checked once it is complete. A declaration
+# is only reduced once the token after it was read, so tokens keep their
+# line for the messages.
+#-------------------------------------------------------------------------------
+
+%include   "Lexer.h"
+%include   "Parser.h"
+%include   "Print.h"
+%param     LexerRef lexer
+%lookahead Lexer_GetLookahead( lexer )
+%advance   Lexer_Advance( lexer );
+%error     Error( lexer, "Syntax error" );
+%value     ParserValue
+%shift     $$.token = Lexer_GetCurrent( lexer ); $$.name = Lexer_GetSymbol( lexer ); $$.value = Lexer_GetValue( lexer ); $$.line = Lexer_GetLine( lexer );
+%local     Qualifier qualifiers[ 10 ];
+%local     size_t    size = 0;
+%token     TokenEnd TokenSemicolon TokenLeftParenthesis TokenRightParenthesis TokenLeftBracket TokenRightBracket
+%token     TokenConst TokenVolatile TokenSign TokenSize TokenPointer TokenType TokenID TokenNumeric
+%end       TokenEnd
+
+statements      : statements declaration TokenSemicolon { DebugAt( $3.line, "Syntax OK" ); }
+                |
+                ;
+
+declaration     : qualifiers type pointers id_or_pointer_id array
+                ;
+
+qualifiers      : qualifiers qualifier { if( size == sizeof( qualifiers ) / sizeof( *( qualifiers ) ) ) { Error( lexer, "Buffer too small" ); abort(); } qualifiers[ size ].token = $2.token; qualifiers[ size++ ].name = $2.name; }
+                | { size = 0; }
+                ;
+
+qualifier       : TokenConst
+                | TokenVolatile
+                | TokenSign
+                | TokenSize
+                ;
+
+type            : TokenType { ok = Parser_ValidType( lexer, $1.name, qualifiers, size ); }
+                | { ok = Parser_ValidType( lexer, SYMBOL_NONE, qualifiers, size ); }
+                ;
+
+pointers        : pointers TokenPointer qualifiers { ok = Parser_ValidPointerQualifiers( lexer, qualifiers, size ); }
+                |
+                ;
+
+id_or_pointer_id: identifier
+                | TokenLeftParenthesis pointers identifier TokenRightParenthesis
+                ;
+
+identifier      : TokenID { ok = Parser_ValidID( lexer, Lexer_GetName( lexer, $1.name ) ); }
+                ;
+
+array           : TokenLeftBracket TokenRightBracket
+                | TokenLeftBracket TokenNumeric TokenRightBracket { ok = Parser_ValidArraySize( lexer, $2.value ); }
+                |
+                ;
@@ -31,242 +31,959 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
+#include "TokenStream.h"
+#include "Number.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 
-static char * Lexer_Text      = "";
-static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
-static int    Lexer_Lookahead = -1;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
 
-const char * Lexer_GetText( void )
+/*
+ * A token scanned ahead of the current one by Lexer_Peek.
+ * Its text is kept as an offset, as the input buffer may move when it is
+ * refilled.
+ */
+typedef struct
+{
+    Token    token;
+    size_t   offset;
+    size_t   length;
+    size_t   line;
+    uint64_t value;
+    Symbol   symbol;
+} LexerPeeked;
+
+/*
+ * Illegal input found by Lexer_Tokenize, which is only reported when the
+ * parser reads the token after it.
+ */
+typedef struct
+{
+    size_t   token;
+    uint64_t offset;
+    size_t   line;
+} LexerIllegal;
+
+/*
+ * Everything the lexer knows about a compilation lives here rather than in
+ * file-level globals, so independent inputs can be lexed on separate
+ * threads, each with its own lexer.
+ * Identifiers and keywords are interned into the symbols table as they
+ * are scanned.
+ * Tokens scanned by Lexer_Peek wait in a ring buffer, starting at
+ * peekHead, until Lexer_Next hands them out.
+ * While tokenizing, illegal input is recorded instead of reported, and
+ * numbers too large are left to Lexer_Next, so messages are printed in
+ * the order of the input, along with the parser's.
+ */
+struct Lexer
+{
+    uint64_t         rc;
+    InputRef         input;
+    char *           text;
+    size_t           length;
+    uint64_t         value;
+    Symbol           symbol;
+    size_t           line;
+    int              lookahead;
+    TokenStreamRef   stream;
+    size_t           position;
+    const uint8_t *  kinds;
+    const uint64_t * offsets;
+    const uint32_t * lengths;
+    const uint32_t * lines;
+    const uint32_t * symbols;
+    SymbolTableRef   table;
+    LexerPeeked      peeked[ LEXER_PEEK_MAX ];
+    size_t           peekHead;
+    size_t           peekCount;
+    bool             deferred;
+    LexerIllegal *   illegal;
+    size_t           illegalCount;
+    size_t           illegalCapacity;
+    size_t           illegalNext;
+    size_t           decoded;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static bool Lexer_InternKeywords( LexerRef lexer );
+
+LexerRef Lexer_Create( InputRef input )
+{
+    LexerRef lexer;
+
+    if( input == NULL || ( lexer = calloc( 1, sizeof( struct Lexer ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    if( ( lexer->table = SymbolTable_Create() ) == NULL || Lexer_InternKeywords( lexer ) == false )
+    {
+        SymbolTable_Release( lexer->table );
+        free( lexer );
+
+        return NULL;
+    }
+
+    lexer->rc        = 1;
+    lexer->input     = Input_Retain( input );
+    lexer->line      = 1;
+    lexer->symbol    = SYMBOL_NONE;
+    lexer->lookahead = -1;
+
+    return lexer;
+}
+
+LexerRef Lexer_Retain( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->rc++;
+
+    return lexer;
+}
+
+void Lexer_Release( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return;
+    }
+
+    if( --( lexer->rc ) > 0 )
+    {
+        return;
+    }
+
+    TokenStream_Release( lexer->stream );
+    SymbolTable_Release( lexer->table );
+    Input_Release( lexer->input );
+    free( lexer->illegal );
+    free( lexer );
+}
+
+InputRef Lexer_GetInput( LexerRef lexer )
+{
+    return lexer->input;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    const char * name;
+    size_t       length;
+    Token        token;
+    Symbol       symbol;
+} Keyword;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+/*
+ * Slot of a keyword in the keywords table, from its first two characters
+ * and its length. Also usable in constant expressions, so that the slots
+ * of the keywords table are checked at compile time.
+ */
+#define LEXER_KEYWORD_SLOTS 32
+#define LEXER_KEYWORD_HASH( c0, c1, length ) ( ( ( size_t )( unsigned char )( c0 ) + ( ( size_t )( unsigned char )( c1 ) << 3 ) + ( size_t )( length ) ) & ( LEXER_KEYWORD_SLOTS - 1 ) )
+
+/*
+ * Keywords, indexed by Lexer_KeywordHash(), expanded from the keywords
+ * table in Tokens.h.
+ * The hash is perfect over this set: every keyword gets its own slot, so
+ * recognizing a keyword takes one hash, one length check and one compare.
+ * Two keywords in the same slot trigger -Woverride-init, and a keyword
+ * outside the slot of its hash, or with a wrong length, fails to compile.
+ */
+#define KEYWORD_ENTRY( text, c0, c1, length, token, symbol, slot ) [ slot ] = { text, length, token, symbol },
+
+static const Keyword Lexer_Keywords[ LEXER_KEYWORD_SLOTS ] =
+{
+    KEYWORDS( KEYWORD_ENTRY )
+};
+
+#undef KEYWORD_ENTRY
+
+#define KEYWORD_CHECK( text, c0, c1, length, token, symbol, slot )                                  \
+    _Static_assert( sizeof( text ) - 1 == length, "Wrong length for keyword " text );             \
+    _Static_assert( length < 32, "Keyword too long for Lexer_KeywordLengths: " text );            \
+    _Static_assert( LEXER_KEYWORD_HASH( c0, c1, length ) == slot, "Wrong slot for keyword " text );
+
+KEYWORDS( KEYWORD_CHECK )
+
+#undef KEYWORD_CHECK
+
+/*
+ * Lengths of the keywords, one bit per length, so that most identifiers
+ * are rejected before hashing.
+ */
+#define KEYWORD_LENGTH( text, c0, c1, length, token, symbol, slot ) | ( ( uint32_t )1 << ( length ) )
+
+static const uint32_t Lexer_KeywordLengths = 0 KEYWORDS( KEYWORD_LENGTH );
+
+#undef KEYWORD_LENGTH
+
+/*
+ * Interns the keywords in the order of the keywords table, so that each
+ * one gets the symbol it is declared with, and a keyword matched by
+ * Lexer_IsKeyword needs no lookup in the symbols table.
+ * The characters the slot was checked with must be the keyword's own.
+ */
+#define KEYWORD_INTERN( text, c0, c1, length, token, symbol, slot )     \
+    if( text[ 0 ] != c0 || text[ 1 ] != c1                             \
+        || SymbolTable_Intern( lexer->table, text, length ) != symbol ) \
+    {                                                                   \
+        return false;                                                   \
+    }
+
+static bool Lexer_InternKeywords( LexerRef lexer )
 {
-    return Lexer_Text;
+    KEYWORDS( KEYWORD_INTERN )
+
+    return true;
 }
 
-size_t Lexer_GetLength( void )
+#undef KEYWORD_INTERN
+
+const char * Lexer_GetText( LexerRef lexer )
 {
-    return Lexer_Length;
+    return lexer->text;
 }
 
-size_t Lexer_GetLine( void )
+size_t Lexer_GetLength( LexerRef lexer )
 {
-    return Lexer_Line;
+    return lexer->length;
 }
 
-Token Lexer_GetCurrent( void )
+/*
+ * Value of the current token, if it is a number, decoded while scanning.
+ * Saturates at UINT64_MAX for numbers too large.
+ */
+uint64_t Lexer_GetValue( LexerRef lexer )
 {
-    return ( Token )Lexer_Lookahead;
+    return lexer->value;
 }
 
-Token Lexer_Next( void )
+/*
+ * Symbol of the current token, if it is an identifier or a keyword,
+ * SYMBOL_NONE otherwise.
+ */
+Symbol Lexer_GetSymbol( LexerRef lexer )
 {
-    static char buf[ 128 ];
-    char *      current;
+    return lexer->symbol;
+}
 
-    current = Lexer_Text + Lexer_Length;
+const char * Lexer_GetName( LexerRef lexer, Symbol symbol )
+{
+    return SymbolTable_GetName( lexer->table, symbol );
+}
+
+Span Lexer_GetSpan( LexerRef lexer )
+{
+    Span span;
+
+    span.offset = ( lexer->text == NULL ) ? 0 : Input_GetOffset( lexer->input, lexer->text );
+    span.length = lexer->length;
+
+    return span;
+}
+
+size_t Lexer_GetLine( LexerRef lexer )
+{
+    return lexer->line;
+}
+
+Token Lexer_GetCurrent( LexerRef lexer )
+{
+    return ( Token )lexer->lookahead;
+}
+
+static size_t Lexer_KeywordHash( const char * text, size_t length )
+{
+    return LEXER_KEYWORD_HASH( text[ 0 ], text[ 1 ], length );
+}
+
+static bool Lexer_IsKeyword( LexerRef lexer, Token * token, Symbol * symbol )
+{
+    const Keyword * keyword;
+
+    if( lexer->length >= 32 || ( Lexer_KeywordLengths & ( ( uint32_t )1 << lexer->length ) ) == 0 )
+    {
+        return false;
+    }
+
+    keyword = &( Lexer_Keywords[ Lexer_KeywordHash( lexer->text, lexer->length ) ] );
+
+    if( keyword->length != lexer->length || memcmp( keyword->name, lexer->text, lexer->length ) != 0 )
+    {
+        return false;
+    }
+
+    *( token )  = keyword->token;
+    *( symbol ) = keyword->symbol;
+
+    return true;
+}
+
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+static void Lexer_ReportIllegal( LexerRef lexer, const char * p )
+{
+    if( *( p ) == 0 )
+    {
+        Warning( lexer, "Ignoring illegal input: NUL" );
+    }
+    else
+    {
+        Warning( lexer, "Ignoring illegal input: %c", *( p ) );
+    }
+}
+
+/*
+ * Reports illegal input, or records it while tokenizing. It is reported
+ * right away if it can't be recorded.
+ */
+static void Lexer_Report( LexerRef lexer, const char * p )
+{
+    if( lexer->deferred && lexer->illegalCount == lexer->illegalCapacity )
+    {
+        LexerIllegal * illegal;
+        size_t         capacity;
+
+        capacity = ( lexer->illegalCapacity == 0 ) ? 16 : lexer->illegalCapacity * 2;
+
+        if( ( illegal = realloc( lexer->illegal, capacity * sizeof( LexerIllegal ) ) ) != NULL )
+        {
+            lexer->illegal         = illegal;
+            lexer->illegalCapacity = capacity;
+        }
+    }
+
+    if( lexer->deferred == false || lexer->illegalCount == lexer->illegalCapacity )
+    {
+        Lexer_ReportIllegal( lexer, p );
+
+        return;
+    }
+
+    lexer->illegal[ lexer->illegalCount ].token  = SIZE_MAX;
+    lexer->illegal[ lexer->illegalCount ].offset = Input_GetOffset( lexer->input, p );
+    lexer->illegal[ lexer->illegalCount ].line   = lexer->line;
+
+    lexer->illegalCount++;
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: return name;
+
+static Token Lexer_Scan( LexerRef lexer )
+{
+    char *        current;
+    unsigned char classes;
+    Token         token;
+
+    current       = ( lexer->text == NULL ) ? Input_GetStart( lexer->input ) : lexer->text + lexer->length;
+    lexer->value  = 0;
+    lexer->symbol = SYMBOL_NONE;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        lexer->text   = current;
+        lexer->length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( lexer->input, &( lexer->text ), &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( lexer->input, current ) )
+                {
+                    lexer->length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                Lexer_Report( lexer, current );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
+                break;
 
-            switch( *( current ) )
-            {
-                case EOF: return TokenEnd;
-                case ';': return TokenSemicolon;
-                case '*': return TokenPointer;
-                case '(': return TokenLeftParenthesis;
-                case ')': return TokenRightParenthesis;
-                case '[': return TokenLeftBracket;
-                case ']': return TokenRightBracket;
-
-                case '\n':
-                case '\t':
-                case ' ':
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
+
+            case '\n':
+
+                lexer->line++;
+                current++;
+
+                break;
+
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
+
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Lexer_Report( lexer, current );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Warning( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
+
+                classes = CharClassNone;
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
+                        classes |= CharClass_Get( *( current ) );
                         current++;
                     }
+                }
+                while( Input_Fill( lexer->input, &( lexer->text ), &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                lexer->length = ( uintptr_t )current - ( uintptr_t )lexer->text;
 
-                    if( Lexer_Compare( "const" ) )
-                    {
-                        return TokenConst;
-                    }
-                    else if( Lexer_Compare( "volatile" ) )
-                    {
-                        return TokenVolatile;
-                    }
-                    else if( Lexer_Compare( "signed" ) || Lexer_Compare( "unsigned" ) )
-                    {
-                        return TokenSign;
-                    }
-                    else if( Lexer_Compare( "short" ) || Lexer_Compare( "long" ) )
-                    {
-                        return TokenSize;
-                    }
-                    else if( Lexer_Compare( "char" ) || Lexer_Compare( "int" ) || Lexer_Compare( "float" ) || Lexer_Compare( "double" ) )
-                    {
-                        return TokenType;
-                    }
+                if( classes == CharClassAlpha && Lexer_IsKeyword( lexer, &token, &( lexer->symbol ) ) )
+                {
+                    return token;
+                }
 
-                    for( size_t i = 0; i < Lexer_Length; i++ )
+                if( ( classes & CharClassAlpha ) != 0 )
+                {
+                    if( ( lexer->symbol = SymbolTable_Intern( lexer->table, lexer->text, lexer->length ) ) == SYMBOL_NONE )
                     {
-                        if( isdigit( Lexer_Text[ i ] ) == false )
-                        {
-                            return TokenID;
-                        }
+                        Error( lexer, "Out of memory" );
+                        abort();
                     }
 
-                    return TokenNumeric;
-            }
+                    return TokenID;
+                }
+
+                if( Number_Decode( lexer->text, lexer->length, &( lexer->value ) ) == NumberOverflow && lexer->deferred == false )
+                {
+                    Error( lexer, "Numeric literal too large: %.*s", ( int )( lexer->length ), lexer->text );
+                }
+
+                return TokenNumeric;
         }
     }
 }
 
-void Lexer_Advance( void )
-{
-    Lexer_Lookahead = ( int )( Lexer_Next() );
-}
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
 
-void Lexer_Discard( void )
+/*
+ * Lexes the whole input up front into a token stream. From then on,
+ * Lexer_Next only reads the next entry of the stream, so scanning and
+ * parsing are separate passes.
+ * Messages are deferred until the tokens are read, so the output is the
+ * same as without a token stream.
+ */
+bool Lexer_Tokenize( LexerRef lexer )
 {
-    Lexer_Text      = "";
-    Lexer_Length    = 0;
-    Lexer_Lookahead = -1;
-}
+    Token  token;
+    size_t tagged;
 
-bool Lexer_Match( Token token )
-{
-    if( Lexer_Lookahead == -1 )
+    if( lexer->stream != NULL )
     {
-        Lexer_Advance();
+        return true;
     }
 
-    return ( int )token == Lexer_Lookahead;
+    if( ( lexer->stream = TokenStream_Create() ) == NULL )
+    {
+        return false;
+    }
+
+    tagged          = 0;
+    lexer->deferred = true;
+
+    do
+    {
+        token = Lexer_Scan( lexer );
+
+        for( ; tagged < lexer->illegalCount; tagged++ )
+        {
+            lexer->illegal[ tagged ].token = TokenStream_GetCount( lexer->stream );
+        }
+
+        if( lexer->length > UINT32_MAX || lexer->line > UINT32_MAX )
+        {
+            Error( lexer, "Input too large for a token stream" );
+            abort();
+        }
+
+        if( TokenStream_Append( lexer->stream, ( uint8_t )token, Lexer_GetSpan( lexer ).offset, ( uint32_t )lexer->length, ( uint32_t )lexer->line, lexer->symbol ) == false )
+        {
+            Error( lexer, "Out of memory" );
+            abort();
+        }
+    }
+    while( token != TokenEnd );
+
+    lexer->deferred = false;
+    lexer->kinds    = TokenStream_GetKinds( lexer->stream );
+    lexer->offsets  = TokenStream_GetOffsets( lexer->stream );
+    lexer->lengths  = TokenStream_GetLengths( lexer->stream );
+    lexer->lines    = TokenStream_GetLines( lexer->stream );
+    lexer->symbols  = TokenStream_GetSymbols( lexer->stream );
+    lexer->position = 0;
+    lexer->text     = NULL;
+    lexer->length   = 0;
+    lexer->line     = 1;
+    lexer->symbol   = SYMBOL_NONE;
+
+    return true;
 }
 
-bool Lexer_Compare( const char * value )
+/*
+ * Scans one more token after the last peeked one, or after the current
+ * one if none were peeked, and queues it. The current token is left as it
+ * was.
+ */
+static void Lexer_Queue( LexerRef lexer )
 {
-    return strncmp( value, Lexer_Text, Lexer_Length ) == 0;
+    LexerPeeked * peeked;
+    char *        text;
+    size_t        offset;
+    size_t        length;
+    size_t        line;
+    uint64_t      value;
+    Symbol        symbol;
+
+    text   = lexer->text;
+    offset = ( text == NULL ) ? 0 : Input_GetOffset( lexer->input, text );
+    length = lexer->length;
+    line   = lexer->line;
+    value  = lexer->value;
+    symbol = lexer->symbol;
+
+    if( lexer->peekCount > 0 )
+    {
+        peeked = &( lexer->peeked[ ( lexer->peekHead + lexer->peekCount - 1 ) & ( LEXER_PEEK_MAX - 1 ) ] );
+
+        lexer->text   = Input_GetStart( lexer->input ) + peeked->offset;
+        lexer->length = peeked->length;
+        lexer->line   = peeked->line;
+    }
+
+    peeked         = &( lexer->peeked[ ( lexer->peekHead + lexer->peekCount ) & ( LEXER_PEEK_MAX - 1 ) ] );
+    peeked->token  = Lexer_Scan( lexer );
+    peeked->offset = Input_GetOffset( lexer->input, lexer->text );
+    peeked->length = lexer->length;
+    peeked->line   = lexer->line;
+    peeked->value  = lexer->value;
+    peeked->symbol = lexer->symbol;
+
+    lexer->peekCount++;
+
+    lexer->text   = ( text == NULL ) ? NULL : Input_GetStart( lexer->input ) + offset;
+    lexer->length = length;
+    lexer->line   = line;
+    lexer->value  = value;
+    lexer->symbol = symbol;
 }
 
-bool Lexer_LegalLookahead( bool * error, Token first, ... )
+/*
+ * Reports what Lexer_Tokenize deferred, up to the given token of the
+ * stream, the first time it is read or peeked at. The current token is
+ * left as it is.
+ */
+static void Lexer_Replay( LexerRef lexer, size_t last )
 {
-    va_list ap;
-    bool    ret;
+    char * text;
+    size_t length;
+    size_t line;
+    size_t i;
 
-    va_start( ap, first );
+    text   = lexer->text;
+    length = lexer->length;
+    line   = lexer->line;
 
-    if( error != NULL )
+    for( i = lexer->decoded; i <= last; i++ )
     {
-        *( error ) = false;
+        uint64_t value;
+
+        while( lexer->illegalNext < lexer->illegalCount && lexer->illegal[ lexer->illegalNext ].token == i )
+        {
+            lexer->text = Input_GetStart( lexer->input ) + lexer->illegal[ lexer->illegalNext ].offset;
+            lexer->line = lexer->illegal[ lexer->illegalNext ].line;
+
+            Lexer_ReportIllegal( lexer, lexer->text );
+
+            lexer->illegalNext++;
+        }
+
+        lexer->text   = Input_GetStart( lexer->input ) + lexer->offsets[ i ];
+        lexer->length = lexer->lengths[ i ];
+        lexer->line   = lexer->lines[ i ];
+
+        if( lexer->kinds[ i ] == TokenNumeric && Number_Decode( lexer->text, lexer->length, &value ) == NumberOverflow )
+        {
+            Error( lexer, "Numeric literal too large: %.*s", ( int )( lexer->length ), lexer->text );
+        }
     }
 
-    ret = false;
+    lexer->decoded = ( last >= lexer->decoded ) ? last + 1 : lexer->decoded;
+    lexer->text    = text;
+    lexer->length  = length;
+    lexer->line    = line;
+}
 
-    if( first == TokenEnd )
+Token Lexer_Next( LexerRef lexer )
+{
+    size_t i;
+
+    if( lexer->stream == NULL )
     {
-        if( Lexer_Match( TokenEnd ) )
+        LexerPeeked * peeked;
+
+        if( lexer->peekCount == 0 )
         {
-            ret = true;
+            return Lexer_Scan( lexer );
         }
+
+        peeked = &( lexer->peeked[ lexer->peekHead ] );
+
+        lexer->text      = Input_GetStart( lexer->input ) + peeked->offset;
+        lexer->length    = peeked->length;
+        lexer->line      = peeked->line;
+        lexer->value     = peeked->value;
+        lexer->symbol    = peeked->symbol;
+        lexer->peekHead  = ( lexer->peekHead + 1 ) & ( LEXER_PEEK_MAX - 1 );
+        lexer->peekCount--;
+
+        return peeked->token;
     }
-    else
+
+    i = lexer->position;
+
+    if( i + 1 < TokenStream_GetCount( lexer->stream ) )
     {
-        Token   token;
-        Token   lookaheads[ 16 ];
-        Token * p;
-        Token * current;
+        lexer->position++;
+    }
+
+    Lexer_Replay( lexer, i );
 
-        p        = lookaheads;
-        *( p++ ) = first;
+    lexer->text   = Input_GetStart( lexer->input ) + lexer->offsets[ i ];
+    lexer->length = lexer->lengths[ i ];
+    lexer->line   = lexer->lines[ i ];
+    lexer->value  = 0;
+    lexer->symbol = lexer->symbols[ i ];
+
+    if( lexer->kinds[ i ] == TokenNumeric )
+    {
+        Number_Decode( lexer->text, lexer->length, &( lexer->value ) );
+    }
 
-        while( ( token = va_arg( ap, Token ) ) && p < &( lookaheads[ 16 ] ) )
+    return ( Token )( lexer->kinds[ i ] );
+}
+
+void Lexer_Advance( LexerRef lexer )
+{
+    lexer->lookahead = ( int )( Lexer_Next( lexer ) );
+}
+
+/*
+ * Discards the rest of the current line.
+ */
+void Lexer_Discard( LexerRef lexer )
+{
+    char * current;
+
+    if( lexer->stream != NULL )
+    {
+        while( lexer->kinds[ lexer->position ] != TokenEnd && lexer->lines[ lexer->position ] == lexer->line )
         {
-            *( p++ ) = token;
+            lexer->position++;
         }
 
-        while( Lexer_Match( TokenSemicolon ) == false )
+        /*
+         * The rest of the line isn't scanned without a token stream either,
+         * so what was deferred there is dropped.
+         */
+        while( lexer->illegalNext < lexer->illegalCount && lexer->illegal[ lexer->illegalNext ].token <= lexer->position && lexer->illegal[ lexer->illegalNext ].line == lexer->line )
         {
-            for( current = lookaheads; current < p; current++ )
-            {
-                if( Lexer_Match( *( current ) ) )
-                {
-                    ret = true;
+            lexer->illegalNext++;
+        }
 
-                    goto done;
-                }
-            }
+        lexer->decoded   = ( lexer->position > lexer->decoded ) ? lexer->position : lexer->decoded;
+        lexer->lookahead = -1;
+
+        return;
+    }
+
+    while( lexer->peekCount > 0 && lexer->peeked[ lexer->peekHead ].line == lexer->line )
+    {
+        Lexer_Next( lexer );
+    }
+
+    if( lexer->peekCount > 0 )
+    {
+        lexer->lookahead = -1;
+
+        return;
+    }
+
+    current = ( lexer->text == NULL ) ? Input_GetStart( lexer->input ) : lexer->text + lexer->length;
 
-            if( error != NULL )
+    while( *( current ) != '\n' )
+    {
+        if( *( current ) == 0 && Input_IsEnd( lexer->input, current ) )
+        {
+            if( Input_Fill( lexer->input, &current, &current ) == false )
             {
-                *( error ) = true;
+                break;
             }
+        }
+        else
+        {
+            current++;
+        }
+    }
 
-            Lexer_Advance();
+    lexer->text      = current;
+    lexer->length    = 0;
+    lexer->lookahead = -1;
+}
+
+/*
+ * Returns the current token, reading the first one if needed.
+ */
+Token Lexer_GetLookahead( LexerRef lexer )
+{
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    return ( Token )lexer->lookahead;
+}
+
+bool Lexer_Match( LexerRef lexer, Token token )
+{
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    return ( int )token == lexer->lookahead;
+}
+
+bool Lexer_Compare( LexerRef lexer, const char * value )
+{
+    return strlen( value ) == lexer->length && strncmp( value, lexer->text, lexer->length ) == 0;
+}
+
+/*
+ * Variadic form of Lexer_LegalLookaheadSet, taking a list of tokens
+ * terminated by TokenEnd.
+ */
+bool Lexer_LegalLookahead( LexerRef lexer, bool * error, Token first, ... )
+{
+    va_list  ap;
+    TokenSet set;
+    Token    token;
+
+    if( first == TokenEnd )
+    {
+        if( error != NULL )
+        {
+            *( error ) = false;
         }
+
+        return Lexer_Match( lexer, TokenEnd );
     }
 
-done:
+    va_start( ap, first );
+
+    set = TOKEN_SET( first );
+
+    while( ( token = va_arg( ap, Token ) ) != TokenEnd )
+    {
+        set |= TOKEN_SET( token );
+    }
 
     va_end( ap );
 
-    return ret == true;
+    return Lexer_LegalLookaheadSet( lexer, error, set );
 }
 
-bool Lexer_HasNext( Token token )
+/*
+ * Skips tokens until the lookahead is in the set, setting the error flag
+ * if any token had to be skipped.
+ * Returns false if a semicolon or the end of input is reached first.
+ */
+bool Lexer_LegalLookaheadSet( LexerRef lexer, bool * error, TokenSet set )
 {
-    char * text;
-    size_t length;
-    int    lookahead;
-    bool   ret;
+    if( error != NULL )
+    {
+        *( error ) = false;
+    }
 
-    text      = Lexer_Text;
-    length    = Lexer_Length;
-    lookahead = Lexer_Lookahead;
-    ret       = Lexer_LegalLookahead( NULL, token, TokenEnd );
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    while( ( TOKEN_SET( lexer->lookahead ) & set ) == 0 )
+    {
+        if( ( TOKEN_SET( lexer->lookahead ) & ( TOKEN_SET( TokenSemicolon ) | TOKEN_SET( TokenEnd ) ) ) != 0 )
+        {
+            return false;
+        }
+
+        if( error != NULL )
+        {
+            *( error ) = true;
+        }
+
+        Lexer_Advance( lexer );
+    }
 
-    Lexer_Text      = text;
-    Lexer_Length    = length;
-    Lexer_Lookahead = lookahead;
+    return true;
+}
+
+/*
+ * Tells whether the token appears before the next semicolon, looking at
+ * most LEXER_PEEK_MAX tokens past the current one. Nothing is consumed.
+ */
+bool Lexer_HasNext( LexerRef lexer, Token token )
+{
+    size_t k;
+    Token  next;
+
+    for( k = 0; k <= LEXER_PEEK_MAX; k++ )
+    {
+        next = Lexer_Peek( lexer, k );
+
+        if( next == token )
+        {
+            return true;
+        }
+
+        if( next == TokenSemicolon || next == TokenEnd )
+        {
+            break;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Returns the k-th token after the current one, without consuming
+ * anything. Lexer_Peek( lexer, 0 ) is the current token.
+ * Tokens are scanned once: the following calls to Lexer_Next return the
+ * peeked ones.
+ */
+Token Lexer_Peek( LexerRef lexer, size_t k )
+{
+    size_t i;
+
+    if( lexer->lookahead == -1 )
+    {
+        Lexer_Advance( lexer );
+    }
+
+    if( k == 0 )
+    {
+        return ( Token )lexer->lookahead;
+    }
+
+    if( k > LEXER_PEEK_MAX )
+    {
+        Error( lexer, "Lookahead too large" );
+        abort();
+    }
+
+    if( lexer->stream != NULL )
+    {
+        i = lexer->position + k - 1;
+
+        if( i >= TokenStream_GetCount( lexer->stream ) )
+        {
+            i = TokenStream_GetCount( lexer->stream ) - 1;
+        }
+
+        Lexer_Replay( lexer, i );
+
+        return ( Token )( lexer->kinds[ i ] );
+    }
+
+    if( lexer->lookahead == TokenEnd )
+    {
+        return TokenEnd;
+    }
+
+    while( lexer->peekCount < k )
+    {
+        if( lexer->peekCount > 0 && lexer->peeked[ ( lexer->peekHead + lexer->peekCount - 1 ) & ( LEXER_PEEK_MAX - 1 ) ].token == TokenEnd )
+        {
+            return TokenEnd;
+        }
+
+        Lexer_Queue( lexer );
+    }
 
-    return ret;
+    return lexer->peeked[ ( lexer->peekHead + k - 1 ) & ( LEXER_PEEK_MAX - 1 ) ].token;
 }
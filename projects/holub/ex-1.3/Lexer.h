@@ -33,37 +33,88 @@
 #define LEXER_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include "Tokens.h"
+#include "Input.h"
+#include "Symbol.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd              = 0,  /* End of input */
-    TokenSemicolon        = 1,  /* ; */
-    TokenLeftParenthesis  = 2,  /* ; */
-    TokenRightParenthesis = 3,  /* ; */
-    TokenLeftBracket      = 4,  /* ; */
-    TokenRightBracket     = 5,  /* ; */
-    TokenConst            = 6,  /* const */
-    TokenVolatile         = 7,  /* volatile */
-    TokenSign             = 8,  /* signed, unsigned */
-    TokenSize             = 9,  /* short, long, long long */
-    TokenPointer          = 10, /* * */
-    TokenType             = 11, /* Type */
-    TokenID               = 12, /* Identifier */
-    TokenNumeric          = 13  /* Numeric */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
-const char * Lexer_GetText( void );
-size_t       Lexer_GetLength( void );
-size_t       Lexer_GetLine( void );
-Token        Lexer_GetCurrent( void );
-
-Token Lexer_Next( void );
-void  Lexer_Advance( void );
-void  Lexer_Discard( void );
-bool  Lexer_Match( Token token );
-bool  Lexer_Compare( const char * value );
-bool  Lexer_LegalLookahead( bool * error, Token first, ... );
-bool  Lexer_HasNext( Token token );
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
+/*
+ * A set of tokens, with one bit per token, so that checking the lookahead
+ * against a FIRST set is a single AND.
+ */
+typedef uint32_t TokenSet;
+
+#define TOKEN_SET( token ) ( ( TokenSet )1 << ( unsigned int )( token ) )
+
+_Static_assert( TokenCount <= sizeof( TokenSet ) * 8, "Too many tokens for a TokenSet" );
+
+/*
+ * Expands a list of tokens from Tokens.h, such as FIRST_EXPRESSION, into
+ * a constant TokenSet.
+ */
+#define TOKEN_SET_MEMBER( token ) | TOKEN_SET( token )
+#define TOKEN_SET_OF( LIST )      ( ( TokenSet )0 LIST( TOKEN_SET_MEMBER ) )
+
+/*
+ * Symbols of the keywords, which every lexer interns first.
+ */
+#define KEYWORD_SYMBOL( text, c0, c1, length, token, symbol, slot ) symbol,
+
+enum
+{
+    KEYWORDS( KEYWORD_SYMBOL )
+    SymbolKeywordCount
+};
+
+#undef KEYWORD_SYMBOL
+
+/*
+ * Number of tokens Lexer_Peek can look past the current one.
+ * Must be a power of two.
+ */
+#define LEXER_PEEK_MAX 16
+
+typedef struct Lexer * LexerRef;
+
+LexerRef Lexer_Create( InputRef input );
+LexerRef Lexer_Retain( LexerRef lexer );
+void     Lexer_Release( LexerRef lexer );
+InputRef Lexer_GetInput( LexerRef lexer );
+
+const char * Lexer_GetText( LexerRef lexer );
+size_t       Lexer_GetLength( LexerRef lexer );
+uint64_t     Lexer_GetValue( LexerRef lexer );
+Span         Lexer_GetSpan( LexerRef lexer );
+Symbol       Lexer_GetSymbol( LexerRef lexer );
+const char * Lexer_GetName( LexerRef lexer, Symbol symbol );
+size_t       Lexer_GetLine( LexerRef lexer );
+Token        Lexer_GetCurrent( LexerRef lexer );
+
+bool  Lexer_Tokenize( LexerRef lexer );
+Token Lexer_Next( LexerRef lexer );
+void  Lexer_Advance( LexerRef lexer );
+void  Lexer_Discard( LexerRef lexer );
+bool  Lexer_Match( LexerRef lexer, Token token );
+Token Lexer_GetLookahead( LexerRef lexer );
+bool  Lexer_Compare( LexerRef lexer, const char * value );
+bool  Lexer_LegalLookahead( LexerRef lexer, bool * error, Token first, ... );
+bool  Lexer_LegalLookaheadSet( LexerRef lexer, bool * error, TokenSet set );
+bool  Lexer_HasNext( LexerRef lexer, Token token );
+Token Lexer_Peek( LexerRef lexer, size_t k );
 
 #endif /* LEXER_H */
@@ -31,35 +31,43 @@
 
 #include "Parser.h"
 #include "Print.h"
+#include "CharClass.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <limits.h>
+
+static bool Parser_ImpliesType( Qualifier * qualifiers, size_t size );
+
+/*
+ * FIRST( identifier )
+ */
+static const TokenSet Parser_FirstID = TOKEN_SET_OF( FIRST_IDENTIFIER );
 
 /*
  * statements -> declaration SEMICOLON | declaration SEMI statements
  */
-void Parser_Statements( void )
+void Parser_Statements( LexerRef lexer )
 {
-    while( Lexer_Match( TokenEnd ) == false )
+    while( Lexer_Match( lexer, TokenEnd ) == false )
     {
-        if( Parser_Declaration() == false )
+        if( Parser_Declaration( lexer ) == false )
         {
-            Debug( "Invalid Syntax" );
-            Lexer_Discard();
-            Lexer_Advance();
+            Debug( lexer, "Invalid Syntax" );
+            Lexer_Discard( lexer );
+            Lexer_Advance( lexer );
         }
         else
         {
-            if( Lexer_Match( TokenSemicolon ) )
+            if( Lexer_Match( lexer, TokenSemicolon ) )
             {
-                Debug( "Syntax OK" );
-                Lexer_Advance();
+                Debug( lexer, "Syntax OK" );
+                Lexer_Advance( lexer );
             }
             else
             {
-                Warning( "Inserting missing semicolon" );
-                Debug( "Syntax OK" );
+                Warning( lexer, "Inserting missing semicolon" );
+                Debug( lexer, "Syntax OK" );
             }
         }
     }
@@ -68,7 +76,7 @@ void Parser_Statements( void )
 /*
  * declaration -> qualifiers type pointer id_or_pointer_id array
  */
-bool Parser_Declaration( void )
+bool Parser_Declaration( LexerRef lexer )
 {
     Qualifier qualifiers[ 10 ];
     size_t    size;
@@ -77,48 +85,41 @@ bool Parser_Declaration( void )
 
     size = sizeof( qualifiers ) / sizeof( *( qualifiers ) );
 
-    return Parser_Qualifiers( qualifiers, &size )
-        && Parser_Type( qualifiers, size )
-        && Parser_Pointers()
-        && Parser_IDOrPointerID()
-        && Parser_Array( NULL );
+    return Parser_Qualifiers( lexer, qualifiers, &size )
+        && Parser_Type( lexer, qualifiers, size )
+        && Parser_Pointers( lexer )
+        && Parser_IDOrPointerID( lexer )
+        && Parser_Array( lexer, NULL );
 }
 
 /*
  * qualifiers -> qualifier | qualifier qualifiers | EPSILON
  * qualifier  -> CONST | VOLATILE | SIGN | SIZE | EPSILON
  */
-bool Parser_Qualifiers( Qualifier * qualifiers, size_t * size )
+bool Parser_Qualifiers( LexerRef lexer, Qualifier * qualifiers, size_t * size )
 {
     size_t i;
 
     i = 0;
 
-    while( Lexer_Match( TokenConst )
-           || Lexer_Match( TokenVolatile )
-           || Lexer_Match( TokenSign )
-           || Lexer_Match( TokenSize ) )
+    while( Lexer_Match( lexer, TokenConst )
+           || Lexer_Match( lexer, TokenVolatile )
+           || Lexer_Match( lexer, TokenSign )
+           || Lexer_Match( lexer, TokenSize ) )
     {
         Qualifier * qualifier;
 
         if( i >= *( size ) )
         {
-            Error( "Buffer too small" );
+            Error( lexer, "Buffer too small" );
             abort();
         }
 
-        qualifier = &( qualifiers[ i ] );
+        qualifier        = &( qualifiers[ i ] );
+        qualifier->token = Lexer_GetCurrent( lexer );
+        qualifier->name  = Lexer_GetSymbol( lexer );
 
-        if( sizeof( qualifier->name ) < Lexer_GetLength() + 1 )
-        {
-            Error( "Buffer too small" );
-            abort();
-        }
-
-        qualifier->token = Lexer_GetCurrent();
-
-        strncpy( qualifier->name, Lexer_GetText(), Lexer_GetLength() );
-        Lexer_Advance();
+        Lexer_Advance( lexer );
 
         i++;
     }
@@ -132,11 +133,11 @@ bool Parser_Qualifiers( Qualifier * qualifiers, size_t * size )
  * pointers -> pointer | pointer pointers | EPSILON
  * pointer  -> PTR | PTR qualifier | EPSILON
  */
-bool Parser_Pointers( void )
+bool Parser_Pointers( LexerRef lexer )
 {
-    while( Lexer_Match( TokenPointer ) )
+    while( Lexer_Match( lexer, TokenPointer ) )
     {
-        Lexer_Advance();
+        Lexer_Advance( lexer );
 
         {
             Qualifier qualifiers[ 10 ];
@@ -146,32 +147,41 @@ bool Parser_Pointers( void )
 
             size = sizeof( qualifiers ) / sizeof( *( qualifiers ) );
 
-            if( Parser_Qualifiers( qualifiers, &size ) == false )
+            if( Parser_Qualifiers( lexer, qualifiers, &size ) == false || Parser_ValidPointerQualifiers( lexer, qualifiers, size ) == false )
             {
                 return false;
             }
+        }
+    }
 
-            for( size_t i = 0; i < size; i++ )
-            {
-                if( qualifiers[ i ].token != TokenConst && qualifiers[ i ].token != TokenVolatile )
-                {
-                    Error( "Unexpected pointer qualifier: %s", qualifiers[ i ].name );
-                }
+    return true;
+}
 
-                for( size_t j = 0; j < size; j++ )
-                {
-                    if( i == j )
-                    {
-                        continue;
-                    }
+/*
+ * Only const and volatile qualify a pointer, which is reported but not
+ * fatal, and a duplicate is.
+ */
+bool Parser_ValidPointerQualifiers( LexerRef lexer, Qualifier * qualifiers, size_t size )
+{
+    for( size_t i = 0; i < size; i++ )
+    {
+        if( qualifiers[ i ].token != TokenConst && qualifiers[ i ].token != TokenVolatile )
+        {
+            Error( lexer, "Unexpected pointer qualifier: %s", Lexer_GetName( lexer, qualifiers[ i ].name ) );
+        }
+
+        for( size_t j = 0; j < size; j++ )
+        {
+            if( i == j )
+            {
+                continue;
+            }
 
-                    if( qualifiers[ i ].token == qualifiers[ j ].token )
-                    {
-                        Error( "Duplicate pointer qualifier: %s", qualifiers[ i ].name );
+            if( qualifiers[ i ].token == qualifiers[ j ].token )
+            {
+                Error( lexer, "Duplicate pointer qualifier: %s", Lexer_GetName( lexer, qualifiers[ i ].name ) );
 
-                        return false;
-                    }
-                }
+                return false;
             }
         }
     }
@@ -182,133 +192,131 @@ bool Parser_Pointers( void )
 /*
  * type -> TYPE | EPSILON
  */
-bool Parser_Type( Qualifier * qualifiers, size_t size )
+bool Parser_Type( LexerRef lexer, Qualifier * qualifiers, size_t size )
 {
-    char type[ 128 ];
-
-    if( sizeof( type ) < Lexer_GetLength() + 1 )
-    {
-        Error( "Buffer too small" );
-        abort();
-    }
+    Symbol type;
 
-    memset( type, 0, sizeof( type ) );
+    type = SYMBOL_NONE;
 
-    if( Lexer_Match( TokenType ) )
+    if( Lexer_Match( lexer, TokenType ) )
     {
-        strncpy( type, Lexer_GetText(), Lexer_GetLength() );
-        Lexer_Advance();
+        type = Lexer_GetSymbol( lexer );
+
+        Lexer_Advance( lexer );
     }
-    else
+    else if( Parser_ImpliesType( qualifiers, size ) == false && Lexer_Match( lexer, TokenID ) && Lexer_Peek( lexer, 1 ) == TokenID )
     {
-        bool hasSign;
-        bool hasSize;
+        /* Two identifiers in a row: the first one was meant as a type */
+        Error( lexer, "Unknown type: %s", Lexer_GetName( lexer, Lexer_GetSymbol( lexer ) ) );
 
-        hasSign = false;
-        hasSize = false;
+        return false;
+    }
 
-        for( size_t i = 0; i < size; i++ )
-        {
-            if( qualifiers[ i ].token == TokenSign )
-            {
-                hasSign = true;
-            }
+    return Parser_ValidType( lexer, type, qualifiers, size );
+}
 
-            if( qualifiers[ i ].token == TokenSize )
-            {
-                hasSize = true;
-            }
+/*
+ * A sign or size qualifier stands for int when there is no type.
+ */
+static bool Parser_ImpliesType( Qualifier * qualifiers, size_t size )
+{
+    for( size_t i = 0; i < size; i++ )
+    {
+        if( qualifiers[ i ].token == TokenSign || qualifiers[ i ].token == TokenSize )
+        {
+            return true;
         }
+    }
 
-        if( hasSign == false && hasSize == false )
-        {
-            Error( "Expected a type" );
+    return false;
+}
 
-            return false;
-        }
+/*
+ * Checks the qualifiers of a type, which is SYMBOL_NONE when there was
+ * none.
+ */
+bool Parser_ValidType( LexerRef lexer, Symbol type, Qualifier * qualifiers, size_t size )
+{
+    if( type == SYMBOL_NONE && Parser_ImpliesType( qualifiers, size ) == false )
+    {
+        Error( lexer, "Expected a type" );
+
+        return false;
     }
 
-    if( Parser_ValidQualifiers( type, qualifiers, size ) )
+    if( Parser_ValidQualifiers( lexer, type, qualifiers, size ) )
     {
         return true;
     }
 
-    Error( "Invalid qualifiers for type: %s", type );
+    Error( lexer, "Invalid qualifiers for type: %s", Lexer_GetName( lexer, type ) );
 
     return false;
 }
 
 /* id_or_pointer_id -> pointer_id | identifier */
-bool Parser_IDOrPointerID( void )
+bool Parser_IDOrPointerID( LexerRef lexer )
 {
-    if( Lexer_Match( TokenLeftParenthesis ) )
+    if( Lexer_Match( lexer, TokenLeftParenthesis ) )
     {
-        return Parser_PointerID();
+        return Parser_PointerID( lexer );
     }
 
-    return Parser_ID();
+    return Parser_ID( lexer );
 }
 
 /*
  * identifier -> ID
  */
-bool Parser_ID( void )
+bool Parser_ID( LexerRef lexer )
 {
     bool error;
 
-    if( Lexer_LegalLookahead( &error, TokenID, TokenEnd ) == false || error )
+    if( Lexer_LegalLookaheadSet( lexer, &error, Parser_FirstID ) == false || error )
     {
-        Error( "Expected identifier" );
+        Error( lexer, "Expected identifier" );
 
         return false;
     }
 
+    if( Parser_ValidID( lexer, Lexer_GetText( lexer ) ) == false )
     {
-        const char * id;
-
-        id = Lexer_GetText();
-
-        if( isdigit( id[ 0 ] ) )
-        {
-            Error( "Bad identifier" );
-
-            return false;
-        }
+        return false;
     }
 
-    Lexer_Advance();
+    Lexer_Advance( lexer );
 
     return true;
 }
 
 /* pointer_id -> LEFT_PARENTHESIS pointers identifier RIGHT_PARENTHESIS */
-bool Parser_PointerID( void )
+bool Parser_PointerID( LexerRef lexer )
 {
-    if( Lexer_Match( TokenLeftParenthesis ) == false )
+    if( Lexer_Match( lexer, TokenLeftParenthesis ) == false )
     {
         return false;
     }
 
-    Lexer_Advance();
+    Lexer_Advance( lexer );
 
-    if( Parser_Pointers() == false )
+    if( Parser_Pointers( lexer ) == false )
     {
         return false;
     }
 
-    if( Parser_ID() == false )
+    if( Parser_ID( lexer ) == false )
     {
         return false;
     }
 
-    if( Lexer_Match( TokenRightParenthesis ) == false )
+    if( Lexer_Match( lexer, TokenRightParenthesis ) == false )
     {
-        Error( "Expected )" );
+        Error( lexer, "Expected )" );
 
         return false;
     }
 
-    Lexer_Advance();
+    Lexer_Advance( lexer );
 
     return true;
 }
@@ -318,84 +326,105 @@ bool Parser_PointerID( void )
  * array_fixed   -> LEFT_BRACKET RIGHT_BRACKET
  * array_dynamic -> LEFT_BRACKET NUMERIC RIGHT_BRACKET
  */
-bool Parser_Array( int * size )
+bool Parser_Array( LexerRef lexer, int * size )
 {
-    if( Lexer_Match( TokenLeftBracket ) == false )
+    if( Lexer_Match( lexer, TokenLeftBracket ) == false )
     {
         return true;
     }
 
-    Lexer_Advance();
+    Lexer_Advance( lexer );
 
-    if( Lexer_Match( TokenRightBracket ) )
+    if( Lexer_Match( lexer, TokenRightBracket ) )
     {
         if( size != NULL )
         {
             *( size ) = -1;
         }
 
-        Lexer_Advance();
+        Lexer_Advance( lexer );
 
         return true;
     }
-    else if( Lexer_Match( TokenNumeric ) )
+    else if( Lexer_Match( lexer, TokenNumeric ) )
     {
-        char s[ 128 ];
-        int  i;
-
-        memset( s, 0, sizeof( s ) );
-
-        if( Lexer_GetLength() + 1 > sizeof( s ) )
-        {
-            Error( "Buffer too small" );
-            abort();
-        }
-
-        strncpy( s, Lexer_GetText(), sizeof( s ) );
+        uint64_t i;
 
-        i = atoi( s );
+        i = Lexer_GetValue( lexer );
 
-        if( i == 0 )
+        if( Parser_ValidArraySize( lexer, i ) == false )
         {
-            Error( "Array size cannot be zero" );
-
             return false;
         }
 
         if( size != NULL )
         {
-            *( size ) = i;
+            *( size ) = ( int )i;
         }
 
-        Lexer_Advance();
+        Lexer_Advance( lexer );
 
-        if( Lexer_Match( TokenRightBracket ) == false )
+        if( Lexer_Match( lexer, TokenRightBracket ) == false )
         {
-            Error( "Expected ]" );
+            Error( lexer, "Expected ]" );
 
             return false;
         }
 
-        Lexer_Advance();
+        Lexer_Advance( lexer );
 
         return true;
     }
     else
     {
-        Error( "Expected array size" );
+        Error( lexer, "Expected array size" );
+
+        return false;
+    }
+}
+
+/*
+ * Identifiers are alphanumeric, but cannot start with a digit.
+ */
+bool Parser_ValidID( LexerRef lexer, const char * id )
+{
+    if( CharClass_Is( id[ 0 ], CharClassDigit ) )
+    {
+        Error( lexer, "Bad identifier" );
+
+        return false;
+    }
+
+    return true;
+}
+
+bool Parser_ValidArraySize( LexerRef lexer, uint64_t size )
+{
+    if( size == 0 )
+    {
+        Error( lexer, "Array size cannot be zero" );
 
         return false;
     }
+
+    if( size > INT_MAX )
+    {
+        Error( lexer, "Array size too large" );
+
+        return false;
+    }
+
+    return true;
 }
 
-bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t size )
+bool Parser_ValidQualifiers( LexerRef lexer, Symbol type, Qualifier * qualifiers, size_t size )
 {
-    bool   isIntegral;
-    bool   isFloat;
-    bool   isChar;
-    char * signQualifier;
-    char * sizeQualifier;
-    size_t longCount;
+    bool        isIntegral;
+    bool        isFloat;
+    bool        isChar;
+    Qualifier * signQualifier;
+    Qualifier * sizeQualifier;
+    size_t      longCount;
 
     isIntegral    = false;
     isFloat       = false;
@@ -404,11 +433,11 @@ bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t s
     sizeQualifier = NULL;
     longCount     = 0;
 
-    if( strcmp( type, "float" ) == 0 || strcmp( type, "double" ) == 0 )
+    if( type == SymbolFloat || type == SymbolDouble )
     {
         isFloat = true;
     }
-    else if( strcmp( type, "char" ) == 0 )
+    else if( type == SymbolChar )
     {
         isChar = true;
     }
@@ -423,19 +452,19 @@ bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t s
 
         q1 = &( qualifiers[ i ] );
 
-        if( q1->token == TokenSize && strcmp( q1->name, "long" ) == 0 )
+        if( q1->token == TokenSize && q1->name == SymbolLong )
         {
             longCount++;
         }
 
         if( q1->token == TokenSign )
         {
-            signQualifier = q1->name;
+            signQualifier = q1;
         }
 
         if( q1->token == TokenSize )
         {
-            sizeQualifier = q1->name;
+            sizeQualifier = q1;
         }
 
         for( size_t j = 0; j < size; j++ )
@@ -452,10 +481,10 @@ bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t s
             if( q1->token == q2->token )
             {
                 if( q1->token != TokenSize
-                    || strcmp( q1->name, "long" ) != 0
-                    || strcmp( q2->name, "long" ) != 0 )
+                    || q1->name != SymbolLong
+                    || q2->name != SymbolLong )
                 {
-                    Error( "Duplicate qualifier: %s", q1->name );
+                    Error( lexer, "Duplicate qualifier: %s", Lexer_GetName( lexer, q1->name ) );
 
                     return false;
                 }
@@ -467,7 +496,7 @@ bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t s
     {
         if( isFloat )
         {
-            Error( "Invalid sign qualifier for floating point type: %s %s", signQualifier, type );
+            Error( lexer, "Invalid sign qualifier for floating point type: %s %s", Lexer_GetName( lexer, signQualifier->name ), Lexer_GetName( lexer, type ) );
 
             return false;
         }
@@ -476,28 +505,28 @@ bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t s
     {
         if( isChar )
         {
-            Error( "Invalid size qualifier for char type: %s %s", sizeQualifier, type );
+            Error( lexer, "Invalid size qualifier for char type: %s %s", Lexer_GetName( lexer, sizeQualifier->name ), Lexer_GetName( lexer, type ) );
 
             return false;
         }
-        else if( isFloat && strcmp( type, "double" ) == 0 && strcmp( sizeQualifier, "long" ) == 0 )
+        else if( isFloat && type == SymbolDouble && sizeQualifier->name == SymbolLong )
         {
             if( longCount > 1 )
             {
-                Error( "Invalid size qualifier for floating point type: %s(%zu) %s", sizeQualifier, longCount, type );
+                Error( lexer, "Invalid size qualifier for floating point type: %s(%zu) %s", Lexer_GetName( lexer, sizeQualifier->name ), longCount, Lexer_GetName( lexer, type ) );
 
                 return false;
             }
         }
         else if( isFloat )
         {
-            Error( "Invalid size qualifier for floating point type: %s %s", sizeQualifier, type );
+            Error( lexer, "Invalid size qualifier for floating point type: %s %s", Lexer_GetName( lexer, sizeQualifier->name ), Lexer_GetName( lexer, type ) );
 
             return false;
         }
-        else if( isIntegral && strcmp( sizeQualifier, "long" ) == 0 && longCount > 2 )
+        else if( isIntegral && sizeQualifier->name == SymbolLong && longCount > 2 )
         {
-            Error( "Invalid size qualifier for integral type: %s(%zu) %s", sizeQualifier, longCount, type );
+            Error( lexer, "Invalid size qualifier for integral type: %s(%zu) %s", Lexer_GetName( lexer, sizeQualifier->name ), longCount, Lexer_GetName( lexer, type ) );
 
             return false;
         }
@@ -33,24 +33,41 @@
 #define PARSER_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include "Lexer.h"
 
 typedef struct
 {
-    Token token;
-    char  name[ 128 ];
+    Token  token;
+    Symbol name;
 } Qualifier;
 
-void Parser_Statements( void );
-bool Parser_Declaration( void );
-bool Parser_Qualifiers( Qualifier * qualifiers, size_t * size );
-bool Parser_Pointers( void );
-bool Parser_Type( Qualifier * qualifiers, size_t size );
-bool Parser_IDOrPointerID( void );
-bool Parser_ID( void );
-bool Parser_PointerID( void );
-bool Parser_Array( int * size );
-bool Parser_ValidQualifiers( const char * type, Qualifier * qualifiers, size_t size );
+/*
+ * Value of a symbol of LALR.y: the token and symbol of a token, its value
+ * if it is a number, and its line.
+ */
+typedef struct
+{
+    Token    token;
+    Symbol   name;
+    uint64_t value;
+    size_t   line;
+} ParserValue;
+
+void Parser_Statements( LexerRef lexer );
+bool Parser_Declaration( LexerRef lexer );
+bool Parser_Qualifiers( LexerRef lexer, Qualifier * qualifiers, size_t * size );
+bool Parser_Pointers( LexerRef lexer );
+bool Parser_Type( LexerRef lexer, Qualifier * qualifiers, size_t size );
+bool Parser_IDOrPointerID( LexerRef lexer );
+bool Parser_ID( LexerRef lexer );
+bool Parser_PointerID( LexerRef lexer );
+bool Parser_Array( LexerRef lexer, int * size );
+bool Parser_ValidPointerQualifiers( LexerRef lexer, Qualifier * qualifiers, size_t size );
+bool Parser_ValidType( LexerRef lexer, Symbol type, Qualifier * qualifiers, size_t size );
+bool Parser_ValidID( LexerRef lexer, const char * id );
+bool Parser_ValidArraySize( LexerRef lexer, uint64_t size );
+bool Parser_ValidQualifiers( LexerRef lexer, Symbol type, Qualifier * qualifiers, size_t size );
 
 #endif /* PARSER_H */
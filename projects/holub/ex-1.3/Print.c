@@ -39,41 +39,71 @@
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
 #endif
 
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap );
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap )
+/*
+ * The stream is locked for the whole message, so messages from lexers
+ * running on different threads are never interleaved.
+ * Messages not tied to a lexer, like I/O errors, have no line number: lines
+ * start at 1, so they are given line 0.
+ */
+void Print( FILE * fh, size_t line, const char * level, const char * fmt, va_list ap );
+void Print( FILE * fh, size_t line, const char * level, const char * fmt, va_list ap )
 {
-    fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, Lexer_GetLine() );
+    flockfile( fh );
+
+    if( line == 0 )
+    {
+        fprintf( fh, "*** [ %s ]> ", level );
+    }
+    else
+    {
+        fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, line );
+    }
+
     vfprintf( fh, fmt, ap );
     fprintf( fh, "\n" );
+    funlockfile( fh );
 }
 
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
 
-void Error( const char * fmt, ... )
+void Error( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "ERROR", fmt, ap );
+    Print( stderr, ( lexer == NULL ) ? 0 : Lexer_GetLine( lexer ), "ERROR", fmt, ap );
     va_end( ap );
 }
 
-void Warning( const char * fmt, ... )
+void Warning( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "WARNING", fmt, ap );
+    Print( stderr, ( lexer == NULL ) ? 0 : Lexer_GetLine( lexer ), "WARNING", fmt, ap );
     va_end( ap );
 }
 
-void Debug( const char * fmt, ... )
+void Debug( LexerRef lexer, const char * fmt, ... )
+{
+    va_list ap;
+
+    va_start( ap, fmt );
+    Print( stdout, ( lexer == NULL ) ? 0 : Lexer_GetLine( lexer ), "DEBUG", fmt, ap );
+    va_end( ap );
+}
+
+/*
+ * Debug output for a given line, rather than the line of the current
+ * token, for actions run once the parser has read past their input.
+ */
+void DebugAt( size_t line, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stdout, "DEBUG", fmt, ap );
+    Print( stdout, line, "DEBUG", fmt, ap );
     va_end( ap );
 }
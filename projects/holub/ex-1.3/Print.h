@@ -32,8 +32,12 @@
 #ifndef PRINT_H
 #define PRINT_H
 
-void Error( const char * fmt, ... );
-void Warning( const char * fmt, ... );
-void Debug( const char * fmt, ... );
+#include "Lexer.h"
+#include <stddef.h>
+
+void Error( LexerRef lexer, const char * fmt, ... );
+void Warning( LexerRef lexer, const char * fmt, ... );
+void Debug( LexerRef lexer, const char * fmt, ... );
+void DebugAt( size_t line, const char * fmt, ... );
 
 #endif /* PRINT_H */
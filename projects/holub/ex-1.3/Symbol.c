@@ -0,0 +1,307 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Symbol.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Symbol.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    size_t   offset;
+    size_t   length;
+    uint32_t hash;
+} SymbolEntry;
+
+/*
+ * Names are copied once, NUL terminated, into a single buffer.
+ * Lookups go through an open-addressing hash with linear probing, whose
+ * slots hold a symbol plus one, zero meaning empty. It is kept at most
+ * half full.
+ */
+struct SymbolTable
+{
+    uint64_t      rc;
+    uint32_t *    slots;
+    size_t        slotCount;
+    SymbolEntry * entries;
+    size_t        count;
+    size_t        capacity;
+    char *        names;
+    size_t        namesLength;
+    size_t        namesCapacity;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static uint32_t SymbolTable_Hash( const char * text, size_t length );
+static bool     SymbolTable_Grow( SymbolTableRef table );
+static bool     SymbolTable_Store( SymbolTableRef table, const char * text, size_t length, uint32_t hash );
+
+SymbolTableRef SymbolTable_Create( void )
+{
+    SymbolTableRef table;
+
+    if( ( table = calloc( 1, sizeof( struct SymbolTable ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    table->rc = 1;
+
+    return table;
+}
+
+SymbolTableRef SymbolTable_Retain( SymbolTableRef table )
+{
+    if( table == NULL )
+    {
+        return NULL;
+    }
+
+    table->rc++;
+
+    return table;
+}
+
+void SymbolTable_Release( SymbolTableRef table )
+{
+    if( table == NULL )
+    {
+        return;
+    }
+
+    if( --( table->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( table->slots );
+    free( table->entries );
+    free( table->names );
+    free( table );
+}
+
+/*
+ * FNV-1a.
+ */
+static uint32_t SymbolTable_Hash( const char * text, size_t length )
+{
+    uint32_t hash;
+
+    hash = 2166136261U;
+
+    for( size_t i = 0; i < length; i++ )
+    {
+        hash ^= ( unsigned char )text[ i ];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+/*
+ * Doubles the number of slots and re-inserts every symbol, using the
+ * stored hashes.
+ */
+static bool SymbolTable_Grow( SymbolTableRef table )
+{
+    size_t     slotCount;
+    uint32_t * slots;
+    size_t     mask;
+
+    slotCount = ( table->slotCount == 0 ) ? 64 : table->slotCount * 2;
+
+    if( ( slots = calloc( slotCount, sizeof( *( slots ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    mask = slotCount - 1;
+
+    for( size_t i = 0; i < table->count; i++ )
+    {
+        size_t slot;
+
+        for( slot = table->entries[ i ].hash & mask; slots[ slot ] != 0; slot = ( slot + 1 ) & mask )
+        {}
+
+        slots[ slot ] = ( uint32_t )( i + 1 );
+    }
+
+    free( table->slots );
+
+    table->slots     = slots;
+    table->slotCount = slotCount;
+
+    return true;
+}
+
+/*
+ * Copies a new name and adds its entry, without touching the slots.
+ */
+static bool SymbolTable_Store( SymbolTableRef table, const char * text, size_t length, uint32_t hash )
+{
+    SymbolEntry * entry;
+
+    if( table->count == table->capacity )
+    {
+        size_t        capacity;
+        SymbolEntry * entries;
+
+        capacity = ( table->capacity == 0 ) ? 64 : table->capacity * 2;
+
+        if( ( entries = realloc( table->entries, capacity * sizeof( *( entries ) ) ) ) == NULL )
+        {
+            return false;
+        }
+
+        table->entries  = entries;
+        table->capacity = capacity;
+    }
+
+    while( table->namesLength + length + 1 > table->namesCapacity )
+    {
+        size_t capacity;
+        char * names;
+
+        capacity = ( table->namesCapacity == 0 ) ? 1024 : table->namesCapacity * 2;
+
+        if( ( names = realloc( table->names, capacity ) ) == NULL )
+        {
+            return false;
+        }
+
+        table->names         = names;
+        table->namesCapacity = capacity;
+    }
+
+    entry         = &( table->entries[ table->count ] );
+    entry->offset = table->namesLength;
+    entry->length = length;
+    entry->hash   = hash;
+
+    memcpy( table->names + table->namesLength, text, length );
+
+    table->names[ table->namesLength + length ] = 0;
+    table->namesLength                         += length + 1;
+
+    table->count++;
+
+    return true;
+}
+
+/*
+ * Returns the symbol for a name, adding the name if it wasn't seen before,
+ * or SYMBOL_NONE if out of memory.
+ */
+Symbol SymbolTable_Intern( SymbolTableRef table, const char * text, size_t length )
+{
+    uint32_t hash;
+    size_t   mask;
+    size_t   slot;
+
+    if( table == NULL || table->count >= SYMBOL_NONE - 1 )
+    {
+        return SYMBOL_NONE;
+    }
+
+    if( ( table->count + 1 ) * 2 > table->slotCount && SymbolTable_Grow( table ) == false )
+    {
+        return SYMBOL_NONE;
+    }
+
+    hash = SymbolTable_Hash( text, length );
+    mask = table->slotCount - 1;
+
+    for( slot = hash & mask; table->slots[ slot ] != 0; slot = ( slot + 1 ) & mask )
+    {
+        const SymbolEntry * entry;
+
+        entry = &( table->entries[ table->slots[ slot ] - 1 ] );
+
+        if( entry->hash == hash && entry->length == length && memcmp( table->names + entry->offset, text, length ) == 0 )
+        {
+            return table->slots[ slot ] - 1;
+        }
+    }
+
+    if( SymbolTable_Store( table, text, length, hash ) == false )
+    {
+        return SYMBOL_NONE;
+    }
+
+    table->slots[ slot ] = ( uint32_t )( table->count );
+
+    return ( Symbol )( table->count - 1 );
+}
+
+size_t SymbolTable_GetCount( SymbolTableRef table )
+{
+    if( table == NULL )
+    {
+        return 0;
+    }
+
+    return table->count;
+}
+
+/*
+ * Returns the NUL terminated name of a symbol, or an empty string for
+ * SYMBOL_NONE.
+ * The pointer is only valid until the next call to SymbolTable_Intern.
+ */
+const char * SymbolTable_GetName( SymbolTableRef table, Symbol symbol )
+{
+    if( table == NULL || symbol >= table->count )
+    {
+        return "";
+    }
+
+    return table->names + table->entries[ symbol ].offset;
+}
+
+size_t SymbolTable_GetLength( SymbolTableRef table, Symbol symbol )
+{
+    if( table == NULL || symbol >= table->count )
+    {
+        return 0;
+    }
+
+    return table->entries[ symbol ].length;
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Symbol.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Identifies a distinct name. Symbols are numbered from zero in the order
+ * they were first interned, so equal names always get equal symbols.
+ */
+typedef uint32_t Symbol;
+
+#define SYMBOL_NONE UINT32_MAX
+
+typedef struct SymbolTable * SymbolTableRef;
+
+SymbolTableRef SymbolTable_Create( void );
+SymbolTableRef SymbolTable_Retain( SymbolTableRef table );
+void           SymbolTable_Release( SymbolTableRef table );
+Symbol         SymbolTable_Intern( SymbolTableRef table, const char * text, size_t length );
+size_t         SymbolTable_GetCount( SymbolTableRef table );
+const char *   SymbolTable_GetName( SymbolTableRef table, Symbol symbol );
+size_t         SymbolTable_GetLength( SymbolTableRef table, Symbol symbol );
+
+#endif /* SYMBOL_H */
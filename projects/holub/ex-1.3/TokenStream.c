@@ -0,0 +1,239 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TokenStream.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "TokenStream.h"
+#include <stdlib.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Tokens are stored as parallel arrays rather than as an array of structs,
+ * so a parser matching kinds only touches the kinds array.
+ */
+struct TokenStream
+{
+    uint64_t   rc;
+    uint8_t *  kinds;
+    uint64_t * offsets;
+    uint32_t * lengths;
+    uint32_t * lines;
+    uint32_t * symbols;
+    size_t     count;
+    size_t     capacity;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static bool TokenStream_Grow( TokenStreamRef stream );
+
+TokenStreamRef TokenStream_Create( void )
+{
+    TokenStreamRef stream;
+
+    if( ( stream = calloc( 1, sizeof( struct TokenStream ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    stream->rc = 1;
+
+    return stream;
+}
+
+TokenStreamRef TokenStream_Retain( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    stream->rc++;
+
+    return stream;
+}
+
+void TokenStream_Release( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return;
+    }
+
+    if( --( stream->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( stream->kinds );
+    free( stream->offsets );
+    free( stream->lengths );
+    free( stream->lines );
+    free( stream->symbols );
+    free( stream );
+}
+
+static bool TokenStream_Grow( TokenStreamRef stream )
+{
+    size_t     capacity;
+    uint8_t *  kinds;
+    uint64_t * offsets;
+    uint32_t * lengths;
+    uint32_t * lines;
+    uint32_t * symbols;
+
+    capacity = ( stream->capacity == 0 ) ? 1024 : stream->capacity * 2;
+
+    if( ( kinds = realloc( stream->kinds, capacity * sizeof( *( kinds ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    stream->kinds = kinds;
+
+    if( ( offsets = realloc( stream->offsets, capacity * sizeof( *( offsets ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    stream->offsets = offsets;
+
+    if( ( lengths = realloc( stream->lengths, capacity * sizeof( *( lengths ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    stream->lengths = lengths;
+
+    if( ( lines = realloc( stream->lines, capacity * sizeof( *( lines ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    stream->lines = lines;
+
+    if( ( symbols = realloc( stream->symbols, capacity * sizeof( *( symbols ) ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    stream->symbols  = symbols;
+    stream->capacity = capacity;
+
+    return true;
+}
+
+bool TokenStream_Append( TokenStreamRef stream, uint8_t kind, uint64_t offset, uint32_t length, uint32_t line, uint32_t symbol )
+{
+    if( stream == NULL )
+    {
+        return false;
+    }
+
+    if( stream->count == stream->capacity && TokenStream_Grow( stream ) == false )
+    {
+        return false;
+    }
+
+    stream->kinds[ stream->count ]   = kind;
+    stream->offsets[ stream->count ] = offset;
+    stream->lengths[ stream->count ] = length;
+    stream->lines[ stream->count ]   = line;
+    stream->symbols[ stream->count ] = symbol;
+
+    stream->count++;
+
+    return true;
+}
+
+size_t TokenStream_GetCount( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return 0;
+    }
+
+    return stream->count;
+}
+
+const uint8_t * TokenStream_GetKinds( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    return stream->kinds;
+}
+
+const uint64_t * TokenStream_GetOffsets( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    return stream->offsets;
+}
+
+const uint32_t * TokenStream_GetLengths( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    return stream->lengths;
+}
+
+const uint32_t * TokenStream_GetLines( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    return stream->lines;
+}
+
+const uint32_t * TokenStream_GetSymbols( TokenStreamRef stream )
+{
+    if( stream == NULL )
+    {
+        return NULL;
+    }
+
+    return stream->symbols;
+}
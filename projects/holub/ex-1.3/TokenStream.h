@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      TokenStream.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct TokenStream * TokenStreamRef;
+
+TokenStreamRef   TokenStream_Create( void );
+TokenStreamRef   TokenStream_Retain( TokenStreamRef stream );
+void             TokenStream_Release( TokenStreamRef stream );
+bool             TokenStream_Append( TokenStreamRef stream, uint8_t kind, uint64_t offset, uint32_t length, uint32_t line, uint32_t symbol );
+size_t           TokenStream_GetCount( TokenStreamRef stream );
+const uint8_t *  TokenStream_GetKinds( TokenStreamRef stream );
+const uint64_t * TokenStream_GetOffsets( TokenStreamRef stream );
+const uint32_t * TokenStream_GetLengths( TokenStreamRef stream );
+const uint32_t * TokenStream_GetLines( TokenStreamRef stream );
+const uint32_t * TokenStream_GetSymbols( TokenStreamRef stream );
+
+#endif /* TOKEN_STREAM_H */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Tokens.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef TOKENS_H
+#define TOKENS_H
+
+/*
+ * The tokens, in the order of their values. This is the only place they
+ * are defined: the Token enum, the names returned by Token_GetName() and
+ * the cases of the lexer matching single characters are all expanded from
+ * this table.
+ *
+ *     TOKEN( name, text )             Scanned by the lexer's own code
+ *     PUNCTUATOR( name, c, text )     A single character
+ */
+#define TOKENS( TOKEN, PUNCTUATOR )                          \
+    TOKEN(      TokenEnd,                   "end of input" ) \
+    PUNCTUATOR( TokenSemicolon,        ';', ";"            ) \
+    PUNCTUATOR( TokenLeftParenthesis,  '(', "("            ) \
+    PUNCTUATOR( TokenRightParenthesis, ')', ")"            ) \
+    PUNCTUATOR( TokenLeftBracket,      '[', "["            ) \
+    PUNCTUATOR( TokenRightBracket,     ']', "]"            ) \
+    TOKEN(      TokenConst,                 "const"        ) \
+    TOKEN(      TokenVolatile,              "volatile"     ) \
+    TOKEN(      TokenSign,                  "sign"         ) \
+    TOKEN(      TokenSize,                  "size"         ) \
+    PUNCTUATOR( TokenPointer,          '*', "*"            ) \
+    TOKEN(      TokenType,                  "type"         ) \
+    TOKEN(      TokenID,                    "identifier"   ) \
+    TOKEN(      TokenNumeric,               "number"       )
+
+/*
+ * The keywords, each with its first two characters and its length, which
+ * Lexer_KeywordHash() is computed from, the token it is lexed as, the
+ * constant Symbol it is interned as, in this order, and its slot in the
+ * lexer's keywords table, which must be its hash:
+ *
+ *     KEYWORD( text, c0, c1, length, token, symbol, slot )
+ */
+#define KEYWORDS( KEYWORD )                                               \
+    KEYWORD( "const",    'c', 'o', 5, TokenConst,    SymbolConst,     0 ) \
+    KEYWORD( "volatile", 'v', 'o', 8, TokenVolatile, SymbolVolatile, 22 ) \
+    KEYWORD( "signed",   's', 'i', 6, TokenSign,     SymbolSigned,    1 ) \
+    KEYWORD( "unsigned", 'u', 'n', 8, TokenSign,     SymbolUnsigned, 13 ) \
+    KEYWORD( "short",    's', 'h', 5, TokenSize,     SymbolShort,    24 ) \
+    KEYWORD( "long",     'l', 'o', 4, TokenSize,     SymbolLong,      8 ) \
+    KEYWORD( "char",     'c', 'h', 4, TokenType,     SymbolChar,      7 ) \
+    KEYWORD( "int",      'i', 'n', 3, TokenType,     SymbolInt,      28 ) \
+    KEYWORD( "float",    'f', 'l', 5, TokenType,     SymbolFloat,    11 ) \
+    KEYWORD( "double",   'd', 'o', 6, TokenType,     SymbolDouble,    2 )
+
+/*
+ * FIRST( identifier ), the tokens the parser accepts as a lookahead for a
+ * declared name. Expanded with TOKEN_SET_OF() into a constant TokenSet.
+ */
+#define FIRST_IDENTIFIER( TOKEN ) \
+    TOKEN( TokenID )
+
+#endif /* TOKENS_H */
@@ -30,11 +30,113 @@
  */
 
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
 #include "Parser.h"
+#include "LALR.h"
+#include "Lexer.h"
+#include "Input.h"
+#include "Bench.h"
 
-int main( void )
+/*
+ * Runs the LALR parser, which stops at the first syntax error. Like the
+ * hand-written parser, it then resumes after the next semicolon, so the
+ * later declarations are still checked, and all errors reported. Returns
+ * false if any error was found.
+ */
+static bool Main_ParseLALR( LexerRef lexer )
+{
+    bool ok;
+
+    ok = true;
+
+    while( LALR_Parse( lexer ) == false )
+    {
+        ok = false;
+
+        while( Lexer_Match( lexer, TokenSemicolon ) == false && Lexer_Match( lexer, TokenEnd ) == false )
+        {
+            Lexer_Advance( lexer );
+        }
+
+        if( Lexer_Match( lexer, TokenEnd ) )
+        {
+            break;
+        }
+
+        Lexer_Advance( lexer );
+    }
+
+    return ok;
+}
+
+int main( int argc, char * argv[] )
 {
-    Parser_Statements();
+    const char * path;
+    bool         tokenize;
+    bool         lalr;
+    InputRef     input;
+    LexerRef     lexer;
+    int          status;
+
+    path     = NULL;
+    tokenize = false;
+    lalr     = false;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( strcmp( argv[ i ], "--bench-dfa" ) == 0 )
+        {
+            return Bench_DFA();
+        }
+        else if( strcmp( argv[ i ], "--bench-lr" ) == 0 )
+        {
+            return Bench_LR();
+        }
+        else if( strcmp( argv[ i ], "--tokens" ) == 0 )
+        {
+            tokenize = true;
+        }
+        else if( strcmp( argv[ i ], "--lr" ) == 0 )
+        {
+            lalr = true;
+        }
+        else
+        {
+            path = argv[ i ];
+        }
+    }
+
+    input = ( path == NULL ) ? Input_Create( STDIN_FILENO ) : Input_CreateWithFile( path );
+    lexer = Lexer_Create( input );
+
+    Input_Release( input );
+
+    if( lexer == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    status = EXIT_SUCCESS;
+
+    if( tokenize && Lexer_Tokenize( lexer ) == false )
+    {
+        status = EXIT_FAILURE;
+    }
+    else if( lalr )
+    {
+        if( Main_ParseLALR( lexer ) == false )
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        Parser_Statements( lexer );
+    }
+
+    Lexer_Release( lexer );
 
-    return EXIT_SUCCESS;
+    return status;
 }
@@ -31,138 +31,305 @@
 
 #include "Lexer.h"
 #include "Print.h"
+#include "Input.h"
+#include "CharClass.h"
+#include "Number.h"
 #include <stdio.h>
-#include <ctype.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
 
-static char * Lexer_Text      = "";
-static size_t Lexer_Length    = 0;
-static size_t Lexer_Line      = 0;
-static int    Lexer_Lookahead = -1;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
 
-const char * Lexer_GetText( void )
+/*
+ * Everything the lexer knows about a compilation lives here rather than in
+ * file-level globals, so independent inputs can be lexed on separate
+ * threads, each with its own lexer.
+ */
+struct Lexer
+{
+    uint64_t rc;
+    InputRef input;
+    char *   text;
+    size_t   length;
+    size_t   line;
+    uint64_t value;
+    int      lookahead;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+LexerRef Lexer_Create( InputRef input )
+{
+    LexerRef lexer;
+
+    if( input == NULL || ( lexer = calloc( 1, sizeof( struct Lexer ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->rc        = 1;
+    lexer->input     = Input_Retain( input );
+    lexer->line      = 1;
+    lexer->lookahead = -1;
+
+    return lexer;
+}
+
+LexerRef Lexer_Retain( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return NULL;
+    }
+
+    lexer->rc++;
+
+    return lexer;
+}
+
+void Lexer_Release( LexerRef lexer )
+{
+    if( lexer == NULL )
+    {
+        return;
+    }
+
+    if( --( lexer->rc ) > 0 )
+    {
+        return;
+    }
+
+    Input_Release( lexer->input );
+    free( lexer );
+}
+
+InputRef Lexer_GetInput( LexerRef lexer )
 {
-    return Lexer_Text;
+    return lexer->input;
 }
 
-size_t Lexer_GetLength( void )
+const char * Lexer_GetText( LexerRef lexer )
 {
-    return Lexer_Length;
+    return lexer->text;
 }
 
-size_t Lexer_GetLine( void )
+size_t Lexer_GetLength( LexerRef lexer )
 {
-    return Lexer_Line;
+    return lexer->length;
 }
 
-Token Lexer_GetCurrent( void )
+uint64_t Lexer_GetValue( LexerRef lexer )
 {
-    return ( Token )Lexer_Lookahead;
+    return lexer->value;
 }
 
-Token Lexer_Next( void )
+Span Lexer_GetSpan( LexerRef lexer )
 {
-    static char buf[ 128 ];
-    char *      current;
+    Span span;
 
-    current = Lexer_Text + Lexer_Length;
+    span.offset = ( lexer->text == NULL ) ? 0 : Input_GetOffset( lexer->input, lexer->text );
+    span.length = lexer->length;
+
+    return span;
+}
+
+size_t Lexer_GetLine( LexerRef lexer )
+{
+    return lexer->line;
+}
+
+Token Lexer_GetCurrent( LexerRef lexer )
+{
+    return ( Token )lexer->lookahead;
+}
+
+#define TOKEN_NAME( name, text )         [ name ] = text,
+#define PUNCTUATOR_NAME( name, c, text ) [ name ] = text,
+
+static const char * const Token_Names[ TokenCount ] =
+{
+    TOKENS( TOKEN_NAME, PUNCTUATOR_NAME )
+};
+
+#undef TOKEN_NAME
+#undef PUNCTUATOR_NAME
+
+const char * Token_GetName( Token token )
+{
+    if( ( unsigned int )token >= TokenCount )
+    {
+        return "unknown token";
+    }
+
+    return Token_Names[ token ];
+}
+
+/*
+ * Single characters are matched by cases expanded from the tokens table.
+ */
+#define TOKEN_CASE( name, text )
+#define PUNCTUATOR_CASE( name, c, text ) case c: return name;
+
+Token Lexer_Next( LexerRef lexer )
+{
+    char *        current;
+    unsigned char classes;
+
+    current = ( lexer->text == NULL ) ? Input_GetStart( lexer->input ) : lexer->text + lexer->length;
+    lexer->value = 0;
 
     while( true )
     {
-        while( *( current ) == 0 )
+        lexer->text   = current;
+        lexer->length = 1;
+
+        switch( *( current ) )
         {
-            current = buf;
+            case 0:
 
-            if( fgets( buf, sizeof( buf ), stdin ) == NULL )
-            {
-                *( current ) = 0;
+                if( Input_Fill( lexer->input, &( lexer->text ), &current ) )
+                {
+                    break;
+                }
 
-                return TokenEnd;
-            }
+                if( Input_IsEnd( lexer->input, current ) )
+                {
+                    lexer->length = 0;
 
-            Lexer_Line++;
+                    return TokenEnd;
+                }
+
+                Warning( lexer, "Ignoring illegal input: NUL" );
 
-            while( isspace( *( current ) ) )
-            {
                 current++;
-            }
-        }
 
-        for( ; *( current ) != 0; current++ )
-        {
-            Lexer_Text   = current;
-            Lexer_Length = 1;
+                break;
 
-            switch( *( current ) )
-            {
-                case EOF: return TokenEnd;
-                case '.': return TokenPeriod;
+            TOKENS( TOKEN_CASE, PUNCTUATOR_CASE )
+
+            case '\n':
+
+                lexer->line++;
+                current++;
+
+                break;
 
-                case '\n':
-                case '\t':
-                case ' ':
+            case '\r':
+            case '\t':
+            case ' ':
+
+                current++;
+
+                break;
+
+            default:
+
+                if( CharClass_Is( *( current ), CharClassSpace ) )
+                {
+                    current++;
 
                     break;
+                }
 
-                default:
+                if( CharClass_Is( *( current ), CharClassAlnum ) == false )
+                {
+                    Warning( lexer, "Ignoring illegal input: %c", *( current ) );
 
-                    if( isalnum( *( current ) ) == false )
-                    {
-                        Warning( "Ignoring illegal input: %c", *( current ) );
+                    current++;
 
-                        break;
-                    }
+                    break;
+                }
+
+                classes = CharClassNone;
 
-                    while( isalnum( *( current ) ) )
+                do
+                {
+                    while( CharClass_Is( *( current ), CharClassAlnum ) )
                     {
+                        classes |= CharClass_Get( *( current ) );
                         current++;
                     }
+                }
+                while( Input_Fill( lexer->input, &( lexer->text ), &current ) );
 
-                    Lexer_Length = ( uintptr_t )current - ( uintptr_t )Lexer_Text;
+                lexer->length = ( uintptr_t )current - ( uintptr_t )lexer->text;
 
-                    for( size_t i = 0; i < Lexer_Length; i++ )
-                    {
-                        if( isdigit( Lexer_Text[ i ] ) == false )
-                        {
-                            return TokenWord;
-                        }
-                    }
+                if( ( classes & CharClassAlpha ) != 0 )
+                {
+                    return TokenWord;
+                }
 
-                    return TokenNumeric;
-            }
+                if( Number_Decode( lexer->text, lexer->length, &( lexer->value ) ) == NumberOverflow )
+                {
+                    Error( lexer, "Numeric literal too large: %.*s", ( int )( lexer->length ), lexer->text );
+                }
+
+                return TokenNumeric;
         }
     }
 }
 
-void Lexer_Advance( void )
+#undef TOKEN_CASE
+#undef PUNCTUATOR_CASE
+
+void Lexer_Advance( LexerRef lexer )
 {
-    Lexer_Lookahead = ( int )( Lexer_Next() );
+    lexer->lookahead = ( int )( Lexer_Next( lexer ) );
 }
 
-void Lexer_Discard( void )
+/*
+ * Discards the rest of the current line.
+ */
+void Lexer_Discard( LexerRef lexer )
 {
-    Lexer_Text      = "";
-    Lexer_Length    = 0;
-    Lexer_Lookahead = -1;
+    char * current;
+
+    current = ( lexer->text == NULL ) ? Input_GetStart( lexer->input ) : lexer->text + lexer->length;
+    lexer->value = 0;
+
+    while( *( current ) != '\n' )
+    {
+        if( *( current ) == 0 && Input_IsEnd( lexer->input, current ) )
+        {
+            if( Input_Fill( lexer->input, &current, &current ) == false )
+            {
+                break;
+            }
+        }
+        else
+        {
+            current++;
+        }
+    }
+
+    lexer->text      = current;
+    lexer->length    = 0;
+    lexer->lookahead = -1;
 }
 
-bool Lexer_Match( Token token )
+bool Lexer_Match( LexerRef lexer, Token token )
 {
-    if( Lexer_Lookahead == -1 )
+    if( lexer->lookahead == -1 )
     {
-        Lexer_Advance();
+        Lexer_Advance( lexer );
     }
 
-    return ( int )token == Lexer_Lookahead;
+    return ( int )token == lexer->lookahead;
 }
 
-bool Lexer_Compare( const char * value )
+bool Lexer_Compare( LexerRef lexer, const char * value )
 {
-    return strncmp( value, Lexer_Text, Lexer_Length ) == 0;
+    return strncmp( value, lexer->text, lexer->length ) == 0;
 }
 
-bool Lexer_LegalLookahead( bool * error, Token first, ... )
+bool Lexer_LegalLookahead( LexerRef lexer, bool * error, Token first, ... )
 {
     va_list ap;
     bool    ret;
@@ -178,7 +345,7 @@ bool Lexer_LegalLookahead( bool * error, Token first, ... )
 
     if( first == TokenEnd )
     {
-        if( Lexer_Match( TokenEnd ) )
+        if( Lexer_Match( lexer, TokenEnd ) )
         {
             ret = true;
         }
@@ -198,11 +365,11 @@ bool Lexer_LegalLookahead( bool * error, Token first, ... )
             *( p++ ) = token;
         }
 
-        while( Lexer_Match( TokenPeriod ) == false )
+        while( Lexer_Match( lexer, TokenPeriod ) == false )
         {
             for( current = lookaheads; current < p; current++ )
             {
-                if( Lexer_Match( *( current ) ) )
+                if( Lexer_Match( lexer, *( current ) ) )
                 {
                     ret = true;
 
@@ -215,7 +382,7 @@ bool Lexer_LegalLookahead( bool * error, Token first, ... )
                 *( error ) = true;
             }
 
-            Lexer_Advance();
+            Lexer_Advance( lexer );
         }
     }
 
@@ -226,21 +393,21 @@ done:
     return ret == true;
 }
 
-bool Lexer_HasNext( Token token )
+bool Lexer_HasNext( LexerRef lexer, Token token )
 {
     char * text;
     size_t length;
     int    lookahead;
     bool   ret;
 
-    text      = Lexer_Text;
-    length    = Lexer_Length;
-    lookahead = Lexer_Lookahead;
-    ret       = Lexer_LegalLookahead( NULL, token, TokenEnd );
+    text      = lexer->text;
+    length    = lexer->length;
+    lookahead = lexer->lookahead;
+    ret       = Lexer_LegalLookahead( lexer, NULL, token, TokenEnd );
 
-    Lexer_Text      = text;
-    Lexer_Length    = length;
-    Lexer_Lookahead = lookahead;
+    lexer->text      = text;
+    lexer->length    = length;
+    lexer->lookahead = lookahead;
 
     return ret;
 }
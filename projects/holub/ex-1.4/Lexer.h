@@ -33,27 +33,45 @@
 #define LEXER_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include "Tokens.h"
+#include "Input.h"
+
+#define TOKEN_ENUM( name, text )         name,
+#define PUNCTUATOR_ENUM( name, c, text ) name,
 
 typedef enum
 {
-    TokenEnd     = 0, /* End of input */
-    TokenPeriod  = 1, /* : */
-    TokenNumeric = 2, /* Numeric value */
-    TokenWord    = 3  /* Word */
+    TOKENS( TOKEN_ENUM, PUNCTUATOR_ENUM )
+    TokenCount
 } Token;
 
-const char * Lexer_GetText( void );
-size_t       Lexer_GetLength( void );
-size_t       Lexer_GetLine( void );
-Token        Lexer_GetCurrent( void );
-
-Token Lexer_Next( void );
-void  Lexer_Advance( void );
-void  Lexer_Discard( void );
-bool  Lexer_Match( Token token );
-bool  Lexer_Compare( const char * value );
-bool  Lexer_LegalLookahead( bool * error, Token first, ... );
-bool  Lexer_HasNext( Token token );
+#undef TOKEN_ENUM
+#undef PUNCTUATOR_ENUM
+
+const char * Token_GetName( Token token );
+
+typedef struct Lexer * LexerRef;
+
+LexerRef Lexer_Create( InputRef input );
+LexerRef Lexer_Retain( LexerRef lexer );
+void     Lexer_Release( LexerRef lexer );
+InputRef Lexer_GetInput( LexerRef lexer );
+
+const char * Lexer_GetText( LexerRef lexer );
+size_t       Lexer_GetLength( LexerRef lexer );
+uint64_t     Lexer_GetValue( LexerRef lexer );
+Span         Lexer_GetSpan( LexerRef lexer );
+size_t       Lexer_GetLine( LexerRef lexer );
+Token        Lexer_GetCurrent( LexerRef lexer );
+
+Token Lexer_Next( LexerRef lexer );
+void  Lexer_Advance( LexerRef lexer );
+void  Lexer_Discard( LexerRef lexer );
+bool  Lexer_Match( LexerRef lexer, Token token );
+bool  Lexer_Compare( LexerRef lexer, const char * value );
+bool  Lexer_LegalLookahead( LexerRef lexer, bool * error, Token first, ... );
+bool  Lexer_HasNext( LexerRef lexer, Token token );
 
 #endif /* LEXER_H */
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+/*!
+ * @file        Number.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Number.h"
+#include "CharClass.h"
+#include <string.h>
+
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define NUMBER_SWAR
+#endif
+
+#ifdef NUMBER_SWAR
+
+/*
+ * Tells whether all 8 bytes are ASCII digits: their high nibble must be 3,
+ * and adding 6 to their low nibble must not carry into it.
+ */
+static inline bool Number_IsEightDigits( uint64_t x )
+{
+    return ( ( x & 0xF0F0F0F0F0F0F0F0 ) | ( ( ( x + 0x0606060606060606 ) & 0xF0F0F0F0F0F0F0F0 ) >> 4 ) ) == 0x3333333333333333;
+}
+
+/*
+ * Converts 8 digits at once, the first one being in the lowest byte.
+ * Pairs of digits are combined, then pairs of pairs, then the two halves,
+ * with one multiplication each.
+ */
+static inline uint64_t Number_DecodeEightDigits( uint64_t x )
+{
+    x -= 0x3030303030303030;
+    x  = ( ( x * 10 ) + ( x >> 8 ) ) & 0x00FF00FF00FF00FF;
+    x  = ( ( x * 100 ) + ( x >> 16 ) ) & 0x0000FFFF0000FFFF;
+    x  = ( ( x * 10000 ) + ( x >> 32 ) ) & 0x00000000FFFFFFFF;
+
+    return x;
+}
+
+#endif /* NUMBER_SWAR */
+
+/*
+ * Decodes a decimal number, 8 digits at a time where possible.
+ * On overflow, the value saturates at UINT64_MAX. Text that isn't all
+ * digits is reported as invalid, even if it is long enough to overflow,
+ * and leaves the value untouched.
+ */
+NumberStatus Number_Decode( const char * text, size_t length, uint64_t * value )
+{
+    uint64_t n;
+    size_t   i;
+    bool     overflow;
+
+    n        = 0;
+    i        = 0;
+    overflow = false;
+
+    if( length == 0 )
+    {
+        return NumberInvalid;
+    }
+
+#ifdef NUMBER_SWAR
+
+    for( ; i + 8 <= length; i += 8 )
+    {
+        uint64_t x;
+        uint64_t digits;
+
+        memcpy( &x, text + i, sizeof( x ) );
+
+        if( Number_IsEightDigits( x ) == false )
+        {
+            return NumberInvalid;
+        }
+
+        digits = Number_DecodeEightDigits( x );
+
+        if( n > ( UINT64_MAX - digits ) / 100000000 )
+        {
+            overflow = true;
+        }
+
+        n = n * 100000000 + digits;
+    }
+
+#endif
+
+    for( ; i < length; i++ )
+    {
+        uint64_t digit;
+
+        if( CharClass_Is( text[ i ], CharClassDigit ) == false )
+        {
+            return NumberInvalid;
+        }
+
+        digit = ( uint64_t )( text[ i ] - '0' );
+
+        if( n > ( UINT64_MAX - digit ) / 10 )
+        {
+            overflow = true;
+        }
+
+        n = n * 10 + digit;
+    }
+
+    *( value ) = ( overflow ) ? UINT64_MAX : n;
+
+    return ( overflow ) ? NumberOverflow : NumberOK;
+}
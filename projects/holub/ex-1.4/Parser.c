@@ -39,27 +39,27 @@
 /*
  * statements -> declaration SEMICOLON | declaration SEMI statements
  */
-void Parser_Statements( void )
+void Parser_Statements( LexerRef lexer )
 {
-    while( Lexer_Match( TokenEnd ) == false )
+    while( Lexer_Match( lexer, TokenEnd ) == false )
     {
-        if( Parser_Declaration() == false )
+        if( Parser_Declaration( lexer ) == false )
         {
-            Debug( "Invalid Syntax" );
-            Lexer_Discard();
-            Lexer_Advance();
+            Debug( lexer, "Invalid Syntax" );
+            Lexer_Discard( lexer );
+            Lexer_Advance( lexer );
         }
         else
         {
-            if( Lexer_Match( TokenPeriod ) )
+            if( Lexer_Match( lexer, TokenPeriod ) )
             {
-                Debug( "Syntax OK" );
-                Lexer_Advance();
+                Debug( lexer, "Syntax OK" );
+                Lexer_Advance( lexer );
             }
             else
             {
-                Warning( "Inserting missing period" );
-                Debug( "Syntax OK" );
+                Warning( lexer, "Inserting missing period" );
+                Debug( lexer, "Syntax OK" );
             }
         }
     }
@@ -68,24 +68,24 @@ void Parser_Statements( void )
 /*
  * declaration -> name ...
  */
-bool Parser_Declaration( void )
+bool Parser_Declaration( LexerRef lexer )
 {
-    return Parser_Name();
+    return Parser_Name( lexer );
 }
 
 /*
  * name -> WORD
  */
-bool Parser_Name( void )
+bool Parser_Name( LexerRef lexer )
 {
-    if( Lexer_Match( TokenWord ) == false )
+    if( Lexer_Match( lexer, TokenWord ) == false )
     {
-        Error( "Expected a word" );
+        Error( lexer, "Expected a word" );
 
         return false;
     }
 
-    Lexer_Advance();
+    Lexer_Advance( lexer );
 
     return true;
 }
@@ -37,8 +37,8 @@
 #include <stdint.h>
 #include "Lexer.h"
 
-void Parser_Statements( void );
-bool Parser_Declaration( void );
-bool Parser_Name( void );
+void Parser_Statements( LexerRef lexer );
+bool Parser_Declaration( LexerRef lexer );
+bool Parser_Name( LexerRef lexer );
 
 #endif /* PARSER_H */
@@ -39,41 +39,57 @@
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
 #endif
 
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap );
-void Print( FILE * fh, const char * level, const char * fmt, va_list ap )
+/*
+ * The stream is locked for the whole message, so messages from lexers
+ * running on different threads are never interleaved.
+ * Messages not tied to a lexer, like I/O errors, have no line number.
+ */
+void Print( FILE * fh, LexerRef lexer, const char * level, const char * fmt, va_list ap );
+void Print( FILE * fh, LexerRef lexer, const char * level, const char * fmt, va_list ap )
 {
-    fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, Lexer_GetLine() );
+    flockfile( fh );
+
+    if( lexer == NULL )
+    {
+        fprintf( fh, "*** [ %s ]> ", level );
+    }
+    else
+    {
+        fprintf( fh, "*** [ %s ]> [ #%zu ]> ", level, Lexer_GetLine( lexer ) );
+    }
+
     vfprintf( fh, fmt, ap );
     fprintf( fh, "\n" );
+    funlockfile( fh );
 }
 
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
 
-void Error( const char * fmt, ... )
+void Error( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "ERROR", fmt, ap );
+    Print( stderr, lexer, "ERROR", fmt, ap );
     va_end( ap );
 }
 
-void Warning( const char * fmt, ... )
+void Warning( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stderr, "WARNING", fmt, ap );
+    Print( stderr, lexer, "WARNING", fmt, ap );
     va_end( ap );
 }
 
-void Debug( const char * fmt, ... )
+void Debug( LexerRef lexer, const char * fmt, ... )
 {
     va_list ap;
 
     va_start( ap, fmt );
-    Print( stdout, "DEBUG", fmt, ap );
+    Print( stdout, lexer, "DEBUG", fmt, ap );
     va_end( ap );
 }
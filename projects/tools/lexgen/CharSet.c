@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        CharSet.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "CharSet.h"
+#include <string.h>
+
+void CharSet_Clear( CharSet * set )
+{
+    memset( set, 0, sizeof( CharSet ) );
+}
+
+void CharSet_Add( CharSet * set, unsigned char c )
+{
+    set->bits[ c >> 5 ] |= 1U << ( c & 31 );
+}
+
+void CharSet_AddRange( CharSet * set, unsigned char first, unsigned char last )
+{
+    for( unsigned int c = first; c <= last; c++ )
+    {
+        CharSet_Add( set, ( unsigned char )c );
+    }
+}
+
+/*
+ * Inverts the set, except for NUL, which is never part of a set: it is the
+ * sentinel that stops the scanner at the end of its input.
+ */
+void CharSet_Invert( CharSet * set )
+{
+    for( size_t i = 0; i < sizeof( set->bits ) / sizeof( *( set->bits ) ); i++ )
+    {
+        set->bits[ i ] = ~( set->bits[ i ] );
+    }
+
+    set->bits[ 0 ] &= ~1U;
+}
+
+bool CharSet_Has( const CharSet * set, unsigned char c )
+{
+    return ( set->bits[ c >> 5 ] & ( 1U << ( c & 31 ) ) ) != 0;
+}
+
+bool CharSet_IsEmpty( const CharSet * set )
+{
+    for( size_t i = 0; i < sizeof( set->bits ) / sizeof( *( set->bits ) ); i++ )
+    {
+        if( set->bits[ i ] != 0 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
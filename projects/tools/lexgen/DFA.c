@@ -0,0 +1,530 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        DFA.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "DFA.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Input bytes are grouped into classes of bytes that no NFA edge tells
+ * apart, so the transition table has one column per class rather than
+ * one per byte. NUL is never matched, and always lands in class 0, along
+ * with every other byte no rule uses.
+ *
+ * State 0 is the dead state, and state 1 the start state.
+ */
+struct DFA
+{
+    uint64_t   rc;
+    uint8_t    classes[ 256 ];
+    size_t     classCount;
+    size_t *   transitions;
+    size_t *   accept;
+    size_t     count;
+    size_t     capacity;
+    uint64_t * sets;
+    size_t     words;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static void   DFA_Partition( DFARef dfa, NFARef nfa );
+static void   DFA_Closure( NFARef nfa, uint64_t * set, size_t * stack );
+static size_t DFA_AddState( DFARef dfa, NFARef nfa, const uint64_t * set );
+
+/*
+ * Subset construction.
+ */
+DFARef DFA_Create( NFARef nfa )
+{
+    DFARef     dfa;
+    uint64_t *    set;
+    size_t *      stack;
+    unsigned char chars[ 256 ];
+    bool          ok;
+
+    if( ( dfa = calloc( 1, sizeof( struct DFA ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    dfa->rc    = 1;
+    dfa->words = ( NFA_GetCount( nfa ) + 63 ) / 64;
+
+    DFA_Partition( dfa, nfa );
+
+    for( unsigned int c = 256; c-- > 0; )
+    {
+        chars[ dfa->classes[ c ] ] = ( unsigned char )c;
+    }
+
+    set   = calloc( dfa->words, sizeof( uint64_t ) );
+    stack = malloc( ( NFA_GetCount( nfa ) + 1 ) * sizeof( size_t ) );
+    ok    = set != NULL && stack != NULL;
+
+    if( ok )
+    {
+        ok = DFA_AddState( dfa, nfa, set ) == DFA_DEAD;
+    }
+
+    if( ok )
+    {
+        for( size_t i = 0; i < NFA_GetStartCount( nfa ); i++ )
+        {
+            size_t start;
+
+            start              = NFA_GetStart( nfa, i );
+            set[ start / 64 ] |= ( uint64_t )1 << ( start % 64 );
+        }
+
+        DFA_Closure( nfa, set, stack );
+
+        ok = DFA_AddState( dfa, nfa, set ) == DFA_START;
+    }
+
+    for( size_t i = 0; ok && i < dfa->count; i++ )
+    {
+        for( size_t cls = 0; ok && cls < dfa->classCount; cls++ )
+        {
+            size_t next;
+
+            memset( set, 0, dfa->words * sizeof( uint64_t ) );
+
+            for( size_t s = 0; s < NFA_GetCount( nfa ); s++ )
+            {
+                const NFAState * state;
+
+                if( ( dfa->sets[ i * dfa->words + s / 64 ] & ( ( uint64_t )1 << ( s % 64 ) ) ) == 0 )
+                {
+                    continue;
+                }
+
+                state = NFA_GetState( nfa, s );
+
+                if( state->epsilon == false && CharSet_Has( &( state->set ), chars[ cls ] ) )
+                {
+                    set[ state->next[ 0 ] / 64 ] |= ( uint64_t )1 << ( state->next[ 0 ] % 64 );
+                }
+            }
+
+            DFA_Closure( nfa, set, stack );
+
+            if( ( next = DFA_AddState( dfa, nfa, set ) ) == DFA_NONE )
+            {
+                ok = false;
+            }
+            else
+            {
+                dfa->transitions[ i * dfa->classCount + cls ] = next;
+            }
+        }
+    }
+
+    free( set );
+    free( stack );
+    free( dfa->sets );
+
+    dfa->sets = NULL;
+
+    if( ok == false )
+    {
+        DFA_Release( dfa );
+
+        return NULL;
+    }
+
+    return dfa;
+}
+
+DFARef DFA_Retain( DFARef dfa )
+{
+    if( dfa == NULL )
+    {
+        return NULL;
+    }
+
+    dfa->rc++;
+
+    return dfa;
+}
+
+void DFA_Release( DFARef dfa )
+{
+    if( dfa == NULL )
+    {
+        return;
+    }
+
+    if( --( dfa->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( dfa->transitions );
+    free( dfa->accept );
+    free( dfa->sets );
+    free( dfa );
+}
+
+/*
+ * Splits the byte classes with the set of each NFA edge in turn: two
+ * bytes stay in the same class only if every edge accepts both or
+ * neither.
+ */
+static void DFA_Partition( DFARef dfa, NFARef nfa )
+{
+    memset( dfa->classes, 0, sizeof( dfa->classes ) );
+
+    dfa->classCount = 1;
+
+    for( size_t s = 0; s < NFA_GetCount( nfa ); s++ )
+    {
+        const NFAState * state;
+        size_t           remap[ 512 ];
+        size_t           count;
+
+        state = NFA_GetState( nfa, s );
+
+        if( state->epsilon )
+        {
+            continue;
+        }
+
+        memset( remap, 0xFF, sizeof( remap ) );
+
+        count = 0;
+
+        for( unsigned int c = 0; c < 256; c++ )
+        {
+            size_t key;
+
+            key = dfa->classes[ c ] * 2U + ( CharSet_Has( &( state->set ), ( unsigned char )c ) ? 1 : 0 );
+
+            if( remap[ key ] == DFA_NONE )
+            {
+                remap[ key ] = count++;
+            }
+
+            dfa->classes[ c ] = ( uint8_t )remap[ key ];
+        }
+
+        dfa->classCount = count;
+    }
+}
+
+/*
+ * Adds every state reachable through epsilon edges to the set.
+ */
+static void DFA_Closure( NFARef nfa, uint64_t * set, size_t * stack )
+{
+    size_t top;
+
+    top = 0;
+
+    for( size_t s = 0; s < NFA_GetCount( nfa ); s++ )
+    {
+        if( set[ s / 64 ] & ( ( uint64_t )1 << ( s % 64 ) ) )
+        {
+            stack[ top++ ] = s;
+        }
+    }
+
+    while( top > 0 )
+    {
+        const NFAState * state;
+
+        state = NFA_GetState( nfa, stack[ --top ] );
+
+        if( state->epsilon == false )
+        {
+            continue;
+        }
+
+        for( size_t i = 0; i < 2; i++ )
+        {
+            size_t next;
+
+            next = state->next[ i ];
+
+            if( next == NFA_NONE || ( set[ next / 64 ] & ( ( uint64_t )1 << ( next % 64 ) ) ) )
+            {
+                continue;
+            }
+
+            set[ next / 64 ] |= ( uint64_t )1 << ( next % 64 );
+            stack[ top++ ]    = next;
+        }
+    }
+}
+
+/*
+ * Returns the state for the given set of NFA states, adding it if it is
+ * new. A state accepts the earliest rule any of its NFA states accepts.
+ */
+static size_t DFA_AddState( DFARef dfa, NFARef nfa, const uint64_t * set )
+{
+    size_t accept;
+
+    for( size_t i = 0; i < dfa->count; i++ )
+    {
+        if( memcmp( dfa->sets + i * dfa->words, set, dfa->words * sizeof( uint64_t ) ) == 0 )
+        {
+            return i;
+        }
+    }
+
+    if( dfa->count == dfa->capacity )
+    {
+        size_t     capacity;
+        size_t *   transitions;
+        size_t *   acceptStates;
+        uint64_t * sets;
+
+        capacity = ( dfa->capacity == 0 ) ? 64 : dfa->capacity * 2;
+
+        if( ( transitions = realloc( dfa->transitions, capacity * dfa->classCount * sizeof( size_t ) ) ) == NULL )
+        {
+            return DFA_NONE;
+        }
+
+        dfa->transitions = transitions;
+
+        if( ( acceptStates = realloc( dfa->accept, capacity * sizeof( size_t ) ) ) == NULL )
+        {
+            return DFA_NONE;
+        }
+
+        dfa->accept = acceptStates;
+
+        if( ( sets = realloc( dfa->sets, capacity * dfa->words * sizeof( uint64_t ) ) ) == NULL )
+        {
+            return DFA_NONE;
+        }
+
+        dfa->sets     = sets;
+        dfa->capacity = capacity;
+    }
+
+    accept = DFA_NONE;
+
+    for( size_t s = 0; s < NFA_GetCount( nfa ); s++ )
+    {
+        if( ( set[ s / 64 ] & ( ( uint64_t )1 << ( s % 64 ) ) ) && NFA_GetState( nfa, s )->accept < accept )
+        {
+            accept = NFA_GetState( nfa, s )->accept;
+        }
+    }
+
+    memcpy( dfa->sets + dfa->count * dfa->words, set, dfa->words * sizeof( uint64_t ) );
+
+    for( size_t cls = 0; cls < dfa->classCount; cls++ )
+    {
+        dfa->transitions[ dfa->count * dfa->classCount + cls ] = DFA_DEAD;
+    }
+
+    dfa->accept[ dfa->count ] = accept;
+
+    return dfa->count++;
+}
+
+/*
+ * Moore's algorithm: states start grouped by the rule they accept, and
+ * groups are split until every state of a group goes to the same groups.
+ * Groups are numbered in the order of their first state, so the dead and
+ * start states keep their numbers, unless the start state is dead.
+ */
+bool DFA_Minimize( DFARef dfa )
+{
+    size_t * group;
+    size_t * next;
+    size_t * first;
+    size_t   count;
+    size_t * transitions;
+    size_t * accept;
+
+    group = calloc( dfa->count, sizeof( size_t ) );
+    next  = calloc( dfa->count, sizeof( size_t ) );
+    first = calloc( dfa->count, sizeof( size_t ) );
+
+    if( group == NULL || next == NULL || first == NULL )
+    {
+        free( group );
+        free( next );
+        free( first );
+
+        return false;
+    }
+
+    count = 0;
+
+    for( size_t i = 0; i < dfa->count; i++ )
+    {
+        size_t g;
+
+        for( g = 0; g < count; g++ )
+        {
+            if( dfa->accept[ first[ g ] ] == dfa->accept[ i ] )
+            {
+                break;
+            }
+        }
+
+        if( g == count )
+        {
+            first[ count++ ] = i;
+        }
+
+        group[ i ] = g;
+    }
+
+    while( true )
+    {
+        size_t split;
+
+        split = 0;
+
+        for( size_t i = 0; i < dfa->count; i++ )
+        {
+            size_t g;
+
+            for( g = 0; g < split; g++ )
+            {
+                size_t j;
+                size_t cls;
+
+                j = first[ g ];
+
+                if( group[ j ] != group[ i ] )
+                {
+                    continue;
+                }
+
+                for( cls = 0; cls < dfa->classCount; cls++ )
+                {
+                    if( group[ dfa->transitions[ i * dfa->classCount + cls ] ] != group[ dfa->transitions[ j * dfa->classCount + cls ] ] )
+                    {
+                        break;
+                    }
+                }
+
+                if( cls == dfa->classCount )
+                {
+                    break;
+                }
+            }
+
+            if( g == split )
+            {
+                first[ split++ ] = i;
+            }
+
+            next[ i ] = g;
+        }
+
+        memcpy( group, next, dfa->count * sizeof( size_t ) );
+
+        if( split == count )
+        {
+            break;
+        }
+
+        count = split;
+    }
+
+    transitions = malloc( count * dfa->classCount * sizeof( size_t ) );
+    accept      = malloc( count * sizeof( size_t ) );
+
+    if( transitions == NULL || accept == NULL )
+    {
+        free( transitions );
+        free( accept );
+        free( group );
+        free( next );
+        free( first );
+
+        return false;
+    }
+
+    for( size_t g = 0; g < count; g++ )
+    {
+        for( size_t cls = 0; cls < dfa->classCount; cls++ )
+        {
+            transitions[ g * dfa->classCount + cls ] = group[ dfa->transitions[ first[ g ] * dfa->classCount + cls ] ];
+        }
+
+        accept[ g ] = dfa->accept[ first[ g ] ];
+    }
+
+    free( dfa->transitions );
+    free( dfa->accept );
+    free( group );
+    free( next );
+    free( first );
+
+    dfa->transitions = transitions;
+    dfa->accept      = accept;
+    dfa->count       = count;
+    dfa->capacity    = count;
+
+    return true;
+}
+
+size_t DFA_GetStateCount( DFARef dfa )
+{
+    return dfa->count;
+}
+
+size_t DFA_GetClassCount( DFARef dfa )
+{
+    return dfa->classCount;
+}
+
+uint8_t DFA_GetClass( DFARef dfa, unsigned char c )
+{
+    return dfa->classes[ c ];
+}
+
+size_t DFA_GetTransition( DFARef dfa, size_t state, size_t cls )
+{
+    return dfa->transitions[ state * dfa->classCount + cls ];
+}
+
+size_t DFA_GetAccept( DFARef dfa, size_t state )
+{
+    return dfa->accept[ state ];
+}
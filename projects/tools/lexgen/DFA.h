@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      DFA.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef DFA_H
+#define DFA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "NFA.h"
+
+#define DFA_NONE  ( ( size_t )-1 )
+#define DFA_DEAD  0
+#define DFA_START 1
+
+typedef struct DFA * DFARef;
+
+DFARef DFA_Create( NFARef nfa );
+DFARef DFA_Retain( DFARef dfa );
+void   DFA_Release( DFARef dfa );
+
+bool    DFA_Minimize( DFARef dfa );
+size_t  DFA_GetStateCount( DFARef dfa );
+size_t  DFA_GetClassCount( DFARef dfa );
+uint8_t DFA_GetClass( DFARef dfa, unsigned char c );
+size_t  DFA_GetTransition( DFARef dfa, size_t state, size_t cls );
+size_t  DFA_GetAccept( DFARef dfa, size_t state );
+
+#endif /* DFA_H */
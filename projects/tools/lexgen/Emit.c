@@ -0,0 +1,321 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Emit.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Emit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary );
+static void   Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent );
+
+/*
+ * Writes <Name>.h and <Name>.c next to <Name>.l, with identifiers
+ * prefixed by <Name>.
+ *
+ * Columns are compressed through the byte classes, and rows by sharing a
+ * single copy of identical rows, which is what most states of a scanner
+ * look like: they all go to the same few states on the same classes.
+ */
+bool Emit_Scanner( SpecRef spec, DFARef dfa )
+{
+    char         base[ 1024 ];
+    char         summary[ 256 ];
+    const char * prefix;
+    size_t       states;
+    size_t       classes;
+    size_t *     rows;
+    size_t *     unique;
+    size_t       rowCount;
+    size_t       values[ 256 ];
+    FILE *       fh;
+
+    if( snprintf( base, sizeof( base ), "%s", Spec_GetPath( spec ) ) >= ( int )sizeof( base ) || strlen( base ) < 3 || strcmp( base + strlen( base ) - 2, ".l" ) != 0 )
+    {
+        fprintf( stderr, "%s: Spec file names must end with .l\n", Spec_GetPath( spec ) );
+
+        return false;
+    }
+
+    base[ strlen( base ) - 2 ] = 0;
+    prefix                     = ( strrchr( base, '/' ) == NULL ) ? base : strrchr( base, '/' ) + 1;
+    states                     = DFA_GetStateCount( dfa );
+    classes                    = DFA_GetClassCount( dfa );
+
+    if( states > 256 )
+    {
+        fprintf( stderr, "%s: Too many states (%zu)\n", Spec_GetPath( spec ), states );
+
+        return false;
+    }
+
+    rows   = calloc( states, sizeof( size_t ) );
+    unique = calloc( states, sizeof( size_t ) );
+
+    if( rows == NULL || unique == NULL )
+    {
+        free( rows );
+        free( unique );
+
+        return false;
+    }
+
+    rowCount = 0;
+
+    for( size_t s = 0; s < states; s++ )
+    {
+        size_t r;
+
+        for( r = 0; r < rowCount; r++ )
+        {
+            size_t cls;
+
+            for( cls = 0; cls < classes; cls++ )
+            {
+                if( DFA_GetTransition( dfa, s, cls ) != DFA_GetTransition( dfa, unique[ r ], cls ) )
+                {
+                    break;
+                }
+            }
+
+            if( cls == classes )
+            {
+                break;
+            }
+        }
+
+        if( r == rowCount )
+        {
+            unique[ rowCount++ ] = s;
+        }
+
+        rows[ s ] = r;
+    }
+
+    snprintf( summary, sizeof( summary ), "%zu states, %zu byte classes, %zu distinct rows.", states, classes, rowCount );
+
+    if( ( fh = Emit_Open( base, "h", prefix, spec, summary ) ) == NULL )
+    {
+        free( rows );
+        free( unique );
+
+        return false;
+    }
+
+    fprintf( fh, "#ifndef %s_H\n", prefix );
+    fprintf( fh, "#define %s_H\n\n", prefix );
+    fprintf( fh, "#include <stddef.h>\n\n" );
+    fprintf( fh, "#define %s_NONE ( -1 )\n", prefix );
+    fprintf( fh, "#define %s_SKIP ( -2 )\n\n", prefix );
+    fprintf( fh, "/*\n" );
+    fprintf( fh, " * Matches the longest token at the start of the text, which must be NUL\n" );
+    fprintf( fh, " * terminated, and returns its rule, or %s_SKIP for input to discard.\n", prefix );
+    fprintf( fh, " * Returns %s_NONE, with a length of 1, if nothing matches.\n", prefix );
+    fprintf( fh, " */\n" );
+    fprintf( fh, "int %s_Match( const char * text, size_t * length );\n\n", prefix );
+    fprintf( fh, "#endif /* %s_H */\n", prefix );
+    fclose( fh );
+
+    if( ( fh = Emit_Open( base, "c", prefix, spec, summary ) ) == NULL )
+    {
+        free( rows );
+        free( unique );
+
+        return false;
+    }
+
+    fprintf( fh, "#include \"%s.h\"\n", prefix );
+
+    for( size_t i = 0; i < Spec_GetIncludeCount( spec ); i++ )
+    {
+        fprintf( fh, "#include \"%s\"\n", Spec_GetInclude( spec, i ) );
+    }
+
+    fprintf( fh, "#include <stdint.h>\n\n" );
+
+    for( size_t c = 0; c < 256; c++ )
+    {
+        values[ c ] = DFA_GetClass( dfa, ( unsigned char )c );
+    }
+
+    fprintf( fh, "/*\n * Class of each input byte.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Classes[ 256 ] =\n{\n", prefix );
+    Emit_Table( fh, values, 256, "    " );
+    fprintf( fh, "};\n\n" );
+
+    fprintf( fh, "/*\n * Row of the transition table of each state. State 0 is the dead state,\n * and state 1 the start state.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Rows[ %zu ] =\n{\n", prefix, states );
+    Emit_Table( fh, rows, states, "    " );
+    fprintf( fh, "};\n\n" );
+
+    fprintf( fh, "static const uint8_t %s_Transitions[ %zu ][ %zu ] =\n{\n", prefix, rowCount, classes );
+
+    for( size_t r = 0; r < rowCount; r++ )
+    {
+        for( size_t cls = 0; cls < classes; cls++ )
+        {
+            values[ cls ] = DFA_GetTransition( dfa, unique[ r ], cls );
+        }
+
+        fprintf( fh, "    {\n" );
+        Emit_Table( fh, values, classes, "        " );
+        fprintf( fh, "    },\n" );
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "/*\n * Rule accepted by each state.\n */\n" );
+    fprintf( fh, "static const int %s_Accept[ %zu ] =\n{\n", prefix, states );
+
+    for( size_t s = 0; s < states; s++ )
+    {
+        size_t rule;
+
+        rule = DFA_GetAccept( dfa, s );
+
+        if( rule == DFA_NONE )
+        {
+            fprintf( fh, "    %s_NONE,\n", prefix );
+        }
+        else if( Spec_GetRuleName( spec, rule ) == NULL )
+        {
+            fprintf( fh, "    %s_SKIP,\n", prefix );
+        }
+        else
+        {
+            fprintf( fh, "    %s,\n", Spec_GetRuleName( spec, rule ) );
+        }
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "int %s_Match( const char * text, size_t * length )\n", prefix );
+    fprintf( fh, "{\n" );
+    fprintf( fh, "    const unsigned char * p;\n" );
+    fprintf( fh, "    unsigned int          state;\n" );
+    fprintf( fh, "    int                   accept;\n" );
+    fprintf( fh, "    size_t                i;\n\n" );
+    fprintf( fh, "    p           = ( const unsigned char * )text;\n" );
+    fprintf( fh, "    state       = 1;\n" );
+    fprintf( fh, "    accept      = %s_NONE;\n", prefix );
+    fprintf( fh, "    i           = 0;\n" );
+    fprintf( fh, "    *( length ) = 1;\n\n" );
+    fprintf( fh, "    while( ( state = %s_Transitions[ %s_Rows[ state ] ][ %s_Classes[ p[ i ] ] ] ) != 0 )\n", prefix, prefix, prefix );
+    fprintf( fh, "    {\n" );
+    fprintf( fh, "        i++;\n\n" );
+    fprintf( fh, "        if( %s_Accept[ state ] != %s_NONE )\n", prefix, prefix );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            accept      = %s_Accept[ state ];\n", prefix );
+    fprintf( fh, "            *( length ) = i;\n" );
+    fprintf( fh, "        }\n" );
+    fprintf( fh, "    }\n\n" );
+    fprintf( fh, "    return accept;\n" );
+    fprintf( fh, "}\n" );
+    fclose( fh );
+
+    free( rows );
+    free( unique );
+
+    return true;
+}
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary )
+{
+    static const char * license[] =
+    {
+        "The MIT License (MIT)",
+        "",
+        "Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com",
+        "",
+        "Permission is hereby granted, free of charge, to any person obtaining a copy",
+        "of this software and associated documentation files (the \"Software\"), to deal",
+        "in the Software without restriction, including without limitation the rights",
+        "to use, copy, modify, merge, publish, distribute, sublicense, and/or sell",
+        "copies of the Software, and to permit persons to whom the Software is",
+        "furnished to do so, subject to the following conditions:",
+        "",
+        "The above copyright notice and this permission notice shall be included in",
+        "all copies or substantial portions of the Software.",
+        "",
+        "THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR",
+        "IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,",
+        "FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE",
+        "AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER",
+        "LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,",
+        "OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN",
+        "THE SOFTWARE."
+    };
+
+    char         path[ 1100 ];
+    const char * name;
+    FILE *       fh;
+
+    snprintf( path, sizeof( path ), "%s.%s", base, extension );
+
+    if( ( fh = fopen( path, "w" ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot write %s: %s\n", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    name = ( strrchr( Spec_GetPath( spec ), '/' ) == NULL ) ? Spec_GetPath( spec ) : strrchr( Spec_GetPath( spec ), '/' ) + 1;
+
+    fprintf( fh, "/*******************************************************************************\n" );
+
+    for( size_t i = 0; i < sizeof( license ) / sizeof( *( license ) ); i++ )
+    {
+        fprintf( fh, " * %s\n", license[ i ] );
+    }
+
+    fprintf( fh, " ******************************************************************************/\n\n" );
+    fprintf( fh, "/*!\n" );
+    fprintf( fh, " * @%-11s %s.%s\n", ( extension[ 0 ] == 'h' ) ? "header" : "file", prefix, extension );
+    fprintf( fh, " * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com\n" );
+    fprintf( fh, " * @dicussion   Generated by tools-lexgen from %s, do not edit.\n", name );
+    fprintf( fh, " *              %s\n", summary );
+    fprintf( fh, " */\n\n" );
+
+    return fh;
+}
+
+static void Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        fprintf( fh, "%s%3zu%s", ( i % 16 == 0 ) ? indent : " ", values[ i ], ( i + 1 < count ) ? "," : "" );
+
+        if( i % 16 == 15 || i + 1 == count )
+        {
+            fprintf( fh, "\n" );
+        }
+    }
+}
@@ -0,0 +1,565 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        NFA.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "NFA.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Every rule is a separate fragment, whose start state is kept in a list
+ * rather than chained through epsilon edges from a single start state.
+ */
+struct NFA
+{
+    uint64_t   rc;
+    NFAState * states;
+    size_t     count;
+    size_t     capacity;
+    size_t *   starts;
+    size_t     startCount;
+    size_t     startCapacity;
+};
+
+/*
+ * A fragment under construction: its final state has no edge yet.
+ */
+typedef struct
+{
+    size_t start;
+    size_t end;
+} NFAFragment;
+
+typedef struct
+{
+    NFARef       nfa;
+    const char * p;
+    const char * error;
+} NFAParser;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static size_t NFA_AddState( NFAParser * parser, bool epsilon );
+static void   NFA_Link( NFARef nfa, size_t from, size_t to );
+static bool   NFA_ParseAlternation( NFAParser * parser, NFAFragment * fragment );
+static bool   NFA_ParseConcatenation( NFAParser * parser, NFAFragment * fragment );
+static bool   NFA_ParseRepetition( NFAParser * parser, NFAFragment * fragment );
+static bool   NFA_ParseAtom( NFAParser * parser, NFAFragment * fragment );
+static bool   NFA_ParseClass( NFAParser * parser, CharSet * set );
+static bool   NFA_ParseChar( NFAParser * parser, unsigned char * c );
+
+NFARef NFA_Create( void )
+{
+    NFARef nfa;
+
+    if( ( nfa = calloc( 1, sizeof( struct NFA ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    nfa->rc = 1;
+
+    return nfa;
+}
+
+NFARef NFA_Retain( NFARef nfa )
+{
+    if( nfa == NULL )
+    {
+        return NULL;
+    }
+
+    nfa->rc++;
+
+    return nfa;
+}
+
+void NFA_Release( NFARef nfa )
+{
+    if( nfa == NULL )
+    {
+        return;
+    }
+
+    if( --( nfa->rc ) > 0 )
+    {
+        return;
+    }
+
+    free( nfa->states );
+    free( nfa->starts );
+    free( nfa );
+}
+
+/*
+ * Compiles the regular expression into a new fragment, whose final state
+ * accepts the given rule.
+ */
+bool NFA_AddRule( NFARef nfa, const char * regex, size_t rule, const char ** error )
+{
+    NFAParser   parser;
+    NFAFragment fragment;
+
+    parser.nfa   = nfa;
+    parser.p     = regex;
+    parser.error = NULL;
+
+    if( NFA_ParseAlternation( &parser, &fragment ) == false )
+    {
+        *( error ) = parser.error;
+
+        return false;
+    }
+
+    if( *( parser.p ) != 0 )
+    {
+        *( error ) = "Unbalanced parenthesis";
+
+        return false;
+    }
+
+    if( nfa->startCount == nfa->startCapacity )
+    {
+        size_t   capacity;
+        size_t * starts;
+
+        capacity = ( nfa->startCapacity == 0 ) ? 16 : nfa->startCapacity * 2;
+
+        if( ( starts = realloc( nfa->starts, capacity * sizeof( size_t ) ) ) == NULL )
+        {
+            *( error ) = "Out of memory";
+
+            return false;
+        }
+
+        nfa->starts        = starts;
+        nfa->startCapacity = capacity;
+    }
+
+    nfa->states[ fragment.end ].accept = rule;
+    nfa->starts[ nfa->startCount++ ]   = fragment.start;
+
+    return true;
+}
+
+size_t NFA_GetCount( NFARef nfa )
+{
+    return nfa->count;
+}
+
+const NFAState * NFA_GetState( NFARef nfa, size_t index )
+{
+    return &( nfa->states[ index ] );
+}
+
+size_t NFA_GetStartCount( NFARef nfa )
+{
+    return nfa->startCount;
+}
+
+size_t NFA_GetStart( NFARef nfa, size_t index )
+{
+    return nfa->starts[ index ];
+}
+
+static size_t NFA_AddState( NFAParser * parser, bool epsilon )
+{
+    NFARef     nfa;
+    NFAState * state;
+
+    nfa = parser->nfa;
+
+    if( nfa->count == nfa->capacity )
+    {
+        size_t     capacity;
+        NFAState * states;
+
+        capacity = ( nfa->capacity == 0 ) ? 256 : nfa->capacity * 2;
+
+        if( ( states = realloc( nfa->states, capacity * sizeof( NFAState ) ) ) == NULL )
+        {
+            parser->error = "Out of memory";
+
+            return NFA_NONE;
+        }
+
+        nfa->states   = states;
+        nfa->capacity = capacity;
+    }
+
+    state = &( nfa->states[ nfa->count ] );
+
+    CharSet_Clear( &( state->set ) );
+
+    state->epsilon   = epsilon;
+    state->next[ 0 ] = NFA_NONE;
+    state->next[ 1 ] = NFA_NONE;
+    state->accept    = NFA_NONE;
+
+    return nfa->count++;
+}
+
+/*
+ * Adds an epsilon edge. Final states are created as epsilon states, so
+ * they always have room for both edges a repetition needs.
+ */
+static void NFA_Link( NFARef nfa, size_t from, size_t to )
+{
+    NFAState * state;
+
+    state = &( nfa->states[ from ] );
+
+    if( state->next[ 0 ] == NFA_NONE )
+    {
+        state->next[ 0 ] = to;
+    }
+    else
+    {
+        state->next[ 1 ] = to;
+    }
+}
+
+/*
+ * alternation := concatenation ( '|' concatenation )*
+ */
+static bool NFA_ParseAlternation( NFAParser * parser, NFAFragment * fragment )
+{
+    if( NFA_ParseConcatenation( parser, fragment ) == false )
+    {
+        return false;
+    }
+
+    while( *( parser->p ) == '|' )
+    {
+        NFAFragment right;
+        size_t      start;
+        size_t      end;
+
+        parser->p++;
+
+        if( NFA_ParseConcatenation( parser, &right ) == false )
+        {
+            return false;
+        }
+
+        if( ( start = NFA_AddState( parser, true ) ) == NFA_NONE || ( end = NFA_AddState( parser, true ) ) == NFA_NONE )
+        {
+            return false;
+        }
+
+        NFA_Link( parser->nfa, start, fragment->start );
+        NFA_Link( parser->nfa, start, right.start );
+        NFA_Link( parser->nfa, fragment->end, end );
+        NFA_Link( parser->nfa, right.end, end );
+
+        fragment->start = start;
+        fragment->end   = end;
+    }
+
+    return true;
+}
+
+/*
+ * concatenation := repetition*
+ */
+static bool NFA_ParseConcatenation( NFAParser * parser, NFAFragment * fragment )
+{
+    size_t state;
+
+    if( ( state = NFA_AddState( parser, true ) ) == NFA_NONE )
+    {
+        return false;
+    }
+
+    fragment->start = state;
+    fragment->end   = state;
+
+    while( *( parser->p ) != 0 && *( parser->p ) != '|' && *( parser->p ) != ')' )
+    {
+        NFAFragment next;
+
+        if( NFA_ParseRepetition( parser, &next ) == false )
+        {
+            return false;
+        }
+
+        NFA_Link( parser->nfa, fragment->end, next.start );
+
+        fragment->end = next.end;
+    }
+
+    return true;
+}
+
+/*
+ * repetition := atom ( '*' | '+' | '?' )*
+ */
+static bool NFA_ParseRepetition( NFAParser * parser, NFAFragment * fragment )
+{
+    if( NFA_ParseAtom( parser, fragment ) == false )
+    {
+        return false;
+    }
+
+    while( *( parser->p ) == '*' || *( parser->p ) == '+' || *( parser->p ) == '?' )
+    {
+        size_t start;
+        size_t end;
+        char   op;
+
+        op = *( parser->p++ );
+
+        if( ( start = NFA_AddState( parser, true ) ) == NFA_NONE || ( end = NFA_AddState( parser, true ) ) == NFA_NONE )
+        {
+            return false;
+        }
+
+        NFA_Link( parser->nfa, start, fragment->start );
+        NFA_Link( parser->nfa, fragment->end, end );
+
+        if( op != '+' )
+        {
+            NFA_Link( parser->nfa, start, end );
+        }
+
+        if( op != '?' )
+        {
+            NFA_Link( parser->nfa, fragment->end, fragment->start );
+        }
+
+        fragment->start = start;
+        fragment->end   = end;
+    }
+
+    return true;
+}
+
+/*
+ * atom := '(' alternation ')' | '[' class ']' | '.' | char
+ */
+static bool NFA_ParseAtom( NFAParser * parser, NFAFragment * fragment )
+{
+    CharSet       set;
+    unsigned char c;
+    size_t        start;
+    size_t        end;
+
+    CharSet_Clear( &set );
+
+    switch( *( parser->p ) )
+    {
+        case '(':
+
+            parser->p++;
+
+            if( NFA_ParseAlternation( parser, fragment ) == false )
+            {
+                return false;
+            }
+
+            if( *( parser->p ) != ')' )
+            {
+                parser->error = "Unbalanced parenthesis";
+
+                return false;
+            }
+
+            parser->p++;
+
+            return true;
+
+        case '*':
+        case '+':
+        case '?':
+
+            parser->error = "Repetition without an operand";
+
+            return false;
+
+        case '[':
+
+            parser->p++;
+
+            if( NFA_ParseClass( parser, &set ) == false )
+            {
+                return false;
+            }
+
+            break;
+
+        case '.':
+
+            parser->p++;
+
+            CharSet_Add( &set, '\n' );
+            CharSet_Invert( &set );
+
+            break;
+
+        default:
+
+            if( NFA_ParseChar( parser, &c ) == false )
+            {
+                return false;
+            }
+
+            CharSet_Add( &set, c );
+
+            break;
+    }
+
+    if( ( start = NFA_AddState( parser, false ) ) == NFA_NONE || ( end = NFA_AddState( parser, true ) ) == NFA_NONE )
+    {
+        return false;
+    }
+
+    parser->nfa->states[ start ].set       = set;
+    parser->nfa->states[ start ].next[ 0 ] = end;
+
+    fragment->start = start;
+    fragment->end   = end;
+
+    return true;
+}
+
+/*
+ * class := '^'? ( char ( '-' char )? )+ ']'
+ */
+static bool NFA_ParseClass( NFAParser * parser, CharSet * set )
+{
+    bool invert;
+
+    invert = *( parser->p ) == '^';
+
+    if( invert )
+    {
+        parser->p++;
+    }
+
+    do
+    {
+        unsigned char first;
+        unsigned char last;
+
+        if( *( parser->p ) == 0 )
+        {
+            parser->error = "Unterminated character class";
+
+            return false;
+        }
+
+        if( NFA_ParseChar( parser, &first ) == false )
+        {
+            return false;
+        }
+
+        last = first;
+
+        if( parser->p[ 0 ] == '-' && parser->p[ 1 ] != ']' && parser->p[ 1 ] != 0 )
+        {
+            parser->p++;
+
+            if( NFA_ParseChar( parser, &last ) == false )
+            {
+                return false;
+            }
+
+            if( last < first )
+            {
+                parser->error = "Invalid range in character class";
+
+                return false;
+            }
+        }
+
+        CharSet_AddRange( set, first, last );
+    }
+    while( *( parser->p ) != ']' );
+
+    parser->p++;
+
+    if( invert )
+    {
+        CharSet_Invert( set );
+    }
+
+    return true;
+}
+
+/*
+ * A literal byte, or an escape sequence. NUL cannot be matched, as it
+ * ends the input.
+ */
+static bool NFA_ParseChar( NFAParser * parser, unsigned char * c )
+{
+    if( *( parser->p ) != '\\' )
+    {
+        *( c ) = ( unsigned char )*( parser->p++ );
+
+        return true;
+    }
+
+    parser->p++;
+
+    switch( *( parser->p ) )
+    {
+        case 'n': *( c ) = '\n'; break;
+        case 't': *( c ) = '\t'; break;
+        case 'r': *( c ) = '\r'; break;
+        case 'f': *( c ) = '\f'; break;
+        case 'v': *( c ) = '\v'; break;
+        case 's': *( c ) = ' ';  break;
+
+        case 0:
+        case '0':
+
+            parser->error = "NUL cannot be matched";
+
+            return false;
+
+        default:
+
+            *( c ) = ( unsigned char )*( parser->p );
+
+            break;
+    }
+
+    parser->p++;
+
+    return true;
+}
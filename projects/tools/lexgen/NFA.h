@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      NFA.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef NFA_H
+#define NFA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "CharSet.h"
+
+#define NFA_NONE ( ( size_t )-1 )
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * A Thompson NFA state: either a single edge on a set of bytes, or up to
+ * two epsilon edges. Only the final state of a rule accepts.
+ */
+typedef struct
+{
+    bool    epsilon;
+    CharSet set;
+    size_t  next[ 2 ];
+    size_t  accept;
+} NFAState;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+typedef struct NFA * NFARef;
+
+NFARef NFA_Create( void );
+NFARef NFA_Retain( NFARef nfa );
+void   NFA_Release( NFARef nfa );
+
+bool             NFA_AddRule( NFARef nfa, const char * regex, size_t rule, const char ** error );
+size_t           NFA_GetCount( NFARef nfa );
+const NFAState * NFA_GetState( NFARef nfa, size_t index );
+size_t           NFA_GetStartCount( NFARef nfa );
+size_t           NFA_GetStart( NFARef nfa, size_t index );
+
+#endif /* NFA_H */
@@ -0,0 +1,353 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Spec.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Spec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Skip rules have no name.
+ */
+typedef struct
+{
+    char * name;
+    char * regex;
+    size_t line;
+} SpecRule;
+
+struct Spec
+{
+    uint64_t   rc;
+    char *     path;
+    char **    includes;
+    size_t     includeCount;
+    SpecRule * rules;
+    size_t     ruleCount;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static bool   Spec_ParseLine( SpecRef spec, char * line, size_t number );
+static char * Spec_NextWord( char ** line );
+static void   Spec_Error( SpecRef spec, size_t line, const char * message );
+
+/*
+ * A spec has one definition per line, and # starts a comment line:
+ *
+ *     %include "Header.h"     included by the generated source
+ *     %skip    <regex>        input matched and discarded
+ *     Name     <regex>        input matched as the token Name
+ *
+ * A regular expression runs to the end of its line. When two rules match
+ * the same longest input, the first one wins.
+ */
+SpecRef Spec_CreateWithFile( const char * path )
+{
+    SpecRef spec;
+    FILE *  fh;
+    char    line[ 1024 ];
+    size_t  number;
+    bool    ok;
+
+    if( ( fh = fopen( path, "r" ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot open %s: %s\n", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    if( ( spec = calloc( 1, sizeof( struct Spec ) ) ) == NULL || ( spec->path = strdup( path ) ) == NULL )
+    {
+        free( spec );
+        fclose( fh );
+
+        return NULL;
+    }
+
+    spec->rc = 1;
+    number   = 0;
+    ok       = true;
+
+    while( ok && fgets( line, sizeof( line ), fh ) != NULL )
+    {
+        number++;
+
+        if( strchr( line, '\n' ) == NULL && feof( fh ) == 0 )
+        {
+            Spec_Error( spec, number, "Line too long" );
+
+            ok = false;
+        }
+        else
+        {
+            ok = Spec_ParseLine( spec, line, number );
+        }
+    }
+
+    fclose( fh );
+
+    if( ok && spec->ruleCount == 0 )
+    {
+        Spec_Error( spec, number, "No rules" );
+
+        ok = false;
+    }
+
+    if( ok == false )
+    {
+        Spec_Release( spec );
+
+        return NULL;
+    }
+
+    return spec;
+}
+
+SpecRef Spec_Retain( SpecRef spec )
+{
+    if( spec == NULL )
+    {
+        return NULL;
+    }
+
+    spec->rc++;
+
+    return spec;
+}
+
+void Spec_Release( SpecRef spec )
+{
+    if( spec == NULL )
+    {
+        return;
+    }
+
+    if( --( spec->rc ) > 0 )
+    {
+        return;
+    }
+
+    for( size_t i = 0; i < spec->includeCount; i++ )
+    {
+        free( spec->includes[ i ] );
+    }
+
+    for( size_t i = 0; i < spec->ruleCount; i++ )
+    {
+        free( spec->rules[ i ].name );
+        free( spec->rules[ i ].regex );
+    }
+
+    free( spec->includes );
+    free( spec->rules );
+    free( spec->path );
+    free( spec );
+}
+
+const char * Spec_GetPath( SpecRef spec )
+{
+    return spec->path;
+}
+
+size_t Spec_GetIncludeCount( SpecRef spec )
+{
+    return spec->includeCount;
+}
+
+const char * Spec_GetInclude( SpecRef spec, size_t index )
+{
+    return spec->includes[ index ];
+}
+
+size_t Spec_GetRuleCount( SpecRef spec )
+{
+    return spec->ruleCount;
+}
+
+const char * Spec_GetRuleName( SpecRef spec, size_t index )
+{
+    return spec->rules[ index ].name;
+}
+
+const char * Spec_GetRuleRegex( SpecRef spec, size_t index )
+{
+    return spec->rules[ index ].regex;
+}
+
+size_t Spec_GetRuleLine( SpecRef spec, size_t index )
+{
+    return spec->rules[ index ].line;
+}
+
+static bool Spec_ParseLine( SpecRef spec, char * line, size_t number )
+{
+    char *     word;
+    size_t     length;
+    SpecRule * rules;
+
+    length = strlen( line );
+
+    while( length > 0 && isspace( ( unsigned char )line[ length - 1 ] ) )
+    {
+        line[ --length ] = 0;
+    }
+
+    if( ( word = Spec_NextWord( &line ) ) == NULL || word[ 0 ] == '#' )
+    {
+        return true;
+    }
+
+    if( strcmp( word, "%include" ) == 0 )
+    {
+        char ** includes;
+
+        length = strlen( line );
+
+        if( length < 2 || line[ 0 ] != '"' || line[ length - 1 ] != '"' )
+        {
+            Spec_Error( spec, number, "Expected a quoted file name" );
+
+            return false;
+        }
+
+        if( ( includes = realloc( spec->includes, ( spec->includeCount + 1 ) * sizeof( char * ) ) ) == NULL )
+        {
+            return false;
+        }
+
+        spec->includes = includes;
+
+        if( ( includes[ spec->includeCount ] = strndup( line + 1, length - 2 ) ) == NULL )
+        {
+            return false;
+        }
+
+        spec->includeCount++;
+
+        return true;
+    }
+
+    if( word[ 0 ] == '%' && strcmp( word, "%skip" ) != 0 )
+    {
+        Spec_Error( spec, number, "Unknown directive" );
+
+        return false;
+    }
+
+    if( word[ 0 ] != '%' && ( isalpha( ( unsigned char )word[ 0 ] ) == 0 && word[ 0 ] != '_' ) )
+    {
+        Spec_Error( spec, number, "Expected a token name" );
+
+        return false;
+    }
+
+    if( *( line ) == 0 )
+    {
+        Spec_Error( spec, number, "Expected a regular expression" );
+
+        return false;
+    }
+
+    if( ( rules = realloc( spec->rules, ( spec->ruleCount + 1 ) * sizeof( SpecRule ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    spec->rules = rules;
+
+    rules[ spec->ruleCount ].name  = ( word[ 0 ] == '%' ) ? NULL : strdup( word );
+    rules[ spec->ruleCount ].regex = strdup( line );
+    rules[ spec->ruleCount ].line  = number;
+
+    spec->ruleCount++;
+
+    return rules[ spec->ruleCount - 1 ].regex != NULL;
+}
+
+/*
+ * Returns the next whitespace-delimited word, NUL terminated in place,
+ * and leaves the line at the start of what follows.
+ */
+static char * Spec_NextWord( char ** line )
+{
+    char * p;
+    char * word;
+
+    p = *( line );
+
+    while( isspace( ( unsigned char )*( p ) ) )
+    {
+        p++;
+    }
+
+    if( *( p ) == 0 )
+    {
+        return NULL;
+    }
+
+    word = p;
+
+    while( *( p ) != 0 && isspace( ( unsigned char )*( p ) ) == 0 )
+    {
+        p++;
+    }
+
+    if( *( p ) != 0 )
+    {
+        *( p++ ) = 0;
+    }
+
+    while( isspace( ( unsigned char )*( p ) ) )
+    {
+        p++;
+    }
+
+    *( line ) = p;
+
+    return word;
+}
+
+static void Spec_Error( SpecRef spec, size_t line, const char * message )
+{
+    fprintf( stderr, "%s:%zu: %s\n", spec->path, line, message );
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Spec.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef SPEC_H
+#define SPEC_H
+
+#include <stddef.h>
+
+typedef struct Spec * SpecRef;
+
+SpecRef Spec_CreateWithFile( const char * path );
+SpecRef Spec_Retain( SpecRef spec );
+void    Spec_Release( SpecRef spec );
+
+const char * Spec_GetPath( SpecRef spec );
+size_t       Spec_GetIncludeCount( SpecRef spec );
+const char * Spec_GetInclude( SpecRef spec, size_t index );
+size_t       Spec_GetRuleCount( SpecRef spec );
+const char * Spec_GetRuleName( SpecRef spec, size_t index );
+const char * Spec_GetRuleRegex( SpecRef spec, size_t index );
+size_t       Spec_GetRuleLine( SpecRef spec, size_t index );
+
+#endif /* SPEC_H */
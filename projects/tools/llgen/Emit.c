@@ -0,0 +1,519 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Emit.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Emit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary );
+static void   Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent );
+static void   Emit_Symbol( FILE * fh, SpecRef spec, const SpecSymbol * symbol, const char * upper );
+static void   Emit_Grammar( FILE * fh, SpecRef spec, TableRef table );
+
+/*
+ * Writes <Name>.h and <Name>.c next to <Name>.g, with identifiers
+ * prefixed by <Name>.
+ *
+ * Columns of the table are the terminals of the grammar, mapped from token
+ * values, with column 0 for tokens the grammar does not use. Cells hold a
+ * production plus one, 0 being a syntax error. The right-hand sides of the
+ * productions are stored reversed, back to back, so that expanding a
+ * nonterminal is a single copy onto the stack.
+ */
+bool Emit_Parser( SpecRef spec, TableRef table )
+{
+    char         base[ 1024 ];
+    char         upper[ 1024 ];
+    char         summary[ 256 ];
+    const char * prefix;
+    const char * param;
+    size_t       terminals;
+    size_t       nonterminals;
+    size_t       productions;
+    size_t       total;
+    size_t       width;
+    size_t *     values;
+    FILE *       fh;
+
+    if( snprintf( base, sizeof( base ), "%s", Spec_GetPath( spec ) ) >= ( int )sizeof( base ) || strlen( base ) < 3 || strcmp( base + strlen( base ) - 2, ".g" ) != 0 )
+    {
+        fprintf( stderr, "%s: Grammar file names must end with .g\n", Spec_GetPath( spec ) );
+
+        return false;
+    }
+
+    base[ strlen( base ) - 2 ] = 0;
+    prefix                     = ( strrchr( base, '/' ) == NULL ) ? base : strrchr( base, '/' ) + 1;
+    param                      = ( Spec_GetCode( spec, SpecCodeParam ) == NULL ) ? "void" : Spec_GetCode( spec, SpecCodeParam );
+    terminals                  = Spec_GetTerminalCount( spec );
+    nonterminals               = Spec_GetNonterminalCount( spec );
+    productions                = Spec_GetProductionCount( spec );
+    total                      = 0;
+    width                      = 0;
+
+    for( size_t i = 0; prefix[ i ] != 0; i++ )
+    {
+        upper[ i ]     = ( char )toupper( ( unsigned char )prefix[ i ] );
+        upper[ i + 1 ] = 0;
+    }
+
+    for( size_t p = 0; p < productions; p++ )
+    {
+        total += Spec_GetProduction( spec, p )->length;
+    }
+
+    if( terminals + 1 > UINT8_MAX || nonterminals > 0x100 || Spec_GetActionCount( spec ) > 0xFE00 || productions + 1 > UINT8_MAX || total > UINT16_MAX )
+    {
+        fprintf( stderr, "%s: The grammar is too large\n", Spec_GetPath( spec ) );
+
+        return false;
+    }
+
+    if( ( values = calloc( terminals + total + 1, sizeof( size_t ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    snprintf( summary, sizeof( summary ), "%zu terminals, %zu nonterminals, %zu productions.", terminals, nonterminals, productions );
+
+    if( ( fh = Emit_Open( base, "h", prefix, spec, summary ) ) == NULL )
+    {
+        free( values );
+
+        return false;
+    }
+
+    fprintf( fh, "#ifndef %s_H\n", upper );
+    fprintf( fh, "#define %s_H\n\n", upper );
+    fprintf( fh, "#include <stdbool.h>\n" );
+    fprintf( fh, "#include <stddef.h>\n" );
+
+    for( size_t i = 0; i < Spec_GetIncludeCount( spec ); i++ )
+    {
+        fprintf( fh, "#include \"%s\"\n", Spec_GetInclude( spec, i ) );
+    }
+
+    fprintf( fh, "\n/*\n" );
+    fprintf( fh, " * Parses the input, running the actions of the grammar as they are\n" );
+    fprintf( fh, " * reached, and returns false on the first syntax error.\n" );
+    fprintf( fh, " */\n" );
+    fprintf( fh, "bool %s_Parse( %s );\n\n", prefix, param );
+    fprintf( fh, "/*\n" );
+    fprintf( fh, " * Size in bytes of the largest stack the parser moved to the heap since\n" );
+    fprintf( fh, " * the last call, for inputs nested too deep for its C stack. It is not\n" );
+    fprintf( fh, " * synchronized, so it is only meaningful when parsing on one thread.\n" );
+    fprintf( fh, " */\n" );
+    fprintf( fh, "size_t %s_GetHeapPeak( void );\n\n", prefix );
+    fprintf( fh, "#endif /* %s_H */\n", upper );
+    fclose( fh );
+
+    if( ( fh = Emit_Open( base, "c", prefix, spec, summary ) ) == NULL )
+    {
+        free( values );
+
+        return false;
+    }
+
+    fprintf( fh, "#include \"%s.h\"\n", prefix );
+    fprintf( fh, "#include <stdint.h>\n" );
+    fprintf( fh, "#include <stdlib.h>\n" );
+    fprintf( fh, "#include <string.h>\n\n" );
+
+    Emit_Grammar( fh, spec, table );
+
+    fprintf( fh, "/*\n * Stack entries below 0x100 are tokens.\n */\n" );
+    fprintf( fh, "#define %s_NONTERMINAL 0x100\n", upper );
+
+    if( Spec_GetActionCount( spec ) > 0 )
+    {
+        fprintf( fh, "#define %s_ACTION      0x200\n", upper );
+    }
+
+    fprintf( fh, "\n" );
+    fprintf( fh, "/*\n * Stack entries kept on the C stack before spilling to the heap.\n */\n" );
+    fprintf( fh, "#define %s_STACK 64\n\n", upper );
+    fprintf( fh, "/*\n * Largest stack moved to the heap, until %s_GetHeapPeak reads it.\n */\n", prefix );
+    fprintf( fh, "static size_t %s_HeapPeak = 0;\n\n", prefix );
+
+    fprintf( fh, "/*\n * Column of the table of each token.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Columns[] =\n{\n", prefix );
+
+    for( size_t i = 0; i < terminals; i++ )
+    {
+        width = ( strlen( Spec_GetTerminal( spec, i ) ) > width ) ? strlen( Spec_GetTerminal( spec, i ) ) : width;
+    }
+
+    for( size_t i = 0; i < terminals; i++ )
+    {
+        fprintf( fh, "    [ %-*s ] = %zu%s\n", ( int )width, Spec_GetTerminal( spec, i ), i + 1, ( i + 1 < terminals ) ? "," : "" );
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "_Static_assert( sizeof( %s_Columns ) <= %s_NONTERMINAL, \"Token values must be below %s_NONTERMINAL\" );\n\n", prefix, upper, upper );
+    fprintf( fh, "/*\n * Production plus one to expand each nonterminal with, by column.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Table[ %zu ][ %zu ] =\n{\n", prefix, nonterminals, terminals + 1 );
+
+    for( size_t n = 0; n < nonterminals; n++ )
+    {
+        values[ 0 ] = 0;
+
+        for( size_t t = 0; t < terminals; t++ )
+        {
+            size_t production;
+
+            production      = Table_GetProduction( table, n, t );
+            values[ t + 1 ] = ( production == SPEC_NONE ) ? 0 : production + 1;
+        }
+
+        fprintf( fh, "    {\n" );
+        Emit_Table( fh, values, terminals + 1, "        " );
+        fprintf( fh, "    },\n" );
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "/*\n * Start of the symbols of each production, which ends where the next\n * one starts.\n */\n" );
+    fprintf( fh, "static const uint16_t %s_Offsets[ %zu ] =\n{\n", prefix, productions + 1 );
+
+    values[ 0 ] = 0;
+
+    for( size_t p = 0; p < productions; p++ )
+    {
+        values[ p + 1 ] = values[ p ] + Spec_GetProduction( spec, p )->length;
+    }
+
+    Emit_Table( fh, values, productions + 1, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "/*\n * Right-hand sides of the productions, reversed.\n */\n" );
+    fprintf( fh, "static const uint16_t %s_Symbols[ %zu ] =\n{\n", prefix, ( total > 0 ) ? total : 1 );
+
+    for( size_t p = 0; p < productions; p++ )
+    {
+        const SpecProduction * production;
+
+        production = Spec_GetProduction( spec, p );
+
+        for( size_t i = production->length; i > 0; i-- )
+        {
+            fprintf( fh, "    " );
+            Emit_Symbol( fh, spec, &( production->rhs[ i - 1 ] ), upper );
+            fprintf( fh, ",\n" );
+        }
+    }
+
+    if( total == 0 )
+    {
+        fprintf( fh, "    0\n" );
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "size_t %s_GetHeapPeak( void )\n", prefix );
+    fprintf( fh, "{\n" );
+    fprintf( fh, "    size_t peak;\n\n" );
+    fprintf( fh, "    peak%*s = %s_HeapPeak;\n", ( int )( strlen( prefix ) + 5 ), "", prefix );
+    fprintf( fh, "    %s_HeapPeak = 0;\n\n", prefix );
+    fprintf( fh, "    return peak;\n" );
+    fprintf( fh, "}\n\n" );
+    fprintf( fh, "bool %s_Parse( %s )\n", prefix, param );
+    fprintf( fh, "{\n" );
+    fprintf( fh, "    uint16_t   inlineStack[ %s_STACK ];\n", upper );
+    fprintf( fh, "    uint16_t * stack;\n" );
+    fprintf( fh, "    size_t     count;\n" );
+    fprintf( fh, "    size_t     capacity;\n" );
+    fprintf( fh, "    bool       ok;\n" );
+    fprintf( fh, "%s", ( Spec_GetLocalCount( spec ) > 0 ) ? "\n" : "" );
+
+    for( size_t i = 0; i < Spec_GetLocalCount( spec ); i++ )
+    {
+        fprintf( fh, "    %s\n", Spec_GetLocal( spec, i ) );
+    }
+
+    fprintf( fh, "\n" );
+    fprintf( fh, "    stack      = inlineStack;\n" );
+    fprintf( fh, "    capacity   = %s_STACK;\n", upper );
+    fprintf( fh, "    stack[ 0 ] = %s;\n", Spec_GetTerminal( spec, Spec_GetEnd( spec ) ) );
+    fprintf( fh, "    stack[ 1 ] = %s_NONTERMINAL + %zu;\n", upper, Spec_GetStart( spec ) );
+    fprintf( fh, "    count      = 2;\n" );
+    fprintf( fh, "    ok         = true;\n\n" );
+    fprintf( fh, "    while( ok && count > 0 )\n" );
+    fprintf( fh, "    {\n" );
+    fprintf( fh, "        unsigned int symbol;\n" );
+    fprintf( fh, "        unsigned int token;\n" );
+    fprintf( fh, "        unsigned int production;\n" );
+    fprintf( fh, "        size_t       length;\n\n" );
+    fprintf( fh, "        symbol = stack[ --count ];\n\n" );
+
+    if( Spec_GetActionCount( spec ) > 0 )
+    {
+        fprintf( fh, "        if( symbol >= %s_ACTION )\n", upper );
+        fprintf( fh, "        {\n" );
+        fprintf( fh, "            switch( symbol - %s_ACTION )\n", upper );
+        fprintf( fh, "            {\n" );
+
+        for( size_t i = 0; i < Spec_GetActionCount( spec ); i++ )
+        {
+            fprintf( fh, "                case %zu:\n\n", i );
+            fprintf( fh, "                    %s\n\n", Spec_GetAction( spec, i ) );
+            fprintf( fh, "                    break;\n\n" );
+        }
+
+        fprintf( fh, "                default:\n\n" );
+        fprintf( fh, "                    break;\n" );
+        fprintf( fh, "            }\n\n" );
+        fprintf( fh, "            continue;\n" );
+        fprintf( fh, "        }\n\n" );
+    }
+
+    fprintf( fh, "        token = ( unsigned int )( %s );\n\n", Spec_GetCode( spec, SpecCodeLookahead ) );
+    fprintf( fh, "        if( symbol < %s_NONTERMINAL )\n", upper );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            if( symbol != token )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                %s\n\n", Spec_GetCode( spec, SpecCodeError ) );
+    fprintf( fh, "                ok = false;\n" );
+    fprintf( fh, "            }\n" );
+    fprintf( fh, "            else if( count > 0 )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                %s\n", Spec_GetCode( spec, SpecCodeAdvance ) );
+    fprintf( fh, "            }\n\n" );
+    fprintf( fh, "            continue;\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        production = ( token < sizeof( %s_Columns ) ) ? %s_Table[ symbol - %s_NONTERMINAL ][ %s_Columns[ token ] ] : 0;\n\n", prefix, prefix, upper, prefix );
+    fprintf( fh, "        if( production == 0 )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            %s\n\n", Spec_GetCode( spec, SpecCodeError ) );
+    fprintf( fh, "            ok = false;\n\n" );
+    fprintf( fh, "            continue;\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        length = ( size_t )( %s_Offsets[ production ] - %s_Offsets[ production - 1 ] );\n\n", prefix, prefix );
+    fprintf( fh, "        if( count + length > capacity )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            uint16_t * grown;\n\n" );
+    fprintf( fh, "            if( ( grown = malloc( ( capacity * 2 + length ) * sizeof( uint16_t ) ) ) == NULL )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                %s\n\n", Spec_GetCode( spec, SpecCodeError ) );
+    fprintf( fh, "                ok = false;\n\n" );
+    fprintf( fh, "                continue;\n" );
+    fprintf( fh, "            }\n\n" );
+    fprintf( fh, "            memcpy( grown, stack, count * sizeof( uint16_t ) );\n\n" );
+    fprintf( fh, "            if( stack != inlineStack )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                free( stack );\n" );
+    fprintf( fh, "            }\n\n" );
+    fprintf( fh, "            stack    = grown;\n" );
+    fprintf( fh, "            capacity = capacity * 2 + length;\n\n" );
+    fprintf( fh, "            if( capacity * sizeof( uint16_t ) > %s_HeapPeak )\n", prefix );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                %s_HeapPeak = capacity * sizeof( uint16_t );\n", prefix );
+    fprintf( fh, "            }\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        memcpy( stack + count, %s_Symbols + %s_Offsets[ production - 1 ], length * sizeof( uint16_t ) );\n\n", prefix, prefix );
+    fprintf( fh, "        count += length;\n" );
+    fprintf( fh, "    }\n\n" );
+    fprintf( fh, "    if( stack != inlineStack )\n" );
+    fprintf( fh, "    {\n" );
+    fprintf( fh, "        free( stack );\n" );
+    fprintf( fh, "    }\n\n" );
+    fprintf( fh, "    return ok;\n" );
+    fprintf( fh, "}\n" );
+    fclose( fh );
+
+    free( values );
+
+    return true;
+}
+
+static void Emit_Symbol( FILE * fh, SpecRef spec, const SpecSymbol * symbol, const char * upper )
+{
+    if( symbol->kind == SpecSymbolTerminal )
+    {
+        fprintf( fh, "%s", Spec_GetTerminal( spec, symbol->index ) );
+    }
+    else if( symbol->kind == SpecSymbolNonterminal )
+    {
+        fprintf( fh, "%s_NONTERMINAL + %zu", upper, symbol->index );
+    }
+    else
+    {
+        fprintf( fh, "%s_ACTION + %zu", upper, symbol->index );
+    }
+}
+
+/*
+ * Writes the grammar as a comment, with the productions numbered as in the
+ * table, and the FIRST and FOLLOW sets of the nonterminals.
+ */
+static void Emit_Grammar( FILE * fh, SpecRef spec, TableRef table )
+{
+    size_t width;
+
+    width = 0;
+
+    for( size_t n = 0; n < Spec_GetNonterminalCount( spec ); n++ )
+    {
+        width = ( strlen( Spec_GetNonterminal( spec, n ) ) > width ) ? strlen( Spec_GetNonterminal( spec, n ) ) : width;
+    }
+
+    fprintf( fh, "/*\n" );
+
+    for( size_t p = 0; p < Spec_GetProductionCount( spec ); p++ )
+    {
+        const SpecProduction * production;
+
+        production = Spec_GetProduction( spec, p );
+
+        fprintf( fh, " * %3zu  %-*s ->", p + 1, ( int )width, Spec_GetNonterminal( spec, production->lhs ) );
+
+        for( size_t i = 0; i < production->length; i++ )
+        {
+            if( production->rhs[ i ].kind == SpecSymbolTerminal )
+            {
+                fprintf( fh, " %s", Spec_GetTerminal( spec, production->rhs[ i ].index ) );
+            }
+            else if( production->rhs[ i ].kind == SpecSymbolNonterminal )
+            {
+                fprintf( fh, " %s", Spec_GetNonterminal( spec, production->rhs[ i ].index ) );
+            }
+            else
+            {
+                fprintf( fh, " {%zu}", production->rhs[ i ].index );
+            }
+        }
+
+        fprintf( fh, "%s\n", ( production->length == 0 ) ? " epsilon" : "" );
+    }
+
+    fprintf( fh, " *\n" );
+
+    for( size_t n = 0; n < Spec_GetNonterminalCount( spec ); n++ )
+    {
+        fprintf( fh, " * FIRST(  %-*s ) =", ( int )width, Spec_GetNonterminal( spec, n ) );
+
+        for( size_t t = 0; t < Spec_GetTerminalCount( spec ); t++ )
+        {
+            fprintf( fh, "%s", ( Table_IsFirst( table, n, t ) ) ? " " : "" );
+            fprintf( fh, "%s", ( Table_IsFirst( table, n, t ) ) ? Spec_GetTerminal( spec, t ) : "" );
+        }
+
+        fprintf( fh, "%s\n", ( Table_IsNullable( table, n ) ) ? " epsilon" : "" );
+    }
+
+    for( size_t n = 0; n < Spec_GetNonterminalCount( spec ); n++ )
+    {
+        fprintf( fh, " * FOLLOW( %-*s ) =", ( int )width, Spec_GetNonterminal( spec, n ) );
+
+        for( size_t t = 0; t < Spec_GetTerminalCount( spec ); t++ )
+        {
+            fprintf( fh, "%s", ( Table_IsFollow( table, n, t ) ) ? " " : "" );
+            fprintf( fh, "%s", ( Table_IsFollow( table, n, t ) ) ? Spec_GetTerminal( spec, t ) : "" );
+        }
+
+        fprintf( fh, "\n" );
+    }
+
+    fprintf( fh, " */\n\n" );
+}
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary )
+{
+    static const char * license[] =
+    {
+        "The MIT License (MIT)",
+        "",
+        "Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com",
+        "",
+        "Permission is hereby granted, free of charge, to any person obtaining a copy",
+        "of this software and associated documentation files (the \"Software\"), to deal",
+        "in the Software without restriction, including without limitation the rights",
+        "to use, copy, modify, merge, publish, distribute, sublicense, and/or sell",
+        "copies of the Software, and to permit persons to whom the Software is",
+        "furnished to do so, subject to the following conditions:",
+        "",
+        "The above copyright notice and this permission notice shall be included in",
+        "all copies or substantial portions of the Software.",
+        "",
+        "THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR",
+        "IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,",
+        "FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE",
+        "AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER",
+        "LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,",
+        "OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN",
+        "THE SOFTWARE."
+    };
+
+    char         path[ 1100 ];
+    const char * name;
+    FILE *       fh;
+
+    snprintf( path, sizeof( path ), "%s.%s", base, extension );
+
+    if( ( fh = fopen( path, "w" ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot write %s: %s\n", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    name = ( strrchr( Spec_GetPath( spec ), '/' ) == NULL ) ? Spec_GetPath( spec ) : strrchr( Spec_GetPath( spec ), '/' ) + 1;
+
+    fprintf( fh, "/*******************************************************************************\n" );
+
+    for( size_t i = 0; i < sizeof( license ) / sizeof( *( license ) ); i++ )
+    {
+        fprintf( fh, " * %s\n", license[ i ] );
+    }
+
+    fprintf( fh, " ******************************************************************************/\n\n" );
+    fprintf( fh, "/*!\n" );
+    fprintf( fh, " * @%-11s %s.%s\n", ( extension[ 0 ] == 'h' ) ? "header" : "file", prefix, extension );
+    fprintf( fh, " * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com\n" );
+    fprintf( fh, " * @dicussion   Generated by tools-llgen from %s, do not edit.\n", name );
+    fprintf( fh, " *              %s\n", summary );
+    fprintf( fh, " */\n\n" );
+
+    return fh;
+}
+
+static void Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        fprintf( fh, "%s%3zu%s", ( i % 16 == 0 ) ? indent : " ", values[ i ], ( i + 1 < count ) ? "," : "" );
+
+        if( i % 16 == 15 || i + 1 == count )
+        {
+            fprintf( fh, "\n" );
+        }
+    }
+}
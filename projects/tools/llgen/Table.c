@@ -0,0 +1,347 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Table.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * Sets of terminals are rows of booleans, one row per nonterminal.
+ */
+struct Table
+{
+    uint64_t rc;
+    SpecRef  spec;
+    size_t   terminals;
+    size_t   nonterminals;
+    bool *   nullable;
+    bool *   first;
+    bool *   follow;
+    size_t * productions;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static bool Table_Union( bool * to, const bool * from, size_t count );
+static bool Table_FirstOf( TableRef table, const SpecProduction * production, size_t from, bool * set );
+static bool Table_Fill( TableRef table );
+
+TableRef Table_Create( SpecRef spec )
+{
+    TableRef table;
+    size_t   t;
+    size_t   n;
+
+    if( ( table = calloc( 1, sizeof( struct Table ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    t                   = Spec_GetTerminalCount( spec );
+    n                   = Spec_GetNonterminalCount( spec );
+    table->rc           = 1;
+    table->spec         = Spec_Retain( spec );
+    table->terminals    = t;
+    table->nonterminals = n;
+    table->nullable     = calloc( n, sizeof( bool ) );
+    table->first        = calloc( n * t, sizeof( bool ) );
+    table->follow       = calloc( n * t, sizeof( bool ) );
+    table->productions  = malloc( n * t * sizeof( size_t ) );
+
+    if( table->nullable == NULL || table->first == NULL || table->follow == NULL || table->productions == NULL || Table_Fill( table ) == false )
+    {
+        Table_Release( table );
+
+        return NULL;
+    }
+
+    return table;
+}
+
+TableRef Table_Retain( TableRef table )
+{
+    if( table == NULL )
+    {
+        return NULL;
+    }
+
+    table->rc++;
+
+    return table;
+}
+
+void Table_Release( TableRef table )
+{
+    if( table == NULL )
+    {
+        return;
+    }
+
+    if( --( table->rc ) > 0 )
+    {
+        return;
+    }
+
+    Spec_Release( table->spec );
+    free( table->nullable );
+    free( table->first );
+    free( table->follow );
+    free( table->productions );
+    free( table );
+}
+
+bool Table_IsNullable( TableRef table, size_t nonterminal )
+{
+    return table->nullable[ nonterminal ];
+}
+
+bool Table_IsFirst( TableRef table, size_t nonterminal, size_t terminal )
+{
+    return table->first[ nonterminal * table->terminals + terminal ];
+}
+
+bool Table_IsFollow( TableRef table, size_t nonterminal, size_t terminal )
+{
+    return table->follow[ nonterminal * table->terminals + terminal ];
+}
+
+/*
+ * Returns the production to expand the nonterminal with when the
+ * lookahead is the terminal, or SPEC_NONE on a syntax error.
+ */
+size_t Table_GetProduction( TableRef table, size_t nonterminal, size_t terminal )
+{
+    return table->productions[ nonterminal * table->terminals + terminal ];
+}
+
+/*
+ * Returns true if anything was added.
+ */
+static bool Table_Union( bool * to, const bool * from, size_t count )
+{
+    bool changed;
+
+    changed = false;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        if( from[ i ] && to[ i ] == false )
+        {
+            to[ i ]  = true;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/*
+ * Adds FIRST of the right-hand side of the production, starting at the
+ * given symbol, to the set. Actions derive nothing, so they are skipped.
+ * Returns true if that part of the right-hand side is nullable.
+ */
+static bool Table_FirstOf( TableRef table, const SpecProduction * production, size_t from, bool * set )
+{
+    for( size_t i = from; i < production->length; i++ )
+    {
+        const SpecSymbol * symbol;
+
+        symbol = &( production->rhs[ i ] );
+
+        if( symbol->kind == SpecSymbolTerminal )
+        {
+            set[ symbol->index ] = true;
+
+            return false;
+        }
+
+        if( symbol->kind == SpecSymbolNonterminal )
+        {
+            Table_Union( set, table->first + symbol->index * table->terminals, table->terminals );
+
+            if( table->nullable[ symbol->index ] == false )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Computes nullable, FIRST and FOLLOW as fixed points, then fills the
+ * table, reporting every cell two productions compete for.
+ */
+static bool Table_Fill( TableRef table )
+{
+    SpecRef spec;
+    size_t  count;
+    size_t  t;
+    bool *  set;
+    bool    changed;
+    bool    ok;
+
+    spec  = table->spec;
+    count = Spec_GetProductionCount( spec );
+    t     = table->terminals;
+
+    if( ( set = malloc( ( t > 0 ) ? t : 1 ) ) == NULL )
+    {
+        return false;
+    }
+
+    do
+    {
+        changed = false;
+
+        for( size_t p = 0; p < count; p++ )
+        {
+            const SpecProduction * production;
+            bool                   nullable;
+            bool *                 first;
+
+            production = Spec_GetProduction( spec, p );
+            first      = table->first + production->lhs * t;
+
+            for( size_t i = 0; i < t; i++ )
+            {
+                set[ i ] = false;
+            }
+
+            nullable = Table_FirstOf( table, production, 0, set );
+            changed  = Table_Union( first, set, t ) || changed;
+
+            if( nullable && table->nullable[ production->lhs ] == false )
+            {
+                table->nullable[ production->lhs ] = true;
+                changed                            = true;
+            }
+        }
+    }
+    while( changed );
+
+    table->follow[ Spec_GetStart( spec ) * t + Spec_GetEnd( spec ) ] = true;
+
+    do
+    {
+        changed = false;
+
+        for( size_t p = 0; p < count; p++ )
+        {
+            const SpecProduction * production;
+
+            production = Spec_GetProduction( spec, p );
+
+            for( size_t i = 0; i < production->length; i++ )
+            {
+                bool * follow;
+
+                if( production->rhs[ i ].kind != SpecSymbolNonterminal )
+                {
+                    continue;
+                }
+
+                follow = table->follow + production->rhs[ i ].index * t;
+
+                for( size_t j = 0; j < t; j++ )
+                {
+                    set[ j ] = false;
+                }
+
+                if( Table_FirstOf( table, production, i + 1, set ) )
+                {
+                    Table_Union( set, table->follow + production->lhs * t, t );
+                }
+
+                changed = Table_Union( follow, set, t ) || changed;
+            }
+        }
+    }
+    while( changed );
+
+    for( size_t i = 0; i < table->nonterminals * t; i++ )
+    {
+        table->productions[ i ] = SPEC_NONE;
+    }
+
+    ok = true;
+
+    for( size_t p = 0; p < count; p++ )
+    {
+        const SpecProduction * production;
+        size_t *               row;
+
+        production = Spec_GetProduction( spec, p );
+        row        = table->productions + production->lhs * t;
+
+        for( size_t i = 0; i < t; i++ )
+        {
+            set[ i ] = false;
+        }
+
+        if( Table_FirstOf( table, production, 0, set ) )
+        {
+            Table_Union( set, table->follow + production->lhs * t, t );
+        }
+
+        for( size_t i = 0; i < t; i++ )
+        {
+            if( set[ i ] == false )
+            {
+                continue;
+            }
+
+            if( row[ i ] != SPEC_NONE )
+            {
+                fprintf( stderr, "%s:%zu: LL(1) conflict: %s on %s also expands with the rule at line %zu\n", Spec_GetPath( spec ), production->line, Spec_GetNonterminal( spec, production->lhs ), Spec_GetTerminal( spec, i ), Spec_GetProduction( spec, row[ i ] )->line );
+
+                ok = false;
+            }
+            else
+            {
+                row[ i ] = p;
+            }
+        }
+    }
+
+    free( set );
+
+    return ok;
+}
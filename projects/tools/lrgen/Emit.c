@@ -0,0 +1,855 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Emit.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Emit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+/*
+ * A sparse table packed into a single vector: the entry of row r at
+ * column c is next[ base[ r ] + c ] if check there is r, and the default
+ * of the row otherwise.
+ */
+typedef struct
+{
+    size_t * base;
+    size_t * check;
+    int *    next;
+    size_t   size;
+    size_t   entries;
+} EmitPacked;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary );
+static void   Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent );
+static void   Emit_SignedTable( FILE * fh, const int * values, size_t count, const char * indent );
+static bool   Emit_Pack( const int * rows, const bool * used, size_t rowCount, size_t columns, EmitPacked * packed );
+static void   Emit_FreePacked( EmitPacked * packed );
+static bool   Emit_Code( FILE * fh, SpecRef spec, const char * code, size_t length, const char * value, size_t line );
+static void   Emit_Grammar( FILE * fh, SpecRef spec );
+
+/*
+ * Writes <Name>.h and <Name>.c next to <Name>.y, with identifiers
+ * prefixed by <Name>.
+ *
+ * Actions are indexed by state and terminal, and gotos by nonterminal and
+ * state. Each state reduces by default with its most frequent rule, which
+ * also stands for its error entries, as yacc does: errors are still
+ * caught before the next shift. Each nonterminal goes by default to its
+ * most frequent state. What remains is packed into comb vectors, so a
+ * lookup is an addition and a comparison.
+ */
+bool Emit_Parser( SpecRef spec, LRRef lr )
+{
+    char         base[ 1024 ];
+    char         upper[ 1024 ];
+    char         summary[ 256 ];
+    const char * prefix;
+    const char * param;
+    const char * type;
+    size_t       states;
+    size_t       terminals;
+    size_t       nonterminals;
+    size_t       productions;
+    size_t       width;
+    int *        rows;
+    bool *       used;
+    int *        defaults;
+    size_t *     values;
+    EmitPacked   actions;
+    EmitPacked   gotos;
+    FILE *       fh;
+    bool         ok;
+
+    if( snprintf( base, sizeof( base ), "%s", Spec_GetPath( spec ) ) >= ( int )sizeof( base ) || strlen( base ) < 3 || strcmp( base + strlen( base ) - 2, ".y" ) != 0 )
+    {
+        fprintf( stderr, "%s: Grammar file names must end with .y\n", Spec_GetPath( spec ) );
+
+        return false;
+    }
+
+    base[ strlen( base ) - 2 ] = 0;
+    prefix                     = ( strrchr( base, '/' ) == NULL ) ? base : strrchr( base, '/' ) + 1;
+    param                      = ( Spec_GetCode( spec, SpecCodeParam ) == NULL ) ? "void" : Spec_GetCode( spec, SpecCodeParam );
+    type                       = ( Spec_GetCode( spec, SpecCodeValue ) == NULL ) ? "int" : Spec_GetCode( spec, SpecCodeValue );
+    states                     = LR_GetStateCount( lr );
+    terminals                  = Spec_GetTerminalCount( spec );
+    nonterminals               = Spec_GetNonterminalCount( spec );
+    productions                = Spec_GetProductionCount( spec ) + 1;
+    width                      = 0;
+
+    for( size_t i = 0; prefix[ i ] != 0; i++ )
+    {
+        upper[ i ]     = ( char )toupper( ( unsigned char )prefix[ i ] );
+        upper[ i + 1 ] = 0;
+    }
+
+    if( terminals + 1 > UINT8_MAX || nonterminals > UINT8_MAX )
+    {
+        fprintf( stderr, "%s: The grammar is too large\n", Spec_GetPath( spec ) );
+
+        return false;
+    }
+
+    for( size_t p = 1; p < productions; p++ )
+    {
+        if( Spec_GetProduction( spec, p - 1 )->length > UINT8_MAX )
+        {
+            fprintf( stderr, "%s:%zu: The rule is too long\n", Spec_GetPath( spec ), Spec_GetProduction( spec, p - 1 )->line );
+
+            return false;
+        }
+    }
+
+    memset( &actions, 0, sizeof( EmitPacked ) );
+    memset( &gotos, 0, sizeof( EmitPacked ) );
+
+    rows     = calloc( states * ( terminals + nonterminals + 1 ), sizeof( int ) );
+    used     = calloc( states * ( terminals + nonterminals + 1 ), sizeof( bool ) );
+    defaults = calloc( states + nonterminals, sizeof( int ) );
+    values   = calloc( states + nonterminals + productions, sizeof( size_t ) );
+    ok       = rows != NULL && used != NULL && defaults != NULL && values != NULL;
+
+    for( size_t s = 0; ok && s < states; s++ )
+    {
+        int *  row;
+        int    best;
+        size_t bestCount;
+
+        row       = rows + s * ( terminals + 1 );
+        best      = 0;
+        bestCount = 0;
+
+        for( size_t t = 0; t < terminals; t++ )
+        {
+            int    action;
+            size_t count;
+
+            /* Accepting stays explicit, so that trailing input is an error */
+            if( ( action = LR_GetAction( lr, s, t ) ) >= -1 )
+            {
+                continue;
+            }
+
+            count = 0;
+
+            for( size_t k = 0; k < terminals; k++ )
+            {
+                count += ( LR_GetAction( lr, s, k ) == action ) ? 1 : 0;
+            }
+
+            if( count > bestCount )
+            {
+                best      = action;
+                bestCount = count;
+            }
+        }
+
+        defaults[ s ] = best;
+
+        for( size_t t = 0; t < terminals; t++ )
+        {
+            int action;
+
+            action                                = LR_GetAction( lr, s, t );
+            row[ t + 1 ]                          = action;
+            used[ s * ( terminals + 1 ) + t + 1 ] = action != best && ( action != 0 || LR_IsExplicitError( lr, s, t ) );
+        }
+    }
+
+    ok = ok && Emit_Pack( rows, used, states, terminals + 1, &actions );
+
+    if( ok )
+    {
+        memset( rows, 0, states * ( terminals + nonterminals + 1 ) * sizeof( int ) );
+        memset( used, 0, states * ( terminals + nonterminals + 1 ) * sizeof( bool ) );
+    }
+
+    for( size_t n = 0; ok && n < nonterminals; n++ )
+    {
+        int *  row;
+        size_t best;
+        size_t bestCount;
+
+        row       = rows + n * states;
+        best      = 0;
+        bestCount = 0;
+
+        for( size_t s = 0; s < states; s++ )
+        {
+            size_t target;
+            size_t count;
+
+            if( ( target = LR_GetGoto( lr, s, n ) ) == SPEC_NONE )
+            {
+                continue;
+            }
+
+            count = 0;
+
+            for( size_t k = 0; k < states; k++ )
+            {
+                count += ( LR_GetGoto( lr, k, n ) == target ) ? 1 : 0;
+            }
+
+            if( count > bestCount )
+            {
+                best      = target;
+                bestCount = count;
+            }
+        }
+
+        defaults[ states + n ] = ( int )best;
+
+        for( size_t s = 0; s < states; s++ )
+        {
+            size_t target;
+
+            target                 = LR_GetGoto( lr, s, n );
+            row[ s ]               = ( target == SPEC_NONE ) ? 0 : ( int )target;
+            used[ n * states + s ] = target != SPEC_NONE && target != best;
+        }
+    }
+
+    ok = ok && Emit_Pack( rows, used, nonterminals, states, &gotos );
+
+    snprintf( summary, sizeof( summary ), "%zu states, %zu actions and %zu gotos packed in %zu and %zu entries.", states, actions.entries, gotos.entries, actions.size, gotos.size );
+
+    fh = ( ok ) ? Emit_Open( base, "h", prefix, spec, summary ) : NULL;
+    ok = fh != NULL;
+
+    if( ok )
+    {
+        fprintf( fh, "#ifndef %s_H\n", upper );
+        fprintf( fh, "#define %s_H\n\n", upper );
+        fprintf( fh, "#include <stdbool.h>\n" );
+        fprintf( fh, "#include <stddef.h>\n" );
+
+        for( size_t i = 0; i < Spec_GetIncludeCount( spec ); i++ )
+        {
+            fprintf( fh, "#include \"%s\"\n", Spec_GetInclude( spec, i ) );
+        }
+
+        fprintf( fh, "\n/*\n" );
+        fprintf( fh, " * Parses the input, running the actions of the grammar as rules are\n" );
+        fprintf( fh, " * reduced, and returns false on the first syntax error.\n" );
+        fprintf( fh, " */\n" );
+        fprintf( fh, "bool %s_Parse( %s );\n\n", prefix, param );
+        fprintf( fh, "/*\n" );
+        fprintf( fh, " * Size in bytes of the largest stack the parser moved to the heap since\n" );
+        fprintf( fh, " * the last call, for inputs nested too deep for its C stack. It is not\n" );
+        fprintf( fh, " * synchronized, so it is only meaningful when parsing on one thread.\n" );
+        fprintf( fh, " */\n" );
+        fprintf( fh, "size_t %s_GetHeapPeak( void );\n\n", prefix );
+        fprintf( fh, "#endif /* %s_H */\n", upper );
+        fclose( fh );
+    }
+
+    fh = ( ok ) ? Emit_Open( base, "c", prefix, spec, summary ) : NULL;
+    ok = fh != NULL;
+
+    if( ok == false )
+    {
+        Emit_FreePacked( &actions );
+        Emit_FreePacked( &gotos );
+        free( rows );
+        free( used );
+        free( defaults );
+        free( values );
+
+        return false;
+    }
+
+    fprintf( fh, "#include \"%s.h\"\n", prefix );
+    fprintf( fh, "#include <stdint.h>\n" );
+    fprintf( fh, "#include <stdlib.h>\n" );
+    fprintf( fh, "#include <string.h>\n\n" );
+
+    Emit_Grammar( fh, spec );
+
+    fprintf( fh, "/*\n * Stack entries kept on the C stack before spilling to the heap.\n */\n" );
+    fprintf( fh, "#define %s_STACK 64\n\n", upper );
+    fprintf( fh, "/*\n * Largest stack moved to the heap, until %s_GetHeapPeak reads it.\n */\n", prefix );
+    fprintf( fh, "static size_t %s_HeapPeak = 0;\n\n", prefix );
+    fprintf( fh, "/*\n * Column of the action table of each token, 0 being unused.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Columns[] =\n{\n", prefix );
+
+    for( size_t i = 0; i < terminals; i++ )
+    {
+        width = ( strlen( Spec_GetTerminal( spec, i ) ) > width ) ? strlen( Spec_GetTerminal( spec, i ) ) : width;
+    }
+
+    for( size_t i = 0; i < terminals; i++ )
+    {
+        fprintf( fh, "    [ %-*s ] = %zu%s\n", ( int )width, Spec_GetTerminal( spec, i ), i + 1, ( i + 1 < terminals ) ? "," : "" );
+    }
+
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "/*\n" );
+    fprintf( fh, " * Actions are the state to shift to, -1 minus the rule to reduce, rule 0\n" );
+    fprintf( fh, " * accepting the input, or 0 for a syntax error.\n" );
+    fprintf( fh, " */\n" );
+    fprintf( fh, "static const int16_t %s_Default[ %zu ] =\n{\n", prefix, states );
+    Emit_SignedTable( fh, defaults, states, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const uint16_t %s_Base[ %zu ] =\n{\n", prefix, states );
+    Emit_Table( fh, actions.base, states, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const uint16_t %s_Check[ %zu ] =\n{\n", prefix, actions.size );
+    Emit_Table( fh, actions.check, actions.size, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const int16_t %s_Next[ %zu ] =\n{\n", prefix, actions.size );
+    Emit_SignedTable( fh, actions.next, actions.size, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "/*\n * State to go to after reducing to each nonterminal, by state.\n */\n" );
+
+    for( size_t n = 0; n < nonterminals; n++ )
+    {
+        values[ n ] = ( size_t )defaults[ states + n ];
+    }
+
+    fprintf( fh, "static const uint16_t %s_GotoDefault[ %zu ] =\n{\n", prefix, nonterminals );
+    Emit_Table( fh, values, nonterminals, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const uint16_t %s_GotoBase[ %zu ] =\n{\n", prefix, nonterminals );
+    Emit_Table( fh, gotos.base, nonterminals, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const uint16_t %s_GotoCheck[ %zu ] =\n{\n", prefix, gotos.size );
+    Emit_Table( fh, gotos.check, gotos.size, "    " );
+    fprintf( fh, "};\n\n" );
+    fprintf( fh, "static const uint16_t %s_GotoNext[ %zu ] =\n{\n", prefix, gotos.size );
+    Emit_SignedTable( fh, gotos.next, gotos.size, "    " );
+    fprintf( fh, "};\n\n" );
+
+    values[ 0 ] = 1;
+
+    for( size_t p = 1; p < productions; p++ )
+    {
+        values[ p ] = Spec_GetProduction( spec, p - 1 )->length;
+    }
+
+    fprintf( fh, "/*\n * Length and left-hand side of each rule.\n */\n" );
+    fprintf( fh, "static const uint8_t %s_Lengths[ %zu ] =\n{\n", prefix, productions );
+    Emit_Table( fh, values, productions, "    " );
+    fprintf( fh, "};\n\n" );
+
+    values[ 0 ] = Spec_GetStart( spec );
+
+    for( size_t p = 1; p < productions; p++ )
+    {
+        values[ p ] = Spec_GetProduction( spec, p - 1 )->lhs;
+    }
+
+    fprintf( fh, "static const uint8_t %s_Lhs[ %zu ] =\n{\n", prefix, productions );
+    Emit_Table( fh, values, productions, "    " );
+    fprintf( fh, "};\n\n" );
+
+    fprintf( fh, "size_t %s_GetHeapPeak( void )\n", prefix );
+    fprintf( fh, "{\n" );
+    fprintf( fh, "    size_t peak;\n\n" );
+    fprintf( fh, "    peak%*s = %s_HeapPeak;\n", ( int )( strlen( prefix ) + 5 ), "", prefix );
+    fprintf( fh, "    %s_HeapPeak = 0;\n\n", prefix );
+    fprintf( fh, "    return peak;\n" );
+    fprintf( fh, "}\n\n" );
+    fprintf( fh, "bool %s_Parse( %s )\n", prefix, param );
+    fprintf( fh, "{\n" );
+    width = ( strlen( type ) + 2 > strlen( "uint16_t *" ) ) ? strlen( type ) + 2 : strlen( "uint16_t *" );
+
+    fprintf( fh, "    %-*s inlineStates[ %s_STACK ];\n", ( int )width, "uint16_t", upper );
+    fprintf( fh, "    %-*s inlineValues[ %s_STACK ];\n", ( int )width, type, upper );
+    fprintf( fh, "    %-*s states;\n", ( int )width, "uint16_t *" );
+    fprintf( fh, "    %s *%*s values;\n", type, ( int )( width - strlen( type ) - 2 ), "" );
+    fprintf( fh, "    %-*s value;\n", ( int )width, type );
+    fprintf( fh, "    %-*s count;\n", ( int )width, "size_t" );
+    fprintf( fh, "    %-*s capacity;\n", ( int )width, "size_t" );
+    fprintf( fh, "    %-*s ok;\n", ( int )width, "bool" );
+    fprintf( fh, "%s", ( Spec_GetLocalCount( spec ) > 0 ) ? "\n" : "" );
+
+    for( size_t i = 0; i < Spec_GetLocalCount( spec ); i++ )
+    {
+        fprintf( fh, "    %s\n", Spec_GetLocal( spec, i ) );
+    }
+
+    fprintf( fh, "\n" );
+    fprintf( fh, "    states      = inlineStates;\n" );
+    fprintf( fh, "    values      = inlineValues;\n" );
+    fprintf( fh, "    capacity    = %s_STACK;\n", upper );
+    fprintf( fh, "    states[ 0 ] = 0;\n" );
+    fprintf( fh, "    count       = 1;\n" );
+    fprintf( fh, "    ok          = true;\n\n" );
+    fprintf( fh, "    while( true )\n" );
+    fprintf( fh, "    {\n" );
+    fprintf( fh, "        unsigned int state;\n" );
+    fprintf( fh, "        unsigned int token;\n" );
+    fprintf( fh, "        unsigned int index;\n" );
+    fprintf( fh, "        unsigned int production;\n" );
+    fprintf( fh, "        unsigned int lhs;\n" );
+    fprintf( fh, "        size_t       length;\n" );
+    fprintf( fh, "        int          action;\n\n" );
+    fprintf( fh, "        if( count == capacity )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            %-*s grownStates;\n", ( int )width, "uint16_t *" );
+    fprintf( fh, "            %s *%*s grownValues;\n\n", type, ( int )( width - strlen( type ) - 2 ), "" );
+    fprintf( fh, "            grownStates = malloc( capacity * 2 * sizeof( uint16_t ) );\n" );
+    fprintf( fh, "            grownValues = malloc( capacity * 2 * sizeof( %s ) );\n\n", type );
+    fprintf( fh, "            if( grownStates == NULL || grownValues == NULL )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                free( grownStates );\n" );
+    fprintf( fh, "                free( grownValues );\n" );
+    fprintf( fh, "                %s\n\n", Spec_GetCode( spec, SpecCodeError ) );
+    fprintf( fh, "                ok = false;\n\n" );
+    fprintf( fh, "                break;\n" );
+    fprintf( fh, "            }\n\n" );
+    fprintf( fh, "            memcpy( grownStates, states, count * sizeof( uint16_t ) );\n" );
+    fprintf( fh, "            memcpy( grownValues, values, count * sizeof( %s ) );\n\n", type );
+    fprintf( fh, "            if( states != inlineStates )\n" );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                free( states );\n" );
+    fprintf( fh, "                free( values );\n" );
+    fprintf( fh, "            }\n\n" );
+    fprintf( fh, "            states    = grownStates;\n" );
+    fprintf( fh, "            values    = grownValues;\n" );
+    fprintf( fh, "            capacity *= 2;\n\n" );
+    fprintf( fh, "            if( capacity * ( sizeof( uint16_t ) + sizeof( %s ) ) > %s_HeapPeak )\n", type, prefix );
+    fprintf( fh, "            {\n" );
+    fprintf( fh, "                %s_HeapPeak = capacity * ( sizeof( uint16_t ) + sizeof( %s ) );\n", prefix, type );
+    fprintf( fh, "            }\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        state  = states[ count - 1 ];\n" );
+    fprintf( fh, "        token  = ( unsigned int )( %s );\n", Spec_GetCode( spec, SpecCodeLookahead ) );
+    fprintf( fh, "        index  = %s_Base[ state ] + ( ( token < sizeof( %s_Columns ) ) ? %s_Columns[ token ] : 0U );\n", prefix, prefix, prefix );
+    fprintf( fh, "        action = ( %s_Check[ index ] == state ) ? %s_Next[ index ] : %s_Default[ state ];\n\n", prefix, prefix, prefix );
+    fprintf( fh, "        if( action > 0 )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            states[ count ] = ( uint16_t )action;\n\n" );
+
+    if( Spec_GetCode( spec, SpecCodeShift ) == NULL )
+    {
+        fprintf( fh, "            memset( &( values[ count ] ), 0, sizeof( %s ) );\n\n", type );
+    }
+    else
+    {
+        fprintf( fh, "            " );
+        ok = Emit_Code( fh, spec, Spec_GetCode( spec, SpecCodeShift ), 0, "values[ count ]", 0 ) && ok;
+        fprintf( fh, "\n\n" );
+    }
+
+    fprintf( fh, "            count++;\n\n" );
+    fprintf( fh, "            %s\n\n", Spec_GetCode( spec, SpecCodeAdvance ) );
+    fprintf( fh, "            continue;\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        if( action == 0 )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            %s\n\n", Spec_GetCode( spec, SpecCodeError ) );
+    fprintf( fh, "            ok = false;\n\n" );
+    fprintf( fh, "            break;\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        if( ( production = ( unsigned int )( -action - 1 ) ) == 0 )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            break;\n" );
+    fprintf( fh, "        }\n\n" );
+    fprintf( fh, "        length = %s_Lengths[ production ];\n\n", prefix );
+    fprintf( fh, "        if( length > 0 )\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            value = values[ count - length ];\n" );
+    fprintf( fh, "        }\n" );
+    fprintf( fh, "        else\n" );
+    fprintf( fh, "        {\n" );
+    fprintf( fh, "            memset( &value, 0, sizeof( value ) );\n" );
+    fprintf( fh, "        }\n\n" );
+
+    if( Spec_GetActionCount( spec ) > 0 )
+    {
+        fprintf( fh, "        switch( production )\n" );
+        fprintf( fh, "        {\n" );
+
+        for( size_t p = 1; p < productions; p++ )
+        {
+            const SpecProduction * production;
+
+            production = Spec_GetProduction( spec, p - 1 );
+
+            if( production->action == SPEC_NONE )
+            {
+                continue;
+            }
+
+            fprintf( fh, "            case %zu:\n\n", p );
+            fprintf( fh, "                " );
+            ok = Emit_Code( fh, spec, Spec_GetAction( spec, production->action ), production->length, "value", production->line ) && ok;
+            fprintf( fh, "\n\n" );
+            fprintf( fh, "                break;\n\n" );
+        }
+
+        fprintf( fh, "            default:\n\n" );
+        fprintf( fh, "                break;\n" );
+        fprintf( fh, "        }\n\n" );
+        fprintf( fh, "        if( ok == false )\n" );
+        fprintf( fh, "        {\n" );
+        fprintf( fh, "            break;\n" );
+        fprintf( fh, "        }\n\n" );
+    }
+
+    fprintf( fh, "        count          -= length;\n" );
+    fprintf( fh, "        state           = states[ count - 1 ];\n" );
+    fprintf( fh, "        lhs             = %s_Lhs[ production ];\n", prefix );
+    fprintf( fh, "        index           = %s_GotoBase[ lhs ] + state;\n", prefix );
+    fprintf( fh, "        states[ count ] = ( %s_GotoCheck[ index ] == lhs ) ? %s_GotoNext[ index ] : %s_GotoDefault[ lhs ];\n", prefix, prefix, prefix );
+    fprintf( fh, "        values[ count ] = value;\n\n" );
+    fprintf( fh, "        count++;\n" );
+    fprintf( fh, "    }\n\n" );
+
+    if( Spec_GetCode( spec, SpecCodeDrop ) != NULL )
+    {
+        fprintf( fh, "    while( ok == false && count > 1 )\n" );
+        fprintf( fh, "    {\n" );
+        fprintf( fh, "        count--;\n\n" );
+        fprintf( fh, "        " );
+        ok = Emit_Code( fh, spec, Spec_GetCode( spec, SpecCodeDrop ), 0, "values[ count ]", 0 ) && ok;
+        fprintf( fh, "\n" );
+        fprintf( fh, "    }\n\n" );
+    }
+
+    fprintf( fh, "    if( states != inlineStates )\n" );
+    fprintf( fh, "    {\n" );
+    fprintf( fh, "        free( states );\n" );
+    fprintf( fh, "        free( values );\n" );
+    fprintf( fh, "    }\n\n" );
+    fprintf( fh, "    return ok;\n" );
+    fprintf( fh, "}\n" );
+    fclose( fh );
+
+    Emit_FreePacked( &actions );
+    Emit_FreePacked( &gotos );
+    free( rows );
+    free( used );
+    free( defaults );
+    free( values );
+
+    return ok;
+}
+
+/*
+ * Places each row at the first offset where its entries only land on
+ * free slots, and where no other row starts, so that an empty row can
+ * never match the slots of another one.
+ */
+static bool Emit_Pack( const int * rows, const bool * used, size_t rowCount, size_t columns, EmitPacked * packed )
+{
+    size_t capacity;
+    bool * starts;
+
+    capacity        = rowCount * columns + columns + 1;
+    packed->base    = calloc( rowCount + 1, sizeof( size_t ) );
+    packed->check   = malloc( capacity * sizeof( size_t ) );
+    packed->next    = calloc( capacity, sizeof( int ) );
+    packed->size    = 0;
+    packed->entries = 0;
+    starts          = calloc( capacity, sizeof( bool ) );
+
+    if( packed->base == NULL || packed->check == NULL || packed->next == NULL || starts == NULL )
+    {
+        free( starts );
+
+        return false;
+    }
+
+    for( size_t i = 0; i < capacity; i++ )
+    {
+        packed->check[ i ] = UINT16_MAX;
+    }
+
+    for( size_t r = 0; r < rowCount; r++ )
+    {
+        const int *  row;
+        const bool * mask;
+        size_t       base;
+
+        row  = rows + r * columns;
+        mask = used + r * columns;
+
+        for( base = 0; base + columns <= capacity; base++ )
+        {
+            size_t c;
+
+            if( starts[ base ] )
+            {
+                continue;
+            }
+
+            for( c = 0; c < columns; c++ )
+            {
+                if( mask[ c ] && packed->check[ base + c ] != UINT16_MAX )
+                {
+                    break;
+                }
+            }
+
+            if( c == columns )
+            {
+                break;
+            }
+        }
+
+        starts[ base ]    = true;
+        packed->base[ r ] = base;
+        packed->size      = ( base + columns > packed->size ) ? base + columns : packed->size;
+
+        for( size_t c = 0; c < columns; c++ )
+        {
+            if( mask[ c ] )
+            {
+                packed->check[ base + c ] = r;
+                packed->next[ base + c ]  = row[ c ];
+
+                packed->entries++;
+            }
+        }
+    }
+
+    free( starts );
+
+    return true;
+}
+
+static void Emit_FreePacked( EmitPacked * packed )
+{
+    free( packed->base );
+    free( packed->check );
+    free( packed->next );
+}
+
+/*
+ * Writes the code of an action, replacing $$ with the given value and $n
+ * with the value of the nth symbol of a rule of the given length, which
+ * are the topmost values of the stack.
+ */
+static bool Emit_Code( FILE * fh, SpecRef spec, const char * code, size_t length, const char * value, size_t line )
+{
+    char quote;
+
+    quote = 0;
+
+    for( const char * p = code; *( p ) != 0; p++ )
+    {
+        if( quote != 0 )
+        {
+            fputc( *( p ), fh );
+
+            if( *( p ) == '\\' && p[ 1 ] != 0 )
+            {
+                fputc( *( ++p ), fh );
+            }
+            else if( *( p ) == quote )
+            {
+                quote = 0;
+            }
+        }
+        else if( *( p ) == '"' || *( p ) == '\'' )
+        {
+            quote = *( p );
+
+            fputc( *( p ), fh );
+        }
+        else if( p[ 0 ] == '$' && p[ 1 ] == '$' )
+        {
+            fprintf( fh, "%s", value );
+
+            p++;
+        }
+        else if( p[ 0 ] == '$' && isdigit( ( unsigned char )p[ 1 ] ) )
+        {
+            char * end;
+            size_t n;
+
+            n = ( size_t )strtoul( p + 1, &end, 10 );
+
+            if( n == 0 || n > length )
+            {
+                fprintf( stderr, "%s:%zu: $%zu is not a symbol of the rule\n", Spec_GetPath( spec ), line, n );
+
+                return false;
+            }
+
+            fprintf( fh, "values[ count - %zu ]", length - n + 1 );
+
+            p = end - 1;
+        }
+        else
+        {
+            fputc( *( p ), fh );
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Writes the grammar as a comment, with the rules numbered as in the
+ * tables.
+ */
+static void Emit_Grammar( FILE * fh, SpecRef spec )
+{
+    size_t width;
+
+    width = strlen( "$accept" );
+
+    for( size_t n = 0; n < Spec_GetNonterminalCount( spec ); n++ )
+    {
+        width = ( strlen( Spec_GetNonterminal( spec, n ) ) > width ) ? strlen( Spec_GetNonterminal( spec, n ) ) : width;
+    }
+
+    fprintf( fh, "/*\n" );
+    fprintf( fh, " * %3u  %-*s -> %s\n", 0U, ( int )width, "$accept", Spec_GetNonterminal( spec, Spec_GetStart( spec ) ) );
+
+    for( size_t p = 0; p < Spec_GetProductionCount( spec ); p++ )
+    {
+        const SpecProduction * production;
+
+        production = Spec_GetProduction( spec, p );
+
+        fprintf( fh, " * %3zu  %-*s ->", p + 1, ( int )width, Spec_GetNonterminal( spec, production->lhs ) );
+
+        for( size_t i = 0; i < production->length; i++ )
+        {
+            if( production->rhs[ i ].kind == SpecSymbolTerminal )
+            {
+                fprintf( fh, " %s", Spec_GetTerminal( spec, production->rhs[ i ].index ) );
+            }
+            else
+            {
+                fprintf( fh, " %s", Spec_GetNonterminal( spec, production->rhs[ i ].index ) );
+            }
+        }
+
+        fprintf( fh, "%s\n", ( production->length == 0 ) ? " epsilon" : "" );
+    }
+
+    fprintf( fh, " */\n\n" );
+}
+
+static FILE * Emit_Open( const char * base, const char * extension, const char * prefix, SpecRef spec, const char * summary )
+{
+    static const char * license[] =
+    {
+        "The MIT License (MIT)",
+        "",
+        "Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com",
+        "",
+        "Permission is hereby granted, free of charge, to any person obtaining a copy",
+        "of this software and associated documentation files (the \"Software\"), to deal",
+        "in the Software without restriction, including without limitation the rights",
+        "to use, copy, modify, merge, publish, distribute, sublicense, and/or sell",
+        "copies of the Software, and to permit persons to whom the Software is",
+        "furnished to do so, subject to the following conditions:",
+        "",
+        "The above copyright notice and this permission notice shall be included in",
+        "all copies or substantial portions of the Software.",
+        "",
+        "THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR",
+        "IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,",
+        "FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE",
+        "AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER",
+        "LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,",
+        "OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN",
+        "THE SOFTWARE."
+    };
+
+    char         path[ 1100 ];
+    const char * name;
+    FILE *       fh;
+
+    snprintf( path, sizeof( path ), "%s.%s", base, extension );
+
+    if( ( fh = fopen( path, "w" ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot write %s: %s\n", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    name = ( strrchr( Spec_GetPath( spec ), '/' ) == NULL ) ? Spec_GetPath( spec ) : strrchr( Spec_GetPath( spec ), '/' ) + 1;
+
+    fprintf( fh, "/*******************************************************************************\n" );
+
+    for( size_t i = 0; i < sizeof( license ) / sizeof( *( license ) ); i++ )
+    {
+        fprintf( fh, " * %s\n", license[ i ] );
+    }
+
+    fprintf( fh, " ******************************************************************************/\n\n" );
+    fprintf( fh, "/*!\n" );
+    fprintf( fh, " * @%-11s %s.%s\n", ( extension[ 0 ] == 'h' ) ? "header" : "file", prefix, extension );
+    fprintf( fh, " * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com\n" );
+    fprintf( fh, " * @dicussion   Generated by tools-lrgen from %s, do not edit.\n", name );
+    fprintf( fh, " *              %s\n", summary );
+    fprintf( fh, " */\n\n" );
+
+    return fh;
+}
+
+static void Emit_Table( FILE * fh, const size_t * values, size_t count, const char * indent )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        fprintf( fh, "%s%3zu%s", ( i % 16 == 0 ) ? indent : " ", values[ i ], ( i + 1 < count ) ? "," : "" );
+
+        if( i % 16 == 15 || i + 1 == count )
+        {
+            fprintf( fh, "\n" );
+        }
+    }
+}
+
+static void Emit_SignedTable( FILE * fh, const int * values, size_t count, const char * indent )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        fprintf( fh, "%s%4d%s", ( i % 16 == 0 ) ? indent : " ", values[ i ], ( i + 1 < count ) ? "," : "" );
+
+        if( i % 16 == 15 || i + 1 == count )
+        {
+            fprintf( fh, "\n" );
+        }
+    }
+}
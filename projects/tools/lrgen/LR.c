@@ -0,0 +1,799 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        LR.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "LR.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    size_t production;
+    size_t dot;
+} LRItem;
+
+/*
+ * Lookaheads are rows of booleans, one row per kernel item.
+ * Transitions are indexed by symbol, terminals first.
+ */
+typedef struct
+{
+    LRItem * kernel;
+    size_t   count;
+    bool *   lookaheads;
+    size_t * transitions;
+} LRState;
+
+/*
+ * Productions are those of the spec shifted by one, production 0 being
+ * the augmented $accept -> start, whose left-hand side is the last
+ * nonterminal.
+ */
+struct LR
+{
+    uint64_t            rc;
+    SpecRef             spec;
+    size_t              terminals;
+    size_t              nonterminals;
+    size_t              productions;
+    size_t *            lhs;
+    size_t *            lengths;
+    const SpecSymbol ** rhs;
+    SpecSymbol          accept;
+    bool *              nullable;
+    bool *              first;
+    LRState *           states;
+    size_t              stateCount;
+    int *               actions;
+    bool *              errors;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static size_t LR_Symbol( LRRef lr, size_t production, size_t dot );
+static bool   LR_FirstOf( LRRef lr, size_t production, size_t dot, bool * set );
+static bool   LR_ComputeFirst( LRRef lr );
+static size_t LR_Closure( LRRef lr, const LRState * state, LRItem * items, bool * added );
+static int    LR_CompareItems( const void * a, const void * b );
+static bool   LR_Build( LRRef lr );
+static bool   LR_Propagate( LRRef lr );
+static bool   LR_CloseLookaheads( LRRef lr, const LRState * state, LRItem * items, size_t count, bool * lookaheads );
+static bool   LR_FillActions( LRRef lr );
+
+LRRef LR_Create( SpecRef spec )
+{
+    LRRef  lr;
+    size_t n;
+    size_t t;
+    size_t p;
+
+    if( ( lr = calloc( 1, sizeof( struct LR ) ) ) == NULL )
+    {
+        return NULL;
+    }
+
+    t                 = Spec_GetTerminalCount( spec );
+    n                 = Spec_GetNonterminalCount( spec );
+    p                 = Spec_GetProductionCount( spec ) + 1;
+    lr->rc           = 1;
+    lr->spec         = Spec_Retain( spec );
+    lr->terminals    = t;
+    lr->nonterminals = n + 1;
+    lr->productions  = p;
+    lr->lhs          = calloc( p, sizeof( size_t ) );
+    lr->lengths      = calloc( p, sizeof( size_t ) );
+    lr->rhs          = calloc( p, sizeof( SpecSymbol * ) );
+    lr->nullable     = calloc( n + 1, sizeof( bool ) );
+    lr->first        = calloc( ( n + 1 ) * t + 1, sizeof( bool ) );
+    lr->accept.kind  = SpecSymbolNonterminal;
+    lr->accept.index = Spec_GetStart( spec );
+
+    if( lr->lhs == NULL || lr->lengths == NULL || lr->rhs == NULL || lr->nullable == NULL || lr->first == NULL )
+    {
+        LR_Release( lr );
+
+        return NULL;
+    }
+
+    lr->lhs[ 0 ]     = n;
+    lr->lengths[ 0 ] = 1;
+    lr->rhs[ 0 ]     = &( lr->accept );
+
+    for( size_t i = 1; i < p; i++ )
+    {
+        const SpecProduction * production;
+
+        production       = Spec_GetProduction( spec, i - 1 );
+        lr->lhs[ i ]     = production->lhs;
+        lr->lengths[ i ] = production->length;
+        lr->rhs[ i ]     = production->rhs;
+    }
+
+    if( LR_ComputeFirst( lr ) == false || LR_Build( lr ) == false || LR_Propagate( lr ) == false || LR_FillActions( lr ) == false )
+    {
+        LR_Release( lr );
+
+        return NULL;
+    }
+
+    return lr;
+}
+
+LRRef LR_Retain( LRRef lr )
+{
+    if( lr == NULL )
+    {
+        return NULL;
+    }
+
+    lr->rc++;
+
+    return lr;
+}
+
+void LR_Release( LRRef lr )
+{
+    if( lr == NULL )
+    {
+        return;
+    }
+
+    if( --( lr->rc ) > 0 )
+    {
+        return;
+    }
+
+    for( size_t i = 0; i < lr->stateCount; i++ )
+    {
+        free( lr->states[ i ].kernel );
+        free( lr->states[ i ].lookaheads );
+        free( lr->states[ i ].transitions );
+    }
+
+    Spec_Release( lr->spec );
+    free( lr->lhs );
+    free( lr->lengths );
+    free( lr->rhs );
+    free( lr->nullable );
+    free( lr->first );
+    free( lr->states );
+    free( lr->actions );
+    free( lr->errors );
+    free( lr );
+}
+
+size_t LR_GetStateCount( LRRef lr )
+{
+    return lr->stateCount;
+}
+
+/*
+ * Returns the state to shift to, which is never 0, or -1 minus the
+ * production to reduce, production 0 meaning the input is accepted, or 0
+ * on a syntax error.
+ */
+int LR_GetAction( LRRef lr, size_t state, size_t terminal )
+{
+    return lr->actions[ state * lr->terminals + terminal ];
+}
+
+/*
+ * Tells whether a syntax error comes from a %nonassoc operator, rather
+ * than from no action being possible.
+ */
+bool LR_IsExplicitError( LRRef lr, size_t state, size_t terminal )
+{
+    return lr->errors[ state * lr->terminals + terminal ];
+}
+
+size_t LR_GetGoto( LRRef lr, size_t state, size_t nonterminal )
+{
+    return lr->states[ state ].transitions[ lr->terminals + nonterminal ];
+}
+
+/*
+ * Returns the symbol after the dot, terminals first, or SPEC_NONE if the
+ * dot is at the end.
+ */
+static size_t LR_Symbol( LRRef lr, size_t production, size_t dot )
+{
+    const SpecSymbol * symbol;
+
+    if( dot >= lr->lengths[ production ] )
+    {
+        return SPEC_NONE;
+    }
+
+    symbol = &( lr->rhs[ production ][ dot ] );
+
+    return ( symbol->kind == SpecSymbolTerminal ) ? symbol->index : lr->terminals + symbol->index;
+}
+
+/*
+ * Adds FIRST of the right-hand side of the production, starting at the
+ * given symbol, to the set, and returns true if that part is nullable.
+ */
+static bool LR_FirstOf( LRRef lr, size_t production, size_t dot, bool * set )
+{
+    for( size_t i = dot; i < lr->lengths[ production ]; i++ )
+    {
+        size_t symbol;
+
+        symbol = LR_Symbol( lr, production, i );
+
+        if( symbol < lr->terminals )
+        {
+            set[ symbol ] = true;
+
+            return false;
+        }
+
+        symbol -= lr->terminals;
+
+        for( size_t t = 0; t < lr->terminals; t++ )
+        {
+            set[ t ] = set[ t ] || lr->first[ symbol * lr->terminals + t ];
+        }
+
+        if( lr->nullable[ symbol ] == false )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool LR_ComputeFirst( LRRef lr )
+{
+    bool * set;
+    bool   changed;
+
+    if( ( set = malloc( lr->terminals + 1 ) ) == NULL )
+    {
+        return false;
+    }
+
+    do
+    {
+        changed = false;
+
+        for( size_t p = 0; p < lr->productions; p++ )
+        {
+            bool * first;
+            bool   nullable;
+
+            first = lr->first + lr->lhs[ p ] * lr->terminals;
+
+            memset( set, 0, lr->terminals * sizeof( bool ) );
+
+            nullable = LR_FirstOf( lr, p, 0, set );
+
+            for( size_t t = 0; t < lr->terminals; t++ )
+            {
+                if( set[ t ] && first[ t ] == false )
+                {
+                    first[ t ] = true;
+                    changed    = true;
+                }
+            }
+
+            if( nullable && lr->nullable[ lr->lhs[ p ] ] == false )
+            {
+                lr->nullable[ lr->lhs[ p ] ] = true;
+                changed                      = true;
+            }
+        }
+    }
+    while( changed );
+
+    free( set );
+
+    return true;
+}
+
+/*
+ * Writes the kernel of the state followed by the items it implies, which
+ * all have the dot at the start, so there is at most one per production.
+ * Returns the number of items.
+ */
+static size_t LR_Closure( LRRef lr, const LRState * state, LRItem * items, bool * added )
+{
+    size_t count;
+
+    memset( added, 0, lr->productions * sizeof( bool ) );
+    memcpy( items, state->kernel, state->count * sizeof( LRItem ) );
+
+    count = state->count;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        size_t symbol;
+
+        symbol = LR_Symbol( lr, items[ i ].production, items[ i ].dot );
+
+        if( symbol == SPEC_NONE || symbol < lr->terminals )
+        {
+            continue;
+        }
+
+        for( size_t p = 0; p < lr->productions; p++ )
+        {
+            if( lr->lhs[ p ] == symbol - lr->terminals && added[ p ] == false )
+            {
+                added[ p ]                = true;
+                items[ count ].production = p;
+                items[ count ].dot        = 0;
+
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+static int LR_CompareItems( const void * a, const void * b )
+{
+    const LRItem * i1;
+    const LRItem * i2;
+
+    i1 = a;
+    i2 = b;
+
+    if( i1->production != i2->production )
+    {
+        return ( i1->production < i2->production ) ? -1 : 1;
+    }
+
+    return ( i1->dot < i2->dot ) ? -1 : ( ( i1->dot > i2->dot ) ? 1 : 0 );
+}
+
+/*
+ * Builds the LR(0) automaton, each state being identified by its sorted
+ * kernel.
+ */
+static bool LR_Build( LRRef lr )
+{
+    size_t   symbols;
+    size_t   capacity;
+    size_t   maxItems;
+    LRItem * items;
+    LRItem * kernel;
+    bool *   added;
+    bool     ok;
+
+    symbols  = lr->terminals + lr->nonterminals;
+    capacity = 64;
+    maxItems = 0;
+
+    for( size_t p = 0; p < lr->productions; p++ )
+    {
+        maxItems += lr->lengths[ p ] + 1;
+    }
+
+    lr->states = calloc( capacity, sizeof( LRState ) );
+    items      = malloc( maxItems * sizeof( LRItem ) );
+    kernel     = malloc( maxItems * sizeof( LRItem ) );
+    added      = malloc( lr->productions * sizeof( bool ) );
+    ok         = lr->states != NULL && items != NULL && kernel != NULL && added != NULL;
+
+    if( ok )
+    {
+        lr->stateCount         = 1;
+        lr->states[ 0 ].count  = 1;
+        lr->states[ 0 ].kernel = calloc( 1, sizeof( LRItem ) );
+        ok                     = lr->states[ 0 ].kernel != NULL;
+    }
+
+    for( size_t s = 0; ok && s < lr->stateCount; s++ )
+    {
+        size_t count;
+
+        count = LR_Closure( lr, &( lr->states[ s ] ), items, added );
+
+        if( ( lr->states[ s ].transitions = malloc( symbols * sizeof( size_t ) ) ) == NULL )
+        {
+            ok = false;
+
+            break;
+        }
+
+        for( size_t x = 0; ok && x < symbols; x++ )
+        {
+            size_t size;
+            size_t target;
+
+            size = 0;
+
+            for( size_t i = 0; i < count; i++ )
+            {
+                if( LR_Symbol( lr, items[ i ].production, items[ i ].dot ) == x )
+                {
+                    kernel[ size ].production = items[ i ].production;
+                    kernel[ size ].dot        = items[ i ].dot + 1;
+
+                    size++;
+                }
+            }
+
+            lr->states[ s ].transitions[ x ] = SPEC_NONE;
+
+            if( size == 0 )
+            {
+                continue;
+            }
+
+            qsort( kernel, size, sizeof( LRItem ), LR_CompareItems );
+
+            for( target = 0; target < lr->stateCount; target++ )
+            {
+                if( lr->states[ target ].count == size && memcmp( lr->states[ target ].kernel, kernel, size * sizeof( LRItem ) ) == 0 )
+                {
+                    break;
+                }
+            }
+
+            if( target == lr->stateCount )
+            {
+                LRState * state;
+
+                if( lr->stateCount == capacity )
+                {
+                    LRState * grown;
+
+                    if( ( grown = realloc( lr->states, capacity * 2 * sizeof( LRState ) ) ) == NULL )
+                    {
+                        ok = false;
+
+                        break;
+                    }
+
+                    memset( grown + capacity, 0, capacity * sizeof( LRState ) );
+
+                    lr->states = grown;
+                    capacity  *= 2;
+                }
+
+                state         = &( lr->states[ lr->stateCount++ ] );
+                state->count  = size;
+                state->kernel = malloc( size * sizeof( LRItem ) );
+
+                if( state->kernel == NULL )
+                {
+                    ok = false;
+
+                    break;
+                }
+
+                memcpy( state->kernel, kernel, size * sizeof( LRItem ) );
+            }
+
+            lr->states[ s ].transitions[ x ] = target;
+        }
+    }
+
+    if( ok && lr->stateCount > INT16_MAX )
+    {
+        fprintf( stderr, "%s: Too many states (%zu)\n", Spec_GetPath( lr->spec ), lr->stateCount );
+
+        ok = false;
+    }
+
+    free( items );
+    free( kernel );
+    free( added );
+
+    return ok;
+}
+
+/*
+ * Computes the lookaheads of the items implied by the kernel of the state,
+ * which are FIRST of what follows the nonterminal they come from, plus the
+ * lookaheads of that item if the rest is nullable.
+ * Lookaheads of the kernel are copied from the state.
+ */
+static bool LR_CloseLookaheads( LRRef lr, const LRState * state, LRItem * items, size_t count, bool * lookaheads )
+{
+    size_t t;
+    bool * set;
+    bool   changed;
+
+    t = lr->terminals;
+
+    if( ( set = malloc( ( t > 0 ) ? t : 1 ) ) == NULL )
+    {
+        return false;
+    }
+
+    memset( lookaheads, 0, count * t * sizeof( bool ) );
+    memcpy( lookaheads, state->lookaheads, state->count * t * sizeof( bool ) );
+
+    do
+    {
+        changed = false;
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            size_t symbol;
+
+            symbol = LR_Symbol( lr, items[ i ].production, items[ i ].dot );
+
+            if( symbol == SPEC_NONE || symbol < t )
+            {
+                continue;
+            }
+
+            memset( set, 0, t * sizeof( bool ) );
+
+            if( LR_FirstOf( lr, items[ i ].production, items[ i ].dot + 1, set ) )
+            {
+                for( size_t k = 0; k < t; k++ )
+                {
+                    set[ k ] = set[ k ] || lookaheads[ i * t + k ];
+                }
+            }
+
+            for( size_t j = state->count; j < count; j++ )
+            {
+                if( lr->lhs[ items[ j ].production ] != symbol - t )
+                {
+                    continue;
+                }
+
+                for( size_t k = 0; k < t; k++ )
+                {
+                    if( set[ k ] && lookaheads[ j * t + k ] == false )
+                    {
+                        lookaheads[ j * t + k ] = true;
+                        changed                 = true;
+                    }
+                }
+            }
+        }
+    }
+    while( changed );
+
+    free( set );
+
+    return true;
+}
+
+/*
+ * LALR(1) lookaheads of the kernel items, propagated through the
+ * transitions of the LR(0) automaton until nothing changes. The end of
+ * input follows the augmented production.
+ */
+static bool LR_Propagate( LRRef lr )
+{
+    size_t   t;
+    size_t   maxItems;
+    LRItem * items;
+    bool *   added;
+    bool *   lookaheads;
+    bool     changed;
+    bool     ok;
+
+    t        = lr->terminals;
+    maxItems = 0;
+
+    for( size_t p = 0; p < lr->productions; p++ )
+    {
+        maxItems += lr->lengths[ p ] + 1;
+    }
+
+    for( size_t s = 0; s < lr->stateCount; s++ )
+    {
+        if( ( lr->states[ s ].lookaheads = calloc( lr->states[ s ].count * t + 1, sizeof( bool ) ) ) == NULL )
+        {
+            return false;
+        }
+    }
+
+    lr->states[ 0 ].lookaheads[ Spec_GetEnd( lr->spec ) ] = true;
+
+    items      = malloc( maxItems * sizeof( LRItem ) );
+    added      = malloc( lr->productions * sizeof( bool ) );
+    lookaheads = malloc( maxItems * t * sizeof( bool ) + 1 );
+    ok         = items != NULL && added != NULL && lookaheads != NULL;
+
+    do
+    {
+        changed = false;
+
+        for( size_t s = 0; ok && s < lr->stateCount; s++ )
+        {
+            size_t count;
+
+            count = LR_Closure( lr, &( lr->states[ s ] ), items, added );
+
+            if( LR_CloseLookaheads( lr, &( lr->states[ s ] ), items, count, lookaheads ) == false )
+            {
+                ok = false;
+
+                break;
+            }
+
+            for( size_t i = 0; i < count; i++ )
+            {
+                size_t    symbol;
+                LRState * target;
+                LRItem    next;
+                LRItem *  found;
+
+                if( ( symbol = LR_Symbol( lr, items[ i ].production, items[ i ].dot ) ) == SPEC_NONE )
+                {
+                    continue;
+                }
+
+                target          = &( lr->states[ lr->states[ s ].transitions[ symbol ] ] );
+                next.production = items[ i ].production;
+                next.dot        = items[ i ].dot + 1;
+                found           = bsearch( &next, target->kernel, target->count, sizeof( LRItem ), LR_CompareItems );
+
+                for( size_t k = 0; k < t; k++ )
+                {
+                    bool * lookahead;
+
+                    lookahead = &( target->lookaheads[ ( size_t )( found - target->kernel ) * t + k ] );
+
+                    if( lookaheads[ i * t + k ] && *( lookahead ) == false )
+                    {
+                        *( lookahead ) = true;
+                        changed        = true;
+                    }
+                }
+            }
+        }
+    }
+    while( ok && changed );
+
+    free( items );
+    free( added );
+    free( lookaheads );
+
+    return ok;
+}
+
+/*
+ * Fills the action table, resolving shift/reduce conflicts with the
+ * precedence and associativity of the rule and the token, as yacc does.
+ * Any other conflict is reported, and makes the grammar rejected.
+ */
+static bool LR_FillActions( LRRef lr )
+{
+    size_t   t;
+    size_t   maxItems;
+    LRItem * items;
+    bool *   added;
+    bool *   lookaheads;
+    bool     ok;
+
+    t        = lr->terminals;
+    maxItems = 0;
+
+    for( size_t p = 0; p < lr->productions; p++ )
+    {
+        maxItems += lr->lengths[ p ] + 1;
+    }
+
+    lr->actions = calloc( lr->stateCount * t + 1, sizeof( int ) );
+    lr->errors  = calloc( lr->stateCount * t + 1, sizeof( bool ) );
+    items       = malloc( maxItems * sizeof( LRItem ) );
+    added       = malloc( lr->productions * sizeof( bool ) );
+    lookaheads  = malloc( maxItems * t * sizeof( bool ) + 1 );
+    ok          = lr->actions != NULL && lr->errors != NULL && items != NULL && added != NULL && lookaheads != NULL;
+
+    for( size_t s = 0; ok && s < lr->stateCount; s++ )
+    {
+        size_t count;
+        int *  row;
+
+        row   = lr->actions + s * t;
+        count = LR_Closure( lr, &( lr->states[ s ] ), items, added );
+
+        if( LR_CloseLookaheads( lr, &( lr->states[ s ] ), items, count, lookaheads ) == false )
+        {
+            ok = false;
+
+            break;
+        }
+
+        for( size_t k = 0; k < t; k++ )
+        {
+            row[ k ] = ( lr->states[ s ].transitions[ k ] == SPEC_NONE ) ? 0 : ( int )( lr->states[ s ].transitions[ k ] );
+        }
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            size_t p;
+            size_t line;
+            size_t precedence;
+
+            if( items[ i ].dot < lr->lengths[ items[ i ].production ] )
+            {
+                continue;
+            }
+
+            p          = items[ i ].production;
+            line       = ( p == 0 ) ? 0 : Spec_GetProduction( lr->spec, p - 1 )->line;
+            precedence = ( p == 0 ) ? 0 : Spec_GetProduction( lr->spec, p - 1 )->precedence;
+
+            for( size_t k = 0; k < t; k++ )
+            {
+                if( lookaheads[ i * t + k ] == false )
+                {
+                    continue;
+                }
+
+                if( row[ k ] == 0 && lr->errors[ s * t + k ] == false )
+                {
+                    row[ k ] = -1 - ( int )p;
+                }
+                else if( row[ k ] < 0 || lr->errors[ s * t + k ] )
+                {
+                    fprintf( stderr, "%s:%zu: Reduce/reduce conflict on %s in state %zu\n", Spec_GetPath( lr->spec ), line, Spec_GetTerminal( lr->spec, k ), s );
+
+                    ok = false;
+                }
+                else if( precedence == 0 || Spec_GetPrecedence( lr->spec, k ) == 0 )
+                {
+                    fprintf( stderr, "%s:%zu: Shift/reduce conflict on %s in state %zu\n", Spec_GetPath( lr->spec ), line, Spec_GetTerminal( lr->spec, k ), s );
+
+                    ok = false;
+                }
+                else if( precedence > Spec_GetPrecedence( lr->spec, k ) || ( precedence == Spec_GetPrecedence( lr->spec, k ) && Spec_GetAssociativity( lr->spec, k ) == SpecAssociativityLeft ) )
+                {
+                    row[ k ] = -1 - ( int )p;
+                }
+                else if( precedence == Spec_GetPrecedence( lr->spec, k ) && Spec_GetAssociativity( lr->spec, k ) == SpecAssociativityNonassoc )
+                {
+                    row[ k ]                = 0;
+                    lr->errors[ s * t + k ] = true;
+                }
+            }
+        }
+    }
+
+    free( items );
+    free( added );
+    free( lookaheads );
+
+    return ok;
+}
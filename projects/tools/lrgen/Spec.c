@@ -0,0 +1,1009 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Spec.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include "Spec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <errno.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    char *            name;
+    size_t            line;
+    size_t            precedence;
+    SpecAssociativity associativity;
+} SpecName;
+
+struct Spec
+{
+    uint64_t         rc;
+    char *           path;
+    char *           text;
+    const char *     p;
+    size_t           line;
+    char *           code[ SpecCodeCount ];
+    char **          includes;
+    size_t           includeCount;
+    char **          locals;
+    size_t           localCount;
+    SpecName *       terminals;
+    size_t           terminalCount;
+    SpecName *       nonterminals;
+    size_t           nonterminalCount;
+    char **          actions;
+    size_t           actionCount;
+    SpecProduction * productions;
+    size_t           productionCount;
+    size_t           start;
+    size_t           end;
+    char *           startName;
+    size_t           levels;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+static char * Spec_Read( const char * path );
+static bool   Spec_Parse( SpecRef spec );
+static bool   Spec_ParseDirective( SpecRef spec );
+static bool   Spec_ParseRule( SpecRef spec );
+static bool   Spec_ParseAction( SpecRef spec, char ** action );
+static size_t Spec_AddTerminal( SpecRef spec, const char * name );
+static char * Spec_NextName( SpecRef spec );
+static void   Spec_SkipSpace( SpecRef spec );
+static bool   Spec_Append( void * array, size_t * count, size_t size, const void * item );
+static size_t Spec_Find( const SpecName * names, size_t count, const char * name );
+static bool   Spec_Check( SpecRef spec );
+static void   Spec_Error( SpecRef spec, size_t line, const char * format, ... );
+
+/*
+ * A grammar starts with directives, each running to the end of its line,
+ * followed by rules in the style of yacc. # starts a comment.
+ *
+ *     %include   "Header.h"        Included by the generated header
+ *     %param     LexerRef lexer    Parameters of the parse function
+ *     %lookahead <expression>      The current token
+ *     %advance   <statement>       Moves to the next token
+ *     %error     <statement>       Reports a syntax error
+ *     %value     <type>            Type of the values, int by default
+ *     %shift     <statement>       Sets $$, the value of a shifted token
+ *     %drop      <statement>       Releases $$, left on the stack by an error
+ *     %local     <declaration>     A local variable of the parse function
+ *     %token     Name...           Terminals, which are Token values
+ *     %left      Name...           Terminals of one precedence level,
+ *     %right     Name...           from the lowest to the highest, with
+ *     %nonassoc  Name...           their associativity
+ *     %end       Name              The terminal ending the input
+ *     %start     name              The start symbol, by default the first
+ *
+ *     lhs : sym sym { action }
+ *         | sym %prec Name
+ *         |
+ *         ;
+ *
+ * An action ends its rule, and runs when the rule is reduced, with the
+ * parameters and locals in scope. $$ is the value of the left-hand side,
+ * $1 at first, and $1... those of the right-hand side. Setting ok to
+ * false stops the parse, on an error the action reported itself.
+ * A rule takes the precedence of its last terminal, unless given one
+ * with %prec.
+ */
+SpecRef Spec_CreateWithFile( const char * path )
+{
+    SpecRef spec;
+
+    if( ( spec = calloc( 1, sizeof( struct Spec ) ) ) == NULL || ( spec->path = strdup( path ) ) == NULL )
+    {
+        free( spec );
+
+        return NULL;
+    }
+
+    spec->rc   = 1;
+    spec->line = 1;
+
+    if( ( spec->text = Spec_Read( path ) ) == NULL || Spec_Parse( spec ) == false || Spec_Check( spec ) == false )
+    {
+        Spec_Release( spec );
+
+        return NULL;
+    }
+
+    free( spec->text );
+
+    spec->text = NULL;
+    spec->p    = NULL;
+
+    return spec;
+}
+
+SpecRef Spec_Retain( SpecRef spec )
+{
+    if( spec == NULL )
+    {
+        return NULL;
+    }
+
+    spec->rc++;
+
+    return spec;
+}
+
+void Spec_Release( SpecRef spec )
+{
+    if( spec == NULL )
+    {
+        return;
+    }
+
+    if( --( spec->rc ) > 0 )
+    {
+        return;
+    }
+
+    for( size_t i = 0; i < SpecCodeCount; i++ )
+    {
+        free( spec->code[ i ] );
+    }
+
+    for( size_t i = 0; i < spec->includeCount; i++ )
+    {
+        free( spec->includes[ i ] );
+    }
+
+    for( size_t i = 0; i < spec->localCount; i++ )
+    {
+        free( spec->locals[ i ] );
+    }
+
+    for( size_t i = 0; i < spec->terminalCount; i++ )
+    {
+        free( spec->terminals[ i ].name );
+    }
+
+    for( size_t i = 0; i < spec->nonterminalCount; i++ )
+    {
+        free( spec->nonterminals[ i ].name );
+    }
+
+    for( size_t i = 0; i < spec->actionCount; i++ )
+    {
+        free( spec->actions[ i ] );
+    }
+
+    for( size_t i = 0; i < spec->productionCount; i++ )
+    {
+        free( spec->productions[ i ].rhs );
+    }
+
+    free( spec->includes );
+    free( spec->locals );
+    free( spec->terminals );
+    free( spec->nonterminals );
+    free( spec->actions );
+    free( spec->productions );
+    free( spec->startName );
+    free( spec->text );
+    free( spec->path );
+    free( spec );
+}
+
+const char * Spec_GetPath( SpecRef spec )
+{
+    return spec->path;
+}
+
+const char * Spec_GetCode( SpecRef spec, SpecCode code )
+{
+    return spec->code[ code ];
+}
+
+size_t Spec_GetIncludeCount( SpecRef spec )
+{
+    return spec->includeCount;
+}
+
+const char * Spec_GetInclude( SpecRef spec, size_t index )
+{
+    return spec->includes[ index ];
+}
+
+size_t Spec_GetLocalCount( SpecRef spec )
+{
+    return spec->localCount;
+}
+
+const char * Spec_GetLocal( SpecRef spec, size_t index )
+{
+    return spec->locals[ index ];
+}
+
+size_t Spec_GetTerminalCount( SpecRef spec )
+{
+    return spec->terminalCount;
+}
+
+const char * Spec_GetTerminal( SpecRef spec, size_t index )
+{
+    return spec->terminals[ index ].name;
+}
+
+size_t Spec_GetPrecedence( SpecRef spec, size_t terminal )
+{
+    return spec->terminals[ terminal ].precedence;
+}
+
+SpecAssociativity Spec_GetAssociativity( SpecRef spec, size_t terminal )
+{
+    return spec->terminals[ terminal ].associativity;
+}
+
+size_t Spec_GetNonterminalCount( SpecRef spec )
+{
+    return spec->nonterminalCount;
+}
+
+const char * Spec_GetNonterminal( SpecRef spec, size_t index )
+{
+    return spec->nonterminals[ index ].name;
+}
+
+size_t Spec_GetActionCount( SpecRef spec )
+{
+    return spec->actionCount;
+}
+
+const char * Spec_GetAction( SpecRef spec, size_t index )
+{
+    return spec->actions[ index ];
+}
+
+size_t Spec_GetProductionCount( SpecRef spec )
+{
+    return spec->productionCount;
+}
+
+const SpecProduction * Spec_GetProduction( SpecRef spec, size_t index )
+{
+    return &( spec->productions[ index ] );
+}
+
+size_t Spec_GetStart( SpecRef spec )
+{
+    return spec->start;
+}
+
+size_t Spec_GetEnd( SpecRef spec )
+{
+    return spec->end;
+}
+
+static char * Spec_Read( const char * path )
+{
+    FILE * fh;
+    char * text;
+    size_t length;
+    size_t capacity;
+
+    if( ( fh = fopen( path, "r" ) ) == NULL )
+    {
+        fprintf( stderr, "Cannot open %s: %s\n", path, strerror( errno ) );
+
+        return NULL;
+    }
+
+    text     = NULL;
+    length   = 0;
+    capacity = 0;
+
+    while( true )
+    {
+        size_t n;
+
+        if( length + 1 >= capacity )
+        {
+            char * grown;
+
+            capacity = ( capacity == 0 ) ? 4096 : capacity * 2;
+
+            if( ( grown = realloc( text, capacity ) ) == NULL )
+            {
+                free( text );
+                fclose( fh );
+
+                return NULL;
+            }
+
+            text = grown;
+        }
+
+        if( ( n = fread( text + length, 1, capacity - length - 1, fh ) ) == 0 )
+        {
+            break;
+        }
+
+        length += n;
+    }
+
+    fclose( fh );
+
+    text[ length ] = 0;
+
+    return text;
+}
+
+static bool Spec_Parse( SpecRef spec )
+{
+    spec->p     = spec->text;
+    spec->start = SPEC_NONE;
+    spec->end   = SPEC_NONE;
+
+    while( true )
+    {
+        Spec_SkipSpace( spec );
+
+        if( *( spec->p ) == 0 )
+        {
+            return true;
+        }
+
+        if( *( spec->p ) == '%' )
+        {
+            if( spec->productionCount > 0 )
+            {
+                Spec_Error( spec, spec->line, "Directives must come before the rules" );
+
+                return false;
+            }
+
+            if( Spec_ParseDirective( spec ) == false )
+            {
+                return false;
+            }
+        }
+        else if( Spec_ParseRule( spec ) == false )
+        {
+            return false;
+        }
+    }
+}
+
+static bool Spec_ParseDirective( SpecRef spec )
+{
+    static const char * codes[ SpecCodeCount ] = { "param", "lookahead", "advance", "error", "value", "shift", "drop" };
+
+    const char * start;
+    char *       word;
+    char *       value;
+    size_t       length;
+    bool         ok;
+
+    start = ++( spec->p );
+
+    while( isalpha( ( unsigned char )*( spec->p ) ) )
+    {
+        spec->p++;
+    }
+
+    if( ( word = strndup( start, ( size_t )( spec->p - start ) ) ) == NULL )
+    {
+        return false;
+    }
+
+    while( *( spec->p ) == ' ' || *( spec->p ) == '\t' )
+    {
+        spec->p++;
+    }
+
+    start  = spec->p;
+    length = strcspn( start, "\n" );
+
+    while( length > 0 && isspace( ( unsigned char )start[ length - 1 ] ) )
+    {
+        length--;
+    }
+
+    spec->p += strcspn( spec->p, "\n" );
+
+    if( ( value = strndup( start, length ) ) == NULL )
+    {
+        free( word );
+
+        return false;
+    }
+
+    ok = false;
+
+    for( size_t i = 0; i < SpecCodeCount; i++ )
+    {
+        if( strcmp( word, codes[ i ] ) == 0 )
+        {
+            free( spec->code[ i ] );
+
+            spec->code[ i ] = value;
+            value           = NULL;
+            ok              = true;
+        }
+    }
+
+    if( ok )
+    {
+        free( word );
+
+        return true;
+    }
+
+    if( strcmp( word, "include" ) == 0 )
+    {
+        if( length < 2 || value[ 0 ] != '"' || value[ length - 1 ] != '"' )
+        {
+            Spec_Error( spec, spec->line, "Expected a quoted file name" );
+        }
+        else
+        {
+            memmove( value, value + 1, length - 2 );
+
+            value[ length - 2 ] = 0;
+            ok                  = Spec_Append( &( spec->includes ), &( spec->includeCount ), sizeof( char * ), &value );
+            value               = ( ok ) ? NULL : value;
+        }
+    }
+    else if( strcmp( word, "local" ) == 0 )
+    {
+        ok    = Spec_Append( &( spec->locals ), &( spec->localCount ), sizeof( char * ), &value );
+        value = ( ok ) ? NULL : value;
+    }
+    else if( strcmp( word, "token" ) == 0 || strcmp( word, "end" ) == 0 || strcmp( word, "left" ) == 0 || strcmp( word, "right" ) == 0 || strcmp( word, "nonassoc" ) == 0 )
+    {
+        SpecAssociativity associativity;
+        char *            name;
+
+        associativity = ( word[ 0 ] == 'l' ) ? SpecAssociativityLeft : ( ( word[ 0 ] == 'r' ) ? SpecAssociativityRight : SpecAssociativityNonassoc );
+        spec->levels += ( word[ 0 ] == 't' || word[ 0 ] == 'e' ) ? 0 : 1;
+        ok            = true;
+
+        for( name = strtok( value, " \t" ); ok && name != NULL; name = strtok( NULL, " \t" ) )
+        {
+            size_t index;
+
+            ok = ( index = Spec_AddTerminal( spec, name ) ) != SPEC_NONE;
+
+            if( ok && word[ 0 ] == 'e' )
+            {
+                spec->end = index;
+            }
+            else if( ok && word[ 0 ] != 't' )
+            {
+                spec->terminals[ index ].precedence    = spec->levels;
+                spec->terminals[ index ].associativity = associativity;
+            }
+        }
+    }
+    else if( strcmp( word, "start" ) == 0 )
+    {
+        free( spec->startName );
+
+        spec->startName = value;
+        value           = NULL;
+        ok              = true;
+    }
+    else
+    {
+        Spec_Error( spec, spec->line, "Unknown directive %%%s", word );
+    }
+
+    free( word );
+    free( value );
+
+    return ok;
+}
+
+static bool Spec_ParseRule( SpecRef spec )
+{
+    char * name;
+    size_t lhs;
+    size_t line;
+
+    line = spec->line;
+
+    if( ( name = Spec_NextName( spec ) ) == NULL )
+    {
+        Spec_Error( spec, spec->line, "Expected a rule" );
+
+        return false;
+    }
+
+    if( Spec_Find( spec->terminals, spec->terminalCount, name ) != SPEC_NONE )
+    {
+        Spec_Error( spec, line, "%s is a token", name );
+        free( name );
+
+        return false;
+    }
+
+    if( ( lhs = Spec_Find( spec->nonterminals, spec->nonterminalCount, name ) ) == SPEC_NONE )
+    {
+        SpecName nonterminal;
+
+        memset( &nonterminal, 0, sizeof( SpecName ) );
+
+        nonterminal.name = name;
+        nonterminal.line = line;
+        lhs              = spec->nonterminalCount;
+
+        if( Spec_Append( &( spec->nonterminals ), &( spec->nonterminalCount ), sizeof( SpecName ), &nonterminal ) == false )
+        {
+            free( name );
+
+            return false;
+        }
+    }
+    else
+    {
+        free( name );
+    }
+
+    Spec_SkipSpace( spec );
+
+    if( *( spec->p ) != ':' )
+    {
+        Spec_Error( spec, spec->line, "Expected ':'" );
+
+        return false;
+    }
+
+    spec->p++;
+
+    while( true )
+    {
+        SpecProduction production;
+
+        production.lhs        = lhs;
+        production.rhs        = NULL;
+        production.length     = 0;
+        production.action     = SPEC_NONE;
+        production.precedence = 0;
+        production.line       = spec->line;
+
+        while( true )
+        {
+            SpecSymbol symbol;
+
+            Spec_SkipSpace( spec );
+
+            production.line = ( production.length == 0 ) ? spec->line : production.line;
+
+            if( production.action != SPEC_NONE && *( spec->p ) != '|' && *( spec->p ) != ';' )
+            {
+                Spec_Error( spec, spec->line, "An action must end its rule" );
+                free( production.rhs );
+
+                return false;
+            }
+
+            if( *( spec->p ) == '{' )
+            {
+                char * action;
+
+                if( Spec_ParseAction( spec, &action ) == false )
+                {
+                    free( production.rhs );
+
+                    return false;
+                }
+
+                production.action = spec->actionCount;
+
+                if( Spec_Append( &( spec->actions ), &( spec->actionCount ), sizeof( char * ), &action ) == false )
+                {
+                    free( action );
+                    free( production.rhs );
+
+                    return false;
+                }
+
+                continue;
+            }
+
+            if( strncmp( spec->p, "%prec", 5 ) == 0 )
+            {
+                size_t terminal;
+
+                spec->p += 5;
+                name     = Spec_NextName( spec );
+                terminal = ( name == NULL ) ? SPEC_NONE : Spec_Find( spec->terminals, spec->terminalCount, name );
+
+                free( name );
+
+                if( terminal == SPEC_NONE )
+                {
+                    Spec_Error( spec, spec->line, "Expected a token after %%prec" );
+                    free( production.rhs );
+
+                    return false;
+                }
+
+                production.precedence = spec->terminals[ terminal ].precedence;
+
+                continue;
+            }
+
+            if( ( name = Spec_NextName( spec ) ) == NULL )
+            {
+                break;
+            }
+
+            if( ( symbol.index = Spec_Find( spec->terminals, spec->terminalCount, name ) ) != SPEC_NONE )
+            {
+                symbol.kind = SpecSymbolTerminal;
+
+                free( name );
+
+                production.precedence = ( spec->terminals[ symbol.index ].precedence > 0 ) ? spec->terminals[ symbol.index ].precedence : production.precedence;
+            }
+            else if( ( symbol.index = Spec_Find( spec->nonterminals, spec->nonterminalCount, name ) ) != SPEC_NONE )
+            {
+                symbol.kind = SpecSymbolNonterminal;
+
+                free( name );
+            }
+            else
+            {
+                SpecName nonterminal;
+
+                memset( &nonterminal, 0, sizeof( SpecName ) );
+
+                nonterminal.name = name;
+                nonterminal.line = spec->line;
+                symbol.kind      = SpecSymbolNonterminal;
+                symbol.index     = spec->nonterminalCount;
+
+                if( Spec_Append( &( spec->nonterminals ), &( spec->nonterminalCount ), sizeof( SpecName ), &nonterminal ) == false )
+                {
+                    free( name );
+                    free( production.rhs );
+
+                    return false;
+                }
+            }
+
+            if( Spec_Append( &( production.rhs ), &( production.length ), sizeof( SpecSymbol ), &symbol ) == false )
+            {
+                free( production.rhs );
+
+                return false;
+            }
+        }
+
+        if( Spec_Append( &( spec->productions ), &( spec->productionCount ), sizeof( SpecProduction ), &production ) == false )
+        {
+            free( production.rhs );
+
+            return false;
+        }
+
+        if( *( spec->p ) == ';' )
+        {
+            spec->p++;
+
+            return true;
+        }
+
+        if( *( spec->p ) != '|' )
+        {
+            Spec_Error( spec, spec->line, "Expected '|' or ';'" );
+
+            return false;
+        }
+
+        spec->p++;
+    }
+}
+
+/*
+ * Reads an action up to its matching brace, skipping braces in string and
+ * character literals and in comments, and returns its code without the
+ * braces and surrounding spaces.
+ */
+static bool Spec_ParseAction( SpecRef spec, char ** action )
+{
+    const char * start;
+    size_t       line;
+    size_t       depth;
+    size_t       length;
+
+    line  = spec->line;
+    start = ++( spec->p );
+    depth = 1;
+
+    while( depth > 0 )
+    {
+        char c;
+
+        c = *( spec->p++ );
+
+        if( c == 0 )
+        {
+            Spec_Error( spec, line, "Unterminated action" );
+
+            return false;
+        }
+        else if( c == '\n' )
+        {
+            spec->line++;
+        }
+        else if( c == '{' )
+        {
+            depth++;
+        }
+        else if( c == '}' )
+        {
+            depth--;
+        }
+        else if( c == '"' || c == '\'' )
+        {
+            while( *( spec->p ) != c && *( spec->p ) != 0 && *( spec->p ) != '\n' )
+            {
+                spec->p += ( *( spec->p ) == '\\' && spec->p[ 1 ] != 0 ) ? 2 : 1;
+            }
+
+            spec->p += ( *( spec->p ) == c ) ? 1 : 0;
+        }
+        else if( c == '/' && *( spec->p ) == '*' )
+        {
+            while( *( spec->p ) != 0 && ( *( spec->p ) != '*' || spec->p[ 1 ] != '/' ) )
+            {
+                spec->line += ( *( spec->p++ ) == '\n' ) ? 1 : 0;
+            }
+
+            spec->p += ( *( spec->p ) == 0 ) ? 0 : 2;
+        }
+    }
+
+    while( isspace( ( unsigned char )*( start ) ) )
+    {
+        start++;
+    }
+
+    length = ( size_t )( spec->p - start ) - 1;
+
+    while( length > 0 && isspace( ( unsigned char )start[ length - 1 ] ) )
+    {
+        length--;
+    }
+
+    *( action ) = strndup( start, length );
+
+    return *( action ) != NULL;
+}
+
+/*
+ * Names are C identifiers, which may also contain quotes, as in
+ * expression'.
+ */
+static char * Spec_NextName( SpecRef spec )
+{
+    const char * start;
+
+    Spec_SkipSpace( spec );
+
+    if( isalpha( ( unsigned char )*( spec->p ) ) == 0 && *( spec->p ) != '_' )
+    {
+        return NULL;
+    }
+
+    start = spec->p;
+
+    while( isalnum( ( unsigned char )*( spec->p ) ) || *( spec->p ) == '_' || *( spec->p ) == '\'' )
+    {
+        spec->p++;
+    }
+
+    return strndup( start, ( size_t )( spec->p - start ) );
+}
+
+static void Spec_SkipSpace( SpecRef spec )
+{
+    while( true )
+    {
+        if( *( spec->p ) == '#' )
+        {
+            spec->p += strcspn( spec->p, "\n" );
+        }
+        else if( isspace( ( unsigned char )*( spec->p ) ) )
+        {
+            spec->line += ( *( spec->p++ ) == '\n' ) ? 1 : 0;
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+static size_t Spec_AddTerminal( SpecRef spec, const char * name )
+{
+    SpecName terminal;
+    size_t   index;
+
+    if( ( index = Spec_Find( spec->terminals, spec->terminalCount, name ) ) != SPEC_NONE )
+    {
+        return index;
+    }
+
+    memset( &terminal, 0, sizeof( SpecName ) );
+
+    if( ( terminal.name = strdup( name ) ) == NULL )
+    {
+        return SPEC_NONE;
+    }
+
+    terminal.line = spec->line;
+
+    if( Spec_Append( &( spec->terminals ), &( spec->terminalCount ), sizeof( SpecName ), &terminal ) == false )
+    {
+        free( terminal.name );
+
+        return SPEC_NONE;
+    }
+
+    return spec->terminalCount - 1;
+}
+
+static bool Spec_Append( void * array, size_t * count, size_t size, const void * item )
+{
+    char * items;
+
+    if( ( items = realloc( *( ( void ** )array ), ( *( count ) + 1 ) * size ) ) == NULL )
+    {
+        return false;
+    }
+
+    memcpy( items + *( count ) * size, item, size );
+
+    *( ( void ** )array ) = items;
+    *( count )           += 1;
+
+    return true;
+}
+
+static size_t Spec_Find( const SpecName * names, size_t count, const char * name )
+{
+    for( size_t i = 0; i < count; i++ )
+    {
+        if( strcmp( names[ i ].name, name ) == 0 )
+        {
+            return i;
+        }
+    }
+
+    return SPEC_NONE;
+}
+
+/*
+ * Checks that every nonterminal has rules, and that the code the driver
+ * needs is there.
+ */
+static bool Spec_Check( SpecRef spec )
+{
+    static const char * codes[ SpecCodeCount ] = { NULL, "%lookahead", "%advance", "%error", NULL, NULL, NULL };
+
+    bool ok;
+
+    ok = true;
+
+    if( spec->productionCount == 0 )
+    {
+        Spec_Error( spec, spec->line, "No rules" );
+
+        return false;
+    }
+
+    for( size_t i = 0; i < SpecCodeCount; i++ )
+    {
+        if( codes[ i ] != NULL && spec->code[ i ] == NULL )
+        {
+            Spec_Error( spec, spec->line, "Missing %s", codes[ i ] );
+
+            ok = false;
+        }
+    }
+
+    if( spec->end == SPEC_NONE )
+    {
+        Spec_Error( spec, spec->line, "Missing %%end" );
+
+        ok = false;
+    }
+
+    for( size_t i = 0; i < spec->nonterminalCount; i++ )
+    {
+        size_t p;
+
+        for( p = 0; p < spec->productionCount; p++ )
+        {
+            if( spec->productions[ p ].lhs == i )
+            {
+                break;
+            }
+        }
+
+        if( p == spec->productionCount )
+        {
+            Spec_Error( spec, spec->nonterminals[ i ].line, "%s has no rules", spec->nonterminals[ i ].name );
+
+            ok = false;
+        }
+    }
+
+    if( spec->startName == NULL )
+    {
+        spec->start = spec->productions[ 0 ].lhs;
+    }
+    else if( ( spec->start = Spec_Find( spec->nonterminals, spec->nonterminalCount, spec->startName ) ) == SPEC_NONE )
+    {
+        Spec_Error( spec, spec->line, "Unknown start symbol %s", spec->startName );
+
+        ok = false;
+    }
+
+    return ok;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"
+#endif
+
+static void Spec_Error( SpecRef spec, size_t line, const char * format, ... )
+{
+    va_list ap;
+
+    va_start( ap, format );
+    fprintf( stderr, "%s:%zu: ", spec->path, line );
+    vfprintf( stderr, format, ap );
+    fprintf( stderr, "\n" );
+    va_end( ap );
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Spec.h
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#ifndef SPEC_H
+#define SPEC_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define SPEC_NONE ( ( size_t )-1 )
+
+typedef enum
+{
+    SpecSymbolTerminal    = 0,
+    SpecSymbolNonterminal = 1
+} SpecSymbolKind;
+
+typedef enum
+{
+    SpecCodeParam     = 0, /* Parameters of the parse function */
+    SpecCodeLookahead = 1, /* Expression evaluating to the current token */
+    SpecCodeAdvance   = 2, /* Statement moving to the next token */
+    SpecCodeError     = 3, /* Statement reporting a syntax error */
+    SpecCodeValue     = 4, /* Type of the values, int by default */
+    SpecCodeShift     = 5, /* Statement setting the value of a shifted token */
+    SpecCodeDrop      = 6, /* Statement releasing a value left on a syntax error */
+    SpecCodeCount     = 7
+} SpecCode;
+
+typedef enum
+{
+    SpecAssociativityNone     = 0,
+    SpecAssociativityLeft     = 1,
+    SpecAssociativityRight    = 2,
+    SpecAssociativityNonassoc = 3
+} SpecAssociativity;
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wpadded"
+#endif
+
+typedef struct
+{
+    SpecSymbolKind kind;
+    size_t         index;
+} SpecSymbol;
+
+/*
+ * Precedence levels start at 1, 0 meaning none.
+ */
+typedef struct
+{
+    size_t       lhs;
+    SpecSymbol * rhs;
+    size_t       length;
+    size_t       action;
+    size_t       precedence;
+    size_t       line;
+} SpecProduction;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+typedef struct Spec * SpecRef;
+
+SpecRef Spec_CreateWithFile( const char * path );
+SpecRef Spec_Retain( SpecRef spec );
+void    Spec_Release( SpecRef spec );
+
+const char *           Spec_GetPath( SpecRef spec );
+const char *           Spec_GetCode( SpecRef spec, SpecCode code );
+size_t                 Spec_GetIncludeCount( SpecRef spec );
+const char *           Spec_GetInclude( SpecRef spec, size_t index );
+size_t                 Spec_GetLocalCount( SpecRef spec );
+const char *           Spec_GetLocal( SpecRef spec, size_t index );
+size_t                 Spec_GetTerminalCount( SpecRef spec );
+const char *           Spec_GetTerminal( SpecRef spec, size_t index );
+size_t                 Spec_GetPrecedence( SpecRef spec, size_t terminal );
+SpecAssociativity      Spec_GetAssociativity( SpecRef spec, size_t terminal );
+size_t                 Spec_GetNonterminalCount( SpecRef spec );
+const char *           Spec_GetNonterminal( SpecRef spec, size_t index );
+size_t                 Spec_GetActionCount( SpecRef spec );
+const char *           Spec_GetAction( SpecRef spec, size_t index );
+size_t                 Spec_GetProductionCount( SpecRef spec );
+const SpecProduction * Spec_GetProduction( SpecRef spec, size_t index );
+size_t                 Spec_GetStart( SpecRef spec );
+size_t                 Spec_GetEnd( SpecRef spec );
+
+#endif /* SPEC_H */
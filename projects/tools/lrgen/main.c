@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2020 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        main.c
+ * @copyright   (c) 2020, Jean-David Gadina - www.xs-labs.com
+ * @dicussion   Adapted from "Compiler Design in C" by Allen I. Holub.
+ *              ISBN 0-13-155045-4 - https://holub.com/compiler
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Spec.h"
+#include "LR.h"
+#include "Emit.h"
+
+static bool Generate( const char * path );
+
+/*
+ * Generates an LALR(1) parser from each grammar given on the command line.
+ * See Spec.c for the format.
+ */
+int main( int argc, char * argv[] )
+{
+    if( argc < 2 )
+    {
+        fprintf( stderr, "Usage: %s <grammar.y>...\n", argv[ 0 ] );
+
+        return EXIT_FAILURE;
+    }
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( Generate( argv[ i ] ) == false )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static bool Generate( const char * path )
+{
+    SpecRef spec;
+    LRRef   lr;
+    bool    ok;
+
+    if( ( spec = Spec_CreateWithFile( path ) ) == NULL )
+    {
+        return false;
+    }
+
+    lr = LR_Create( spec );
+    ok = lr != NULL && Emit_Parser( spec, lr );
+
+    LR_Release( lr );
+    Spec_Release( spec );
+
+    return ok;
+}